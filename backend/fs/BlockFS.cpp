@@ -251,7 +251,8 @@ bool BlockFS::deleteSource(const std::string &name_or_id) {
 
 std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &name, const std::string &type,
                                                            nix::DataType data_type, const NDSize &shape,
-                                                           const Compression &compression) {
+                                                           const CompressionOptions &compression,
+                                                           const ChunkingOptions &chunking) {
     if (name.empty()) {
         throw EmptyString("Block::createDataArray empty name provided!");
     }
@@ -260,7 +261,7 @@ std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &na
     }
     std::string id = util::createId();
     DataArrayFS da(file(), block(), data_array_dir.location(), id, type, name);
-    da.createData(data_type, shape, compression);
+    da.createData(data_type, shape, compression, chunking);
     return std::make_shared<DataArrayFS>(da);
 }
 
@@ -271,7 +272,7 @@ std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &na
 std::shared_ptr<base::IDataFrame> BlockFS::createDataFrame(const std::string &name,
                                                            const std::string &type,
                                                            const std::vector<Column> &cols,
-                                                           const Compression &compression) {
+                                                           const CompressionOptions &compression) {
     throw std::runtime_error("not implemented");
 }
 
@@ -117,7 +117,8 @@ public:
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                       nix::DataType data_type, const NDSize &shape,
-                                                      const Compression &compression);
+                                                      const CompressionOptions &compression,
+                                                      const ChunkingOptions &chunking);
 
     //--------------------------------------------------
     // Methods concerning data frames
@@ -126,7 +127,7 @@ public:
     std::shared_ptr<base::IDataFrame> createDataFrame(const std::string &name,
                                                       const std::string &type,
                                                       const std::vector<Column> &cols,
-                                                      const Compression &compression);
+                                                      const CompressionOptions &compression);
 
 
     //--------------------------------------------------
@@ -240,7 +240,8 @@ bool DataArrayFS::deleteDimensions() {
 DataArrayFS::~DataArrayFS() {
 }
 
-void DataArrayFS::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+void DataArrayFS::createData(DataType dtype, const NDSize &size, const CompressionOptions &compression,
+                             const ChunkingOptions &chunking) {
     setDtype(dtype);
     dataExtent(size);
     /*
@@ -149,7 +149,8 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression);
+    virtual void createData(DataType dtype, const NDSize &size, const CompressionOptions &compression,
+                            const ChunkingOptions &chunking);
 
 
     bool hasData() const;
@@ -161,12 +162,52 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void readRows(DataType dtype, void *buffer, const std::vector<ndsize_t> &rows) const {
+        throw std::runtime_error("not implemented");
+    }
+
+
     NDSize dataExtent(void) const;
 
 
     void   dataExtent(const NDSize &extent);
 
 
+    void refresh() {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    NDSize chunkShape() const {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    void writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask) {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    size_t chunkStorageSize(const NDSize &offset) const {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    uint32_t readChunk(const NDSize &offset, void *buffer) const {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    void compressionThreads(size_t threads) {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    size_t compressionThreads() const {
+        throw std::runtime_error("not implemented");
+    }
+
+
     DataType dataType(void) const;
 
 };
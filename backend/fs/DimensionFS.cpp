@@ -8,6 +8,8 @@
 
 #include "DimensionFS.hpp"
 
+#include <unordered_map>
+
 using namespace nix::base;
 
 namespace nix {
@@ -303,6 +305,26 @@ void SetDimensionFS::labels(const none_t t) {
     }
 }
 
+
+size_t SetDimensionFS::labelIndices(const std::vector<std::string> &labels, ndsize_t *indices, uint8_t *valid) const {
+    std::vector<std::string> set_labels = this->labels();
+    std::unordered_map<std::string, ndsize_t> table;
+    table.reserve(set_labels.size());
+    for (size_t i = 0; i < set_labels.size(); ++i) {
+        table.emplace(set_labels[i], i);
+    }
+
+    size_t found = 0;
+    for (size_t i = 0; i < labels.size(); ++i) {
+        auto it = table.find(labels[i]);
+        bool ok = it != table.end();
+        indices[i] = ok ? it->second : 0;
+        valid[i] = static_cast<uint8_t>(ok);
+        found += ok;
+    }
+    return found;
+}
+
 SetDimensionFS::~SetDimensionFS() {}
 
 //--------------------------------------------------------------
@@ -142,6 +142,9 @@ public:
     void labels(const none_t t);
 
 
+    size_t labelIndices(const std::vector<std::string> &labels, ndsize_t *indices, uint8_t *valid) const;
+
+
     virtual ~SetDimensionFS();
 
 };
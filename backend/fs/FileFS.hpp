@@ -35,6 +35,24 @@ public:
     bool flush() { return true; };
 
 
+    std::vector<char> image() {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    void repack(const std::string &target, const RepackOptions &options) {
+        throw std::runtime_error("not implemented");
+    }
+
+
+    IOStatistics statistics() const {
+        return IOStatistics();
+    }
+
+
+    void resetStatistics() { }
+
+
     ndsize_t blockCount() const;
 
 
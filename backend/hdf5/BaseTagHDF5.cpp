@@ -27,6 +27,14 @@ BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_p
 }
 
 
+BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block, const CatalogEntry &entry)
+    : EntityWithSourcesHDF5(file, block, entry)
+{
+    feature_group = openOptGroup("features");
+    refs_group = openOptGroup("references");
+}
+
+
 BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block, const H5Group &group,
                          const std::string &id, const std::string &type, const std::string &name)
     : BaseTagHDF5(file, block, group, id, type, name, util::getTime())
@@ -42,6 +50,7 @@ BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_p
     refs_group = this->group().openOptGroup("references");
 }
 
+
 //--------------------------------------------------
 // Methods concerning references.
 //--------------------------------------------------
@@ -169,7 +178,9 @@ std::shared_ptr<IFeature>  BaseTagHDF5::createFeature(const std::string &name_or
 
     H5Group group = g->openGroup(rep_id, true);
     DataArray data = std::dynamic_pointer_cast<IDataArray>(block()->getEntity({name_or_id, ObjectType::DataArray}));
-    return std::make_shared<FeatureHDF5>(file(), block(), group, rep_id, data, link_type);
+    std::shared_ptr<FeatureHDF5> feature = std::make_shared<FeatureHDF5>(file(), block(), group, rep_id, data, link_type);
+    catalogInsert(group, ObjectType::Feature, "features", rep_id);
+    return feature;
 }
 
 
@@ -181,6 +192,7 @@ bool BaseTagHDF5::deleteFeature(const std::string &name_or_id) {
         std::shared_ptr<IFeature> feature = getFeature(name_or_id);
 
         g->removeGroup(feature->id());
+        catalogRemove(feature->id());
         deleted = true;
     }
 
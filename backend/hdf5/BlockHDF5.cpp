@@ -36,6 +36,16 @@ BlockHDF5::BlockHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &gr
     groups_group = this->group().openOptGroup("groups");
 }
 
+BlockHDF5::BlockHDF5(const std::shared_ptr<base::IFile> &file, const CatalogEntry &entry)
+        : EntityWithMetadataHDF5(file, entry), compr(Compression::Auto) {
+    data_array_group = openOptGroup("data_arrays");
+    data_frame_group = openOptGroup("data_frames");
+    tag_group = openOptGroup("tags");
+    multi_tag_group = openOptGroup("multi_tags");
+    source_group = openOptGroup("sources");
+    groups_group = openOptGroup("groups");
+}
+
 BlockHDF5::BlockHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id,
                      const string &type, const string &name, const Compression &compression)
      : BlockHDF5(file, group, id, type, name, util::getTime(), compression) {
@@ -117,7 +127,7 @@ boost::optional<H5Group> BlockHDF5::findEntityGroup(const nix::Identity &ident)
     if (foundNeedle) {
         g = boost::make_optional(p->openGroup(needle, false));
     } else if (haveId) {
-        g = p->findGroupByAttribute("entity_id", iid);
+        g = findGroupById(*p, iid);
     }
 
     if (g && haveName && haveId) {
@@ -149,11 +159,13 @@ std::string BlockHDF5::resolveEntityId(const nix::Identity &ident) const {
 }
 
 bool BlockHDF5::hasEntity(const nix::Identity &ident) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::hasEntity");
     boost::optional<H5Group> p = findEntityGroup(ident);
     return !!p;
 }
 
 std::shared_ptr<base::IEntity> BlockHDF5::getEntity(const nix::Identity &ident) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::getEntity");
     boost::optional<H5Group> eg = findEntityGroup(ident);
 
     switch (ident.type()) {
@@ -213,17 +225,36 @@ std::shared_ptr<base::IEntity> BlockHDF5::getEntity(const nix::Identity &ident)
 }
 
 std::shared_ptr<base::IEntity>BlockHDF5::getEntity(ObjectType type, ndsize_t index) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::getEntity");
+    const CatalogHDF5 *catalog = listingCatalog();
+    if (catalog && (type == ObjectType::DataArray || type == ObjectType::Tag)) {
+        const CatalogEntry *entry = catalog->child(id(), type, index);
+        if (!entry) {
+            return nullptr;
+        } else if (type == ObjectType::DataArray) {
+            return make_shared<DataArrayHDF5>(file(), block(), *entry);
+        }
+        return make_shared<TagHDF5>(file(), block(), *entry);
+    }
+
     boost::optional<H5Group> eg = groupForObjectType(type);
     string name = eg ? eg->objectName(index) : "";
     return getEntity({name, "", type});
 }
 
 ndsize_t BlockHDF5::entityCount(ObjectType type) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::entityCount");
+    const CatalogHDF5 *catalog = listingCatalog();
+    if (catalog && (type == ObjectType::DataArray || type == ObjectType::Tag)) {
+        return catalog->childCount(id(), type);
+    }
+
     boost::optional<H5Group> g = groupForObjectType(type);
     return g ? g->objectCount() : ndsize_t(0);
 }
 
 bool BlockHDF5::removeEntity(const nix::Identity &ident) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::removeEntity");
     boost::optional<H5Group> p = groupForObjectType(ident.type());
     boost::optional<H5Group> eg = findEntityGroup(ident);
 
@@ -242,10 +273,15 @@ bool BlockHDF5::removeEntity(const nix::Identity &ident) {
     }
 
     // we get first "entity" link by name, but delete all others whatever their name with it
-    std::string name;
+    std::string name, id;
     eg->getAttr("name", name);
+    eg->getAttr("entity_id", id);
 
-    return p->removeAllLinks(name);
+    bool removed = p->removeAllLinks(name);
+    if (removed) {
+        catalogRemove(id);
+    }
+    return removed;
 }
 
 
@@ -254,15 +290,19 @@ bool BlockHDF5::removeEntity(const nix::Identity &ident) {
 //--------------------------------------------------
 
 shared_ptr<ISource> BlockHDF5::createSource(const string &name, const string &type) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::createSource");
     string id = util::createId();
     boost::optional<H5Group> g = source_group(true);
 
     H5Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), block(), group, id, type, name);
+    shared_ptr<SourceHDF5> source = make_shared<SourceHDF5>(file(), block(), group, id, type, name);
+    catalogInsert(group, ObjectType::Source, "sources", name);
+    return source;
 }
 
 
 bool BlockHDF5::deleteSource(const string &name_or_id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::deleteSource");
     boost::optional<H5Group> g = source_group();
     bool deleted = false;
 
@@ -278,6 +318,9 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
             }
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
+            if (deleted) {
+                catalogRemove(source.id());
+            }
         }
     }
 
@@ -292,11 +335,14 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
 
 shared_ptr<ITag> BlockHDF5::createTag(const std::string &name, const std::string &type,
                                       const std::vector<double> &position) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::createTag");
     string id = util::createId();
     boost::optional<H5Group> g = tag_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    shared_ptr<TagHDF5> tag = make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    catalogInsert(group, ObjectType::Tag, "tags", name);
+    return tag;
 }
 
 //--------------------------------------------------
@@ -308,7 +354,9 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
                                                   const std::string &type,
                                                   nix::DataType data_type,
                                                   const NDSize &shape,
-                                                  const Compression &compression) {
+                                                  const CompressionOptions &compression,
+                                                  const ChunkingOptions &chunking) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::createDataArray");
     string id = util::createId();
     boost::optional<H5Group> g = data_array_group(true);
 
@@ -316,7 +364,8 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
 
     // now create the actual H5::DataSet
-    da->createData(data_type, shape, compression == Compression::Auto ? compr : compression);
+    da->createData(data_type, shape, compression.isAuto() ? CompressionOptions(compr) : compression, chunking);
+    catalogInsert(group, ObjectType::DataArray, "data_arrays", name);
     return da;
 }
 
@@ -327,14 +376,16 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
 std::shared_ptr<IDataFrame> BlockHDF5::createDataFrame(const std::string &name,
                                                        const std::string &type,
                                                        const std::vector<Column> &cols,
-                                                       const Compression &compression) {
+                                                       const CompressionOptions &compression) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::createDataFrame");
 
     string id = util::createId();
     boost::optional<H5Group> g = data_frame_group(true);
     H5Group group = g->openGroup(name, true);
 
     auto df = make_shared<DataFrameHDF5>(file(), block(), group, id, type, name);
-    df->createData(cols, compression == Compression::Auto ? compr : compression);
+    df->createData(cols, compression.isAuto() ? CompressionOptions(compr) : compression);
+    catalogInsert(group, ObjectType::DataFrame, "data_frames", name);
     return df;
 }
 
@@ -345,11 +396,14 @@ std::shared_ptr<IDataFrame> BlockHDF5::createDataFrame(const std::string &name,
 
 shared_ptr<IMultiTag> BlockHDF5::createMultiTag(const std::string &name, const std::string &type,
                                                 const DataArray &positions) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::createMultiTag");
     string id = util::createId();
     boost::optional<H5Group> g = multi_tag_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    shared_ptr<MultiTagHDF5> multi_tag = make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    catalogInsert(group, ObjectType::MultiTag, "multi_tags", name);
+    return multi_tag;
 }
 
 //--------------------------------------------------
@@ -357,11 +411,14 @@ shared_ptr<IMultiTag> BlockHDF5::createMultiTag(const std::string &name, const s
 //--------------------------------------------------
 
 shared_ptr<IGroup> BlockHDF5::createGroup(const std::string &name, const std::string &type) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Block, "Block::createGroup");
     string id = util::createId();
     boost::optional<H5Group> g = groups_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<GroupHDF5>(file(), block(), group, id, type, name);
+    shared_ptr<GroupHDF5> entity_group = make_shared<GroupHDF5>(file(), block(), group, id, type, name);
+    catalogInsert(group, ObjectType::Group, "groups", name);
+    return entity_group;
 }
 
 
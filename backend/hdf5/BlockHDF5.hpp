@@ -39,6 +39,14 @@ public:
      */
     BlockHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group);
 
+    /**
+     * Constructor for an existing Block listed from the catalog.
+     *
+     * @param file      The file which contains this block.
+     * @param entry     The catalog row of the block.
+     */
+    BlockHDF5(const std::shared_ptr<base::IFile> &file, const CatalogEntry &entry);
+
     /**
      * Standard constructor for a new Block.
      *
@@ -115,7 +123,8 @@ public:
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                       nix::DataType data_type, const NDSize &shape,
-                                                      const Compression &compression);
+                                                      const CompressionOptions &compression,
+                                                      const ChunkingOptions &chunking);
 
     //--------------------------------------------------
     // Methods concerning DataFrames
@@ -124,7 +133,7 @@ public:
     std::shared_ptr<base::IDataFrame> createDataFrame(const std::string &name,
                                                       const std::string &type,
                                                       const std::vector<Column> &cols,
-                                                      const Compression &compression);
+                                                      const CompressionOptions &compression);
 
     //--------------------------------------------------
     // Methods concerning tags.
@@ -0,0 +1,343 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "CatalogHDF5.hpp"
+#include "h5x/H5DataType.hpp"
+#include "h5x/H5Exception.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+const char *const CATALOG_NAME = "catalog";
+const char *const CATALOG_STATE = "catalog_state";
+const hsize_t CATALOG_CHUNK = 1024;
+
+const size_t NUM_FIELDS = 9;
+
+const char *const field_names[NUM_FIELDS] = {
+    "id", "name", "type", "object_type", "parent", "path", "metadata", "created_at", "updated_at"
+};
+
+std::string CatalogEntry::* const field_members[NUM_FIELDS] = {
+    &CatalogEntry::id, &CatalogEntry::name, &CatalogEntry::type, &CatalogEntry::object_type,
+    &CatalogEntry::parent, &CatalogEntry::path, &CatalogEntry::metadata,
+    &CatalogEntry::created_at, &CatalogEntry::updated_at
+};
+
+
+// one variable length string per field, in memory an array of char pointers
+H5Object make_row_type() {
+    h5x::DataType str = h5x::DataType::makeStrType();
+    H5Object type = H5Tcreate(H5T_COMPOUND, NUM_FIELDS * sizeof(char *));
+    type.check("CatalogHDF5: Could not create row type");
+
+    for (size_t i = 0; i < NUM_FIELDS; i++) {
+        HErr res = H5Tinsert(type.h5id(), field_names[i], i * sizeof(char *), str.h5id());
+        res.check("CatalogHDF5: Could not create row type");
+    }
+
+    return type;
+}
+
+
+std::string object_type_name(ObjectType type) {
+    switch (type) {
+    case ObjectType::Block:     return "Block";
+    case ObjectType::DataArray: return "DataArray";
+    case ObjectType::DataFrame: return "DataFrame";
+    case ObjectType::Tag:       return "Tag";
+    case ObjectType::Source:    return "Source";
+    case ObjectType::Feature:   return "Feature";
+    case ObjectType::MultiTag:  return "MultiTag";
+    case ObjectType::Section:   return "Section";
+    case ObjectType::Property:  return "Property";
+    case ObjectType::Group:     return "Group";
+    default:                    return "Unknown";
+    }
+}
+
+
+// the sub-groups of an entity that own further entities
+std::vector<std::pair<std::string, ObjectType>> owned_containers(ObjectType type) {
+    switch (type) {
+    case ObjectType::Block:
+        return {{"data_arrays", ObjectType::DataArray}, {"data_frames", ObjectType::DataFrame},
+                {"tags", ObjectType::Tag}, {"multi_tags", ObjectType::MultiTag},
+                {"sources", ObjectType::Source}, {"groups", ObjectType::Group}};
+    case ObjectType::Tag:
+    case ObjectType::MultiTag:
+        return {{"features", ObjectType::Feature}};
+    case ObjectType::Source:
+        return {{"sources", ObjectType::Source}};
+    case ObjectType::Section:
+        return {{"sections", ObjectType::Section}, {"properties", ObjectType::Property}};
+    default:
+        return {};
+    }
+}
+
+
+void read_entry(const LocID &obj, ObjectType type, const std::string &parent, const std::string &path,
+                CatalogEntry &entry) {
+    obj.getAttr("name", entry.name);
+    obj.getAttr("type", entry.type);
+    obj.getAttr("created_at", entry.created_at);
+    obj.getAttr("updated_at", entry.updated_at);
+    entry.object_type = object_type_name(type);
+    entry.parent = parent;
+    entry.path = path;
+}
+
+
+void read_metadata(const H5Group &group, CatalogEntry &entry) {
+    if (group.hasGroup("metadata")) {
+        group.openGroup("metadata", false).getAttr("entity_id", entry.metadata);
+    }
+}
+
+} // anonymous namespace
+
+
+bool CatalogHDF5::exists(const H5Group &root) {
+    return root.hasData(CATALOG_NAME);
+}
+
+
+bool CatalogHDF5::isValid(const H5Group &root) {
+    std::string state;
+    return exists(root) && root.getAttr(CATALOG_STATE, state) && state == "valid";
+}
+
+
+void CatalogHDF5::invalidate(const H5Group &root) {
+    root.setAttr(CATALOG_STATE, std::string("stale"));
+}
+
+
+void CatalogHDF5::validate(const H5Group &root) {
+    root.setAttr(CATALOG_STATE, std::string("valid"));
+}
+
+
+CatalogHDF5 CatalogHDF5::build(const H5Group &root) {
+    CatalogHDF5 catalog;
+
+    if (root.hasGroup("data")) {
+        catalog.walk(root.openGroup("data", false), "/data", ObjectType::Block, "");
+    }
+    if (root.hasGroup("metadata")) {
+        catalog.walk(root.openGroup("metadata", false), "/metadata", ObjectType::Section, "");
+    }
+
+    return catalog;
+}
+
+
+void CatalogHDF5::walk(const H5Group &container, const std::string &path, ObjectType type, const std::string &parent) {
+    for (ndsize_t index = 0; index < container.objectCount(); index++) {
+        const std::string link = container.objectName(index);
+        LocID obj = H5Oopen(container.h5id(), link.c_str(), H5P_DEFAULT);
+        if (!obj.isValid()) {
+            continue;
+        }
+
+        // entities linked from several places are listed once, at their owner
+        CatalogEntry entry;
+        if (!obj.getAttr("entity_id", entry.id) || by_id.count(entry.id) > 0) {
+            continue;
+        }
+
+        read_entry(obj, type, parent, path + "/" + link, entry);
+        if (!container.hasGroup(link)) {
+            add(entry);
+            continue;
+        }
+
+        H5Group group = container.openGroup(link, false);
+        read_metadata(group, entry);
+        add(entry);
+
+        for (const auto &child : owned_containers(type)) {
+            if (group.hasGroup(child.first)) {
+                walk(group.openGroup(child.first, false), entry.path + "/" + child.first, child.second, entry.id);
+            }
+        }
+    }
+}
+
+
+void CatalogHDF5::add(const CatalogEntry &entry) {
+    by_id[entry.id] = rows.size();
+    by_parent[{entry.parent, entry.object_type}].push_back(rows.size());
+    rows.push_back(entry);
+}
+
+
+CatalogHDF5 CatalogHDF5::load(const H5Group &root) {
+    CatalogHDF5 catalog;
+
+    H5Object dset = H5Dopen(root.h5id(), CATALOG_NAME, H5P_DEFAULT);
+    dset.check("CatalogHDF5::load(): Could not open catalog");
+    H5Object space = H5Dget_space(dset.h5id());
+    space.check("CatalogHDF5::load(): Could not get dataspace");
+
+    hssize_t n = H5Sget_simple_extent_npoints(space.h5id());
+    if (n <= 0) {
+        return catalog;
+    }
+
+    H5Object type = make_row_type();
+    std::vector<char *> buf(static_cast<size_t>(n) * NUM_FIELDS);
+    HErr res = H5Dread(dset.h5id(), type.h5id(), H5S_ALL, H5S_ALL, H5P_DEFAULT, buf.data());
+    res.check("CatalogHDF5::load(): Could not read catalog");
+
+    catalog.rows.reserve(static_cast<size_t>(n));
+    for (size_t i = 0; i < static_cast<size_t>(n); i++) {
+        CatalogEntry entry;
+        for (size_t k = 0; k < NUM_FIELDS; k++) {
+            const char *str = buf[i * NUM_FIELDS + k];
+            entry.*field_members[k] = str ? str : "";
+        }
+        catalog.add(entry);
+    }
+
+    res = H5Dvlen_reclaim(type.h5id(), space.h5id(), H5P_DEFAULT, buf.data());
+    res.check("CatalogHDF5::load(): Could not reclaim variable length data");
+
+    return catalog;
+}
+
+
+void CatalogHDF5::save(const H5Group &root) const {
+    H5Object type = make_row_type();
+    hsize_t n = rows.size();
+
+    H5Object dset;
+    if (exists(root)) {
+        dset = H5Dopen(root.h5id(), CATALOG_NAME, H5P_DEFAULT);
+        dset.check("CatalogHDF5::save(): Could not open catalog");
+        HErr res = H5Dset_extent(dset.h5id(), &n);
+        res.check("CatalogHDF5::save(): Could not resize catalog");
+    } else {
+        hsize_t maxdims = H5S_UNLIMITED;
+        H5Object space = H5Screate_simple(1, &n, &maxdims);
+        space.check("CatalogHDF5::save(): Could not create dataspace");
+        H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+        dcpl.check("CatalogHDF5::save(): Could not create property list");
+        HErr res = H5Pset_chunk(dcpl.h5id(), 1, &CATALOG_CHUNK);
+        res.check("CatalogHDF5::save(): Could not set chunk size");
+        dset = H5Dcreate2(root.h5id(), CATALOG_NAME, type.h5id(), space.h5id(), H5P_DEFAULT, dcpl.h5id(), H5P_DEFAULT);
+        dset.check("CatalogHDF5::save(): Could not create catalog");
+    }
+
+    if (n > 0) {
+        std::vector<const char *> buf(rows.size() * NUM_FIELDS);
+        for (size_t i = 0; i < rows.size(); i++) {
+            for (size_t k = 0; k < NUM_FIELDS; k++) {
+                buf[i * NUM_FIELDS + k] = (rows[i].*field_members[k]).c_str();
+            }
+        }
+        HErr res = H5Dwrite(dset.h5id(), type.h5id(), H5S_ALL, H5S_ALL, H5P_DEFAULT, buf.data());
+        res.check("CatalogHDF5::save(): Could not write catalog");
+    }
+
+    root.setAttr(CATALOG_STATE, std::string("valid"));
+}
+
+
+void CatalogHDF5::insert(const LocID &obj, ObjectType type, const std::string &parent, const std::string &container,
+                         const std::string &link) {
+    std::string path = "/" + container;
+    if (!parent.empty()) {
+        const CatalogEntry *owner = find(parent);
+        if (!owner) {
+            // the owner was added by a writer without catalog support, cf. FileHDF5::findGroupById
+            return;
+        }
+        path = owner->path + "/" + container;
+    }
+
+    CatalogEntry entry;
+    obj.getAttr("entity_id", entry.id);
+    // new entities do not reference metadata yet
+    read_entry(obj, type, parent, path + "/" + link, entry);
+    add(entry);
+    modified = true;
+}
+
+
+void CatalogHDF5::remove(const std::string &id) {
+    const CatalogEntry *entry = find(id);
+    if (!entry) {
+        return;
+    }
+
+    const std::string owned = entry->path + "/";
+    std::vector<std::string> removed;
+    std::vector<CatalogEntry> kept;
+    kept.reserve(rows.size());
+    for (CatalogEntry &row : rows) {
+        if (row.id == id || row.path.compare(0, owned.size(), owned) == 0) {
+            removed.push_back(row.id);
+        } else {
+            kept.push_back(std::move(row));
+        }
+    }
+
+    rows.clear();
+    by_id.clear();
+    by_parent.clear();
+    for (CatalogEntry &row : kept) {
+        // deleting an entity removes all links to it, the metadata links as well
+        if (std::find(removed.begin(), removed.end(), row.metadata) != removed.end()) {
+            row.metadata.clear();
+        }
+        add(row);
+    }
+    modified = true;
+}
+
+
+void CatalogHDF5::update(const std::string &id, std::string CatalogEntry::*field, const std::string &value) {
+    auto it = by_id.find(id);
+    if (it != by_id.end() && rows[it->second].*field != value) {
+        rows[it->second].*field = value;
+        modified = true;
+    }
+}
+
+
+const CatalogEntry *CatalogHDF5::find(const std::string &id) const {
+    auto it = by_id.find(id);
+    return it == by_id.end() ? nullptr : &rows[it->second];
+}
+
+
+ndsize_t CatalogHDF5::childCount(const std::string &parent, ObjectType type) const {
+    auto it = by_parent.find({parent, object_type_name(type)});
+    return it == by_parent.end() ? 0 : it->second.size();
+}
+
+
+// rows are added in link creation order, as H5Group::objectName indexes the links
+const CatalogEntry *CatalogHDF5::child(const std::string &parent, ObjectType type, ndsize_t index) const {
+    auto it = by_parent.find({parent, object_type_name(type)});
+    if (it == by_parent.end() || index >= it->second.size()) {
+        return nullptr;
+    }
+    return &rows[it->second[index]];
+}
+
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,139 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CATALOG_HDF5_H
+#define NIX_CATALOG_HDF5_H
+
+#include <nix/ObjectType.hpp>
+#include "h5x/H5Group.hpp"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * A row of the entity catalog.
+ */
+struct CatalogEntry {
+    std::string id;
+    std::string name;
+    std::string type;
+    std::string object_type;
+    std::string parent;
+    std::string path;
+    std::string metadata;
+    std::string created_at;
+    std::string updated_at;
+};
+
+
+/**
+ * Table of all entities of a file, stored in the dataset "catalog" at the
+ * file root. Writers of a file that maintains it load the catalog on open,
+ * keep its rows in step with the entities they create, change and delete,
+ * and save it on close if it changed. While the file is open for writing the
+ * catalog is marked stale, so readers only ever use a catalog that matches
+ * the groups.
+ */
+class CatalogHDF5 {
+
+public:
+
+    static bool exists(const H5Group &root);
+
+
+    static bool isValid(const H5Group &root);
+
+
+    static void invalidate(const H5Group &root);
+
+
+    static void validate(const H5Group &root);
+
+
+    static CatalogHDF5 build(const H5Group &root);
+
+
+    static CatalogHDF5 load(const H5Group &root);
+
+
+    void save(const H5Group &root) const;
+
+
+    /**
+     * Adds the row of the entity obj, linked as link into the container of the
+     * entity parent, or into the root group container if parent is empty.
+     */
+    void insert(const LocID &obj, ObjectType type, const std::string &parent, const std::string &container,
+                const std::string &link);
+
+
+    /**
+     * Removes the row of an entity, the rows of the entities it owns and its
+     * metadata references.
+     */
+    void remove(const std::string &id);
+
+
+    void update(const std::string &id, std::string CatalogEntry::*field, const std::string &value);
+
+
+    /**
+     * Whether rows were inserted, removed or updated since the catalog was
+     * loaded or built.
+     */
+    bool changed() const {
+        return modified;
+    }
+
+
+    const CatalogEntry *find(const std::string &id) const;
+
+
+    /**
+     * The number of entities of the given type owned by the entity parent, or
+     * of the top level blocks and sections if parent is empty.
+     */
+    ndsize_t childCount(const std::string &parent, ObjectType type) const;
+
+
+    /**
+     * The row of the index-th of these entities, in the order the groups list
+     * them, or nullptr if the index is out of bounds.
+     */
+    const CatalogEntry *child(const std::string &parent, ObjectType type, ndsize_t index) const;
+
+
+    const std::vector<CatalogEntry> &entries() const {
+        return rows;
+    }
+
+private:
+
+    void walk(const H5Group &container, const std::string &path, ObjectType type, const std::string &parent);
+
+
+    void add(const CatalogEntry &entry);
+
+
+    std::vector<CatalogEntry> rows;
+    std::unordered_map<std::string, size_t> by_id;
+    std::map<std::pair<std::string, std::string>, std::vector<size_t>> by_parent;
+    bool modified = false;
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_CATALOG_HDF5_H
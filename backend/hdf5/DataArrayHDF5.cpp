@@ -11,6 +11,7 @@
 #include "DataArrayHDF5.hpp"
 #include "h5x/H5DataSet.hpp"
 #include "DimensionHDF5.hpp"
+#include "FileHDF5.hpp"
 
 using namespace std;
 using namespace nix::base;
@@ -18,6 +19,13 @@ using namespace nix::base;
 namespace nix {
 namespace hdf5 {
 
+namespace {
+
+// read by every getData call; too long to be stored in a string without allocating
+const string POLYNOM_COEFFICIENTS = "polynom_coefficients";
+const string EXPANSION_ORIGIN = "expansion_origin";
+
+} // anonymous namespace
 
 DataArrayHDF5::DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group)
         : EntityWithSourcesHDF5(file, block, group) {
@@ -25,6 +33,12 @@ DataArrayHDF5::DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std
 }
 
 
+DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBlock> &block, const CatalogEntry &entry)
+        : EntityWithSourcesHDF5(file, block, entry) {
+    dimension_group = openOptGroup("dimensions");
+}
+
+
 DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBlock> &block, const H5Group &group,
                              const string &id, const string &type, const string &name)
         : DataArrayHDF5(file, block, group, id, type, name, util::getTime()) {
@@ -97,7 +111,7 @@ void DataArrayHDF5::unit(const none_t t) {
 boost::optional<double> DataArrayHDF5::expansionOrigin() const {
     boost::optional<double> ret;
     double expansion_origin;
-    bool have_attr = group().getAttr("expansion_origin", expansion_origin);
+    bool have_attr = group().getAttr(EXPANSION_ORIGIN, expansion_origin);
     if (have_attr) {
         ret = expansion_origin;
     }
@@ -106,24 +120,25 @@ boost::optional<double> DataArrayHDF5::expansionOrigin() const {
 
 
 void DataArrayHDF5::expansionOrigin(double expansion_origin) {
-    group().setAttr("expansion_origin", expansion_origin);
+    group().setAttr(EXPANSION_ORIGIN, expansion_origin);
     forceUpdatedAt();
 }
 
 
 void DataArrayHDF5::expansionOrigin(const none_t t) {
-    if (group().hasAttr("expansion_origin")) {
-        group().removeAttr("expansion_origin");
+    if (group().hasAttr(EXPANSION_ORIGIN)) {
+        group().removeAttr(EXPANSION_ORIGIN);
     }
     forceUpdatedAt();
 }
 
 // TODO use defaults
 vector<double> DataArrayHDF5::polynomCoefficients() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::polynomCoefficients");
     vector<double> polynom_coefficients;
 
-    if (group().hasData("polynom_coefficients")) {
-        DataSet ds = group().openData("polynom_coefficients");
+    if (group().hasData(POLYNOM_COEFFICIENTS)) {
+        DataSet ds = group().openData(POLYNOM_COEFFICIENTS);
         ds.read(polynom_coefficients, true);
     }
 
@@ -132,12 +147,13 @@ vector<double> DataArrayHDF5::polynomCoefficients() const {
 
 
 void DataArrayHDF5::polynomCoefficients(const vector<double> &coefficients, const Compression &compression) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::polynomCoefficients");
     DataSet ds;
-    if (group().hasData("polynom_coefficients")) {
-        ds = group().openData("polynom_coefficients");
+    if (group().hasData(POLYNOM_COEFFICIENTS)) {
+        ds = group().openData(POLYNOM_COEFFICIENTS);
         ds.setExtent({coefficients.size()});
     } else {
-        ds = group().createData("polynom_coefficients", H5T_NATIVE_DOUBLE, {coefficients.size()}, compression);
+        ds = group().createData(POLYNOM_COEFFICIENTS, H5T_NATIVE_DOUBLE, {coefficients.size()}, compression);
     }
     ds.write(coefficients);
     forceUpdatedAt();
@@ -145,8 +161,9 @@ void DataArrayHDF5::polynomCoefficients(const vector<double> &coefficients, cons
 
 
 void DataArrayHDF5::polynomCoefficients(const none_t t) {
-    if (group().hasData("polynom_coefficients")) {
-        group().removeData("polynom_coefficients");
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::polynomCoefficients");
+    if (group().hasData(POLYNOM_COEFFICIENTS)) {
+        group().removeData(POLYNOM_COEFFICIENTS);
     }
     forceUpdatedAt();
 }
@@ -157,6 +174,7 @@ void DataArrayHDF5::polynomCoefficients(const none_t t) {
 
 
 ndsize_t DataArrayHDF5::dimensionCount() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::dimensionCount");
     boost::optional<H5Group> g = dimension_group();
 	ndsize_t count = 0;
 	if (g) {
@@ -167,6 +185,7 @@ ndsize_t DataArrayHDF5::dimensionCount() const {
 
 
 shared_ptr<IDimension> DataArrayHDF5::getDimension(ndsize_t index) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::getDimension");
     shared_ptr<IDimension> dim;
     boost::optional<H5Group> g = dimension_group();
 
@@ -255,13 +274,30 @@ bool DataArrayHDF5::deleteDimensions() {
 DataArrayHDF5::~DataArrayHDF5() {
 }
 
-void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const CompressionOptions &compression,
+                               const ChunkingOptions &chunking) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::createData");
     if (group().hasData("data")) {
         throw ConsistencyError("DataArray's hdf5 data group already exists!");
     }
 
     h5x::DataType fileType = data_type_to_h5_filetype(dtype);
-    group().createData("data", fileType, size, compression);
+    NDSize chunks;
+    if (chunking.shape) {
+        if (chunking.shape.size() != size.size()) {
+            throw InvalidRank("DataArray::createData: chunk shape must have the rank of the data!");
+        }
+        for (ndsize_t c : chunking.shape) {
+            if (c == 0) {
+                throw std::invalid_argument("DataArray::createData: chunk dimensions must be larger than zero!");
+            }
+        }
+        chunks = chunking.shape;
+    } else if (!chunking.isAuto()) {
+        chunks = DataSet::adviseChunking(size, fileType.size(), chunking.append_axis, chunking.read_axis,
+                                         group().chunkCacheSize());
+    }
+    group().createData("data", fileType, size, compression, {}, chunks);
 }
 
 bool DataArrayHDF5::hasData() const {
@@ -269,6 +305,7 @@ bool DataArrayHDF5::hasData() const {
 }
 
 void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::write");
 
     if (!group().hasData("data")) {
         throw ConsistencyError("DataArray with missing h5df DataSet");
@@ -277,6 +314,13 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     DataSet ds = group().openData("data");
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
 
+    if (dtype != DataType::String) {
+        size_t threads = compressionThreads();
+        if (threads > 0 && ds.writeChunksParallel(data, memType, count, offset, threads)) {
+            return;
+        }
+    }
+
     DataSpace fileSpace, memSpace;
     std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(count, offset);
 
@@ -289,6 +333,7 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
 }
 
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::read");
     if (!group().hasData("data")) {
         throw ConsistencyError("DataArray with missing h5df DataSet");
     }
@@ -308,7 +353,29 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
     }
 }
 
+void DataArrayHDF5::readRows(DataType dtype, void *data, const std::vector<ndsize_t> &rows) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::readRows");
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = ds.rows2DataSpaces(rows);
+
+    if (dtype == DataType::String) {
+        StringWriter writer(memSpace.extent(), data);
+        ds.read(*writer, memType, memSpace, fileSpace);
+        writer.finish();
+        ds.vlenReclaim(memType.h5id(), *writer, &memSpace);
+    } else {
+        ds.read(data, memType, memSpace, fileSpace);
+    }
+}
+
 NDSize DataArrayHDF5::dataExtent(void) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::dataExtent");
     if (!group().hasData("data")) {
         return NDSize{};
     }
@@ -318,6 +385,7 @@ NDSize DataArrayHDF5::dataExtent(void) const {
 }
 
 void DataArrayHDF5::dataExtent(const NDSize &extent) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::dataExtent");
     if (!group().hasData("data")) {
         throw runtime_error("Data field not found in DataArray!");
     }
@@ -326,7 +394,68 @@ void DataArrayHDF5::dataExtent(const NDSize &extent) {
     ds.setExtent(extent);
 }
 
+void DataArrayHDF5::refresh() {
+    if (!group().hasData("data")) {
+        return;
+    }
+
+    DataSet ds = group().openData("data");
+    ds.refresh();
+}
+
+NDSize DataArrayHDF5::chunkShape() const {
+    if (!group().hasData("data")) {
+        return NDSize{};
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.chunkShape();
+}
+
+void DataArrayHDF5::writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::writeChunk");
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    ds.writeChunk(offset, data, size, filter_mask);
+}
+
+size_t DataArrayHDF5::chunkStorageSize(const NDSize &offset) const {
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.chunkStorageSize(offset);
+}
+
+uint32_t DataArrayHDF5::readChunk(const NDSize &offset, void *buffer) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::readChunk");
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.readChunk(offset, buffer);
+}
+
+void DataArrayHDF5::compressionThreads(size_t threads) {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(file());
+    if (!h5file) {
+        throw std::runtime_error("DataArray::compressionThreads: the DataArray does not belong to an open file");
+    }
+    h5file->compressionThreads(*this, threads);
+}
+
+size_t DataArrayHDF5::compressionThreads() const {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(file());
+    return h5file ? h5file->compressionThreads(*this) : 0;
+}
+
 DataType DataArrayHDF5::dataType(void) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::dataType");
     if (!group().hasData("data")) {
         return DataType::Nothing;
     }
@@ -40,6 +40,11 @@ public:
      */
     DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group);
 
+    /**
+     * Constructor for existing DataArrays listed from the catalog
+     */
+    DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const CatalogEntry &entry);
+
     /**
      * Standard constructor for new DataArrays
      */
@@ -135,7 +140,8 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression);
+    virtual void createData(DataType dtype, const NDSize &size, const CompressionOptions &compression,
+                            const ChunkingOptions &chunking);
 
 
     bool hasData() const;
@@ -147,12 +153,36 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void readRows(DataType dtype, void *buffer, const std::vector<ndsize_t> &rows) const;
+
+
     NDSize dataExtent(void) const;
 
 
     void dataExtent(const NDSize &extent);
 
 
+    void refresh();
+
+
+    NDSize chunkShape() const;
+
+
+    void writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask);
+
+
+    size_t chunkStorageSize(const NDSize &offset) const;
+
+
+    uint32_t readChunk(const NDSize &offset, void *buffer) const;
+
+
+    void compressionThreads(size_t threads);
+
+
+    size_t compressionThreads() const;
+
+
     DataType dataType(void) const;
 
 private:
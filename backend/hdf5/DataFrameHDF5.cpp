@@ -37,7 +37,7 @@ DataFrameHDF5::DataFrameHDF5(const std::shared_ptr<base::IFile> &file, const std
     : EntityWithSourcesHDF5(file, block, group, id, type, name, time) {
 }
 
-void DataFrameHDF5::createData(const std::vector<Column> &cols, const Compression &compression) {
+void DataFrameHDF5::createData(const std::vector<Column> &cols, const CompressionOptions &compression) {
 
     if (group().hasData("data")) {
         throw ConsistencyError("DataFrame's hdf5 data group already exists!");
@@ -70,6 +70,7 @@ void DataFrameHDF5::createData(const std::vector<Column> &cols, const Compressio
 }
 
 std::vector<Column> DataFrameHDF5::columns() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::columns");
     DataSet ds = data();
     h5x::DataType dt = ds.dataType();
 
@@ -127,12 +128,14 @@ std::vector<std::string> DataFrameHDF5::colName(const std::vector<unsigned> &col
 }
 
 ndsize_t DataFrameHDF5::rows() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::rows");
     DataSet ds = data();
     NDSize s = ds.size();
     return s.size() > 0 ? s[0] : 0;
 }
 
 void DataFrameHDF5::rows(ndsize_t n) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::rows");
     DataSet ds = data();
     ds.setExtent({n});
 }
@@ -348,6 +351,7 @@ struct Janus {
 
 
 void DataFrameHDF5::writeCells(ndsize_t row, const std::vector<Cell> &cells) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::writeCells");
     DataSet ds = data();
     h5x::DataType dt = ds.dataType();
     Janus j{dt, cells};
@@ -356,6 +360,7 @@ void DataFrameHDF5::writeCells(ndsize_t row, const std::vector<Cell> &cells) {
 }
 
 void DataFrameHDF5::writeRow(ndsize_t row, const std::vector<Variant> &vals) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::writeRow");
     DataSet ds = data();
     h5x::DataType dt = ds.dataType();
     std::vector<Cell> cells;
@@ -373,6 +378,7 @@ void DataFrameHDF5::writeRow(ndsize_t row, const std::vector<Variant> &vals) {
 }
 
 std::vector<Cell> DataFrameHDF5::readCells(ndsize_t row, const std::vector<std::string> &cols) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::readCells");
     DataSet ds = data();
     h5x::DataType dtype = ds.dataType();
 
@@ -391,6 +397,7 @@ std::vector<Cell> DataFrameHDF5::readCells(ndsize_t row, const std::vector<std::
 }
 
 std::vector<Variant> DataFrameHDF5::readRow(ndsize_t row) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::readRow");
     DataSet ds = data();
     h5x::DataType dts = ds.dataType();
 
@@ -423,6 +430,7 @@ void DataFrameHDF5::writeColumn(const std::string &name,
                                 ndsize_t count,
                                 DataType dtype,
                                 const void *data) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::writeColumn");
     DataSet ds = this->data();
     h5x::DataType dts = ds.dataType();
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
@@ -449,6 +457,7 @@ void DataFrameHDF5::readColumn(const std::string &name,
                                ndsize_t count,
                                DataType dtype,
                                void *data) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::DataFrame, "DataFrame::readColumn");
     DataSet ds = this->data();
     h5x::DataType dts = ds.dataType();
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
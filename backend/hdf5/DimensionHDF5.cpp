@@ -9,6 +9,10 @@
 #include "DimensionHDF5.hpp"
 #include <nix/util/util.hpp>
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 using namespace std;
 using namespace nix::base;
 
@@ -237,6 +241,33 @@ SampledDimensionHDF5::~SampledDimensionHDF5() {}
 // Implementation of SetDimensionHDF5
 //--------------------------------------------------------------
 
+// Maps each label to the index of its first occurrence. Every backend opened on a
+// dimension shares the table of its group, so that writes through one of them are
+// seen by all. The table is rebuilt on the first lookup after a write.
+struct SetLabelIndex {
+    mutex table_mutex;
+    bool valid = false;
+    unordered_map<string, ndsize_t> table;
+};
+
+
+// file number and address of the dimension group; the address can only be reused
+// once the group is closed, which also releases its table
+typedef pair<unsigned long, haddr_t> LabelIndexKey;
+
+static mutex label_index_mutex;
+static map<LabelIndexKey, weak_ptr<SetLabelIndex>> label_indices;
+
+
+static void invalidate(const shared_ptr<SetLabelIndex> &index) {
+    if (index) {
+        lock_guard<mutex> lock(index->table_mutex);
+        index->valid = false;
+        index->table.clear();
+    }
+}
+
+
 SetDimensionHDF5::SetDimensionHDF5(const H5Group &group, ndsize_t index)
     : DimensionHDF5(group, index)
 {
@@ -258,13 +289,73 @@ vector<string> SetDimensionHDF5::labels() const {
 
 
 void SetDimensionHDF5::labels(const vector<string> &labels) {
-   group.setData("labels", labels);
+    group.setData("labels", labels);
+    invalidate(labelIndex(false));
 }
 
 void SetDimensionHDF5::labels(const none_t t) {
     if (group.hasData("labels")) {
         group.removeData("labels");
     }
+    invalidate(labelIndex(false));
+}
+
+
+size_t SetDimensionHDF5::labelIndices(const vector<string> &labels, ndsize_t *indices, uint8_t *valid) const {
+    shared_ptr<SetLabelIndex> index = labelIndex(true);
+    lock_guard<mutex> lock(index->table_mutex);
+    if (!index->valid) {
+        index->table.clear();
+        vector<string> set_labels = this->labels();
+        index->table.reserve(set_labels.size());
+        for (size_t i = 0; i < set_labels.size(); ++i) {
+            index->table.emplace(std::move(set_labels[i]), i);
+        }
+        index->valid = true;
+    }
+
+    size_t found = 0;
+    for (size_t i = 0; i < labels.size(); ++i) {
+        auto it = index->table.find(labels[i]);
+        bool ok = it != index->table.end();
+        indices[i] = ok ? it->second : 0;
+        valid[i] = static_cast<uint8_t>(ok);
+        found += ok;
+    }
+    return found;
+}
+
+
+shared_ptr<SetLabelIndex> SetDimensionHDF5::labelIndex(bool create) const {
+    if (label_index) {
+        return label_index;
+    }
+
+    H5O_info_t info;
+#if H5_VERSION_GE(1, 10, 3)
+    HErr res = H5Oget_info2(group.h5id(), &info, H5O_INFO_BASIC);
+#else
+    HErr res = H5Oget_info(group.h5id(), &info);
+#endif
+    res.check("SetDimensionHDF5::labelIndex: Could not get object info");
+    LabelIndexKey key(info.fileno, info.addr);
+
+    lock_guard<mutex> lock(label_index_mutex);
+    auto it = label_indices.find(key);
+    if (it != label_indices.end()) {
+        label_index = it->second.lock();
+    }
+    if (!label_index && create) {
+        // drop the tables of closed dimensions now and then
+        if ((label_indices.size() & (label_indices.size() - 1)) == 0) {
+            for (auto entry = label_indices.begin(); entry != label_indices.end();) {
+                entry = entry->second.expired() ? label_indices.erase(entry) : std::next(entry);
+            }
+        }
+        label_index = make_shared<SetLabelIndex>();
+        label_indices[key] = label_index;
+    }
+    return label_index;
 }
 
 SetDimensionHDF5::~SetDimensionHDF5() {}
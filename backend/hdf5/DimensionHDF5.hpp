@@ -117,8 +117,18 @@ public:
 };
 
 
+struct SetLabelIndex;
+
+
 class SetDimensionHDF5 : virtual public base::ISetDimension, public DimensionHDF5 {
 
+private:
+
+    // shared with all other backends of the same dimension, see labelIndex()
+    mutable std::shared_ptr<SetLabelIndex> label_index;
+
+    std::shared_ptr<SetLabelIndex> labelIndex(bool create) const;
+
 public:
 
     SetDimensionHDF5(const H5Group &group, ndsize_t index);
@@ -136,6 +146,9 @@ public:
     void labels(const none_t t);
 
 
+    size_t labelIndices(const std::vector<std::string> &labels, ndsize_t *indices, uint8_t *valid) const;
+
+
     virtual ~SetDimensionHDF5();
 
 };
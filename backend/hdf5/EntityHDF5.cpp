@@ -7,6 +7,8 @@
 // LICENSE file in the root of the Project.
 
 #include "EntityHDF5.hpp"
+#include "FileHDF5.hpp"
+#include "h5x/H5Stats.hpp"
 
 #include <nix/util/util.hpp>
 
@@ -22,14 +24,40 @@ namespace hdf5 {
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const H5Group &group)
     : entity_file(file), entity_group(group)
 {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(file);
+    if (h5file) {
+        entity_stats = h5file->ioStats();
+    }
+
     setUpdatedAt();
     setCreatedAt();
 }
 
 
+EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const CatalogEntry &entry)
+    : entity_file(file), entity_entry(make_shared<CatalogEntry>(entry)), group_deferred(true)
+{
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(file);
+    entity_stats = h5file->ioStats();
+    entity_location = h5file->h5id();
+}
+
+
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id, time_t time)
     : entity_file(file), entity_group(group)
 {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(file);
+    if (h5file) {
+        entity_stats = h5file->ioStats();
+    }
+
+    if (h5file && h5file->compactLayout()) {
+        group.setFixedStringAttr("entity_id", id);
+        group.setFixedStringAttr("updated_at", util::timeToStr(util::getTime()));
+        group.setFixedStringAttr("created_at", util::timeToStr(time));
+        return;
+    }
+
     group.setAttr("entity_id", id);
     setUpdatedAt();
     forceCreatedAt(time);
@@ -37,6 +65,10 @@ EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const H5Group &group, cons
 
 
 string EntityHDF5::id() const {
+    if (entity_entry) {
+        return entity_entry->id;
+    }
+
     string t;
     
     if (group().hasAttr("entity_id")) {
@@ -68,6 +100,7 @@ void EntityHDF5::setUpdatedAt() {
 void EntityHDF5::forceUpdatedAt() {
     time_t t = util::getTime();
     group().setAttr("updated_at", util::timeToStr(t));
+    catalogUpdate(&CatalogEntry::updated_at, util::timeToStr(t));
 }
 
 
@@ -88,6 +121,7 @@ void EntityHDF5::setCreatedAt() {
 
 void EntityHDF5::forceCreatedAt(time_t t) {
     group().setAttr("created_at", util::timeToStr(t));
+    catalogUpdate(&CatalogEntry::created_at, util::timeToStr(t));
 }
 
 
@@ -97,15 +131,88 @@ bool EntityHDF5::isValidEntity() const {
 
 
 H5Group EntityHDF5::group() const {
+    if (group_deferred) {
+        entity_group = H5Group(H5Gopen(entity_location, entity_entry->path.c_str(), H5P_DEFAULT));
+        entity_group.check("EntityHDF5::group(): Could not open group: " + entity_entry->path);
+        if (IOCounters *counters = h5x::activeCounters()) {
+            counters->object_opens++;
+        }
+        group_deferred = false;
+    }
     return entity_group;
 }
 
 
+// the optGroups are members of the backend, which is never copied
+optGroup EntityHDF5::openOptGroup(const std::string &name) const {
+    if (group_deferred) {
+        return optGroup([this] { return group(); }, name);
+    }
+    return group().openOptGroup(name);
+}
+
+
 std::shared_ptr<base::IFile> EntityHDF5::file() const {
     return entity_file;
 }
 
 
+const std::shared_ptr<StatisticsHDF5> &EntityHDF5::ioStats() const {
+    return entity_stats;
+}
+
+
+boost::optional<H5Group> EntityHDF5::findGroupByNameOrId(const H5Group &parent, const std::string &name_or_id) const {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(entity_file);
+    if (h5file) {
+        return h5file->findGroupByNameOrId(parent, name_or_id);
+    }
+    return parent.findGroupByNameOrAttribute("entity_id", name_or_id);
+}
+
+
+boost::optional<H5Group> EntityHDF5::findGroupById(const H5Group &parent, const std::string &id) const {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(entity_file);
+    if (h5file) {
+        return h5file->findGroupById(parent, id);
+    }
+    return parent.findGroupByAttribute("entity_id", id);
+}
+
+
+const CatalogHDF5 *EntityHDF5::listingCatalog() const {
+    return FileHDF5::listingCatalog(entity_file);
+}
+
+
+CatalogHDF5 *EntityHDF5::maintainedCatalog() const {
+    return FileHDF5::maintainedCatalog(entity_file);
+}
+
+
+void EntityHDF5::catalogInsert(const LocID &obj, ObjectType type, const string &container, const string &link) const {
+    if (CatalogHDF5 *catalog = maintainedCatalog()) {
+        catalog->insert(obj, type, id(), container, link);
+    }
+}
+
+
+void EntityHDF5::catalogRemove(const string &id) const {
+    if (CatalogHDF5 *catalog = maintainedCatalog()) {
+        catalog->remove(id);
+    }
+}
+
+
+void EntityHDF5::catalogUpdate(string CatalogEntry::*field, const string &value) const {
+    CatalogHDF5 *catalog = maintainedCatalog();
+    string eid;
+    if (catalog && group().getAttr("entity_id", eid)) {
+        catalog->update(eid, field, value);
+    }
+}
+
+
 bool EntityHDF5::operator==(const EntityHDF5 &other) const {
     return group() == other.group() && id() == other.id();
 }
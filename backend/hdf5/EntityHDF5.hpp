@@ -13,6 +13,8 @@
 
 #include <nix/base/IEntity.hpp>
 #include "h5x/H5Group.hpp"
+#include "CatalogHDF5.hpp"
+#include "StatisticsHDF5.hpp"
 
 #include <string>
 #include <memory>
@@ -29,13 +31,26 @@ class EntityHDF5 : virtual public base::IEntity {
 private:
 
     std::shared_ptr<base::IFile>  entity_file;
-    H5Group entity_group;
+    mutable H5Group entity_group;
+    std::shared_ptr<StatisticsHDF5> entity_stats;
+    // the catalog row of an entity listed from the catalog, cf. FileHDF5::listingCatalog
+    std::shared_ptr<const CatalogEntry> entity_entry;
+    hid_t entity_location = H5I_INVALID_HID;
+    mutable bool group_deferred = false;
 
 public:
 
     EntityHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group);
 
 
+    /**
+     * Constructor for an existing entity listed from the catalog of a read-only
+     * file. Its group is opened on first use, id, name and type are taken from
+     * the catalog row.
+     */
+    EntityHDF5(const std::shared_ptr<base::IFile> &file, const CatalogEntry &entry);
+
+
     EntityHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, const std::string &id, time_t time);
 
 
@@ -78,6 +93,51 @@ protected:
 
     std::shared_ptr<base::IFile> file() const;
 
+
+    // the statistics of the file, if it collects any
+    const std::shared_ptr<StatisticsHDF5> &ioStats() const;
+
+
+    // the file stands in for the group of an entity until it is opened
+    hid_t groupHandle() const {
+        return group_deferred ? entity_location : entity_group.h5id();
+    }
+
+
+    // the catalog row of an entity listed from the catalog, or nullptr
+    const CatalogEntry *catalogEntry() const {
+        return entity_entry.get();
+    }
+
+
+    // cf. H5Group::openOptGroup, the group of an entity listed from the catalog is opened on first use
+    optGroup openOptGroup(const std::string &name) const;
+
+
+    // cf. FileHDF5::listingCatalog
+    const CatalogHDF5 *listingCatalog() const;
+
+
+    // cf. FileHDF5::findGroupByNameOrId
+    boost::optional<H5Group> findGroupByNameOrId(const H5Group &parent, const std::string &name_or_id) const;
+
+
+    boost::optional<H5Group> findGroupById(const H5Group &parent, const std::string &id) const;
+
+
+    // cf. FileHDF5::maintainedCatalog
+    CatalogHDF5 *maintainedCatalog() const;
+
+
+    // adds the row of an entity created as link in the given container of this one to the catalog
+    void catalogInsert(const LocID &obj, ObjectType type, const std::string &container, const std::string &link) const;
+
+
+    void catalogRemove(const std::string &id) const;
+
+
+    void catalogUpdate(std::string CatalogEntry::*field, const std::string &value) const;
+
 };
 
 
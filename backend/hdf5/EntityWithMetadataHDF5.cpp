@@ -27,6 +27,12 @@ EntityWithMetadataHDF5::EntityWithMetadataHDF5(const shared_ptr<IFile> &file, co
 }
 
 
+EntityWithMetadataHDF5::EntityWithMetadataHDF5(const shared_ptr<IFile> &file, const CatalogEntry &entry)
+    : NamedEntityHDF5(file, entry)
+{
+}
+
+
 EntityWithMetadataHDF5::EntityWithMetadataHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id, const string &type, const string &name)
     : EntityWithMetadataHDF5(file, group, id, type, name, util::getTime())
 {
@@ -54,6 +60,7 @@ void EntityWithMetadataHDF5::metadata(const std::string &id) {
     auto target = dynamic_pointer_cast<SectionHDF5>(found.front().impl());
 
     group().createLink(target->group(), "metadata");
+    catalogUpdate(&CatalogEntry::metadata, id);
 }
 
 
@@ -79,6 +86,7 @@ void EntityWithMetadataHDF5::metadata(const none_t t) {
     if (group().hasGroup("metadata")) {
         group().removeGroup("metadata");
     }
+    catalogUpdate(&CatalogEntry::metadata, "");
     forceUpdatedAt();
 }
 
@@ -29,6 +29,11 @@ public:
      * Standard constructor for existing entity
      */
     EntityWithMetadataHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group);
+
+    /**
+     * Constructor for existing entity listed from the catalog
+     */
+    EntityWithMetadataHDF5(const std::shared_ptr<base::IFile> &file, const CatalogEntry &entry);
     
     /**
      * Standard constructor for new entity
@@ -27,6 +27,14 @@ EntityWithSourcesHDF5::EntityWithSourcesHDF5(const std::shared_ptr<IFile> &file,
 }
 
 
+EntityWithSourcesHDF5::EntityWithSourcesHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block,
+                                             const CatalogEntry &entry)
+    : EntityWithMetadataHDF5(file, entry), entity_block(block)
+{
+    sources_refs = openOptGroup("sources");
+}
+
+
 EntityWithSourcesHDF5::EntityWithSourcesHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block,
                                              const H5Group &group, const std::string &id, const std::string &type,
                                              const std::string &name)
@@ -34,6 +34,12 @@ public:
      * Standard constructor for existing entity.
      */
     EntityWithSourcesHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group);
+
+    /**
+     * Constructor for existing entity listed from the catalog.
+     */
+    EntityWithSourcesHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block,
+                          const CatalogEntry &entry);
     
     /**
      * Standard constructor for new entity.
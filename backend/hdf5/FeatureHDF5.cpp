@@ -69,6 +69,7 @@ void FeatureHDF5::linkType(LinkType link_type) {
 
 
 void FeatureHDF5::data(const std::string &name_or_id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Feature, "Feature::data");
     std::shared_ptr<IDataArray> ida = block->getEntity<IDataArray>(name_or_id);
     if (!ida) {
         throw std::runtime_error("FeatureHDF5::data: DataArray not found in block!");
@@ -85,6 +86,7 @@ void FeatureHDF5::data(const std::string &name_or_id) {
 
 
 shared_ptr<IDataArray> FeatureHDF5::data() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Feature, "Feature::data");
     shared_ptr<IDataArray> da;
 
     if (group().hasGroup("data")) {
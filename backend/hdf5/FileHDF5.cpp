@@ -12,6 +12,8 @@
 #include "BlockHDF5.hpp"
 #include "SectionHDF5.hpp"
 #include "h5x/H5Exception.hpp"
+#include "h5x/H5Repack.hpp"
+#include "h5x/H5Stats.hpp"
 
 
 #include <fstream>
@@ -36,73 +38,301 @@ static unsigned int map_file_mode(FileMode mode) {
         case FileMode::Overwrite:
             return H5F_ACC_TRUNC;
 
+        case FileMode::SwmrWrite:
+            return H5F_ACC_RDWR;
+
+        case FileMode::SwmrRead:
+            return H5F_ACC_RDONLY | H5F_ACC_SWMR_READ;
+
         default:
             return H5F_ACC_DEFAULT;
     }
 }
 
 
-FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, OpenFlags flags):
-    file_format_version(HDF5_FF_VERSION) {
-    if (!fileExists(name)) {
-        mode = FileMode::Overwrite;
+// memory is allocated in steps of this size for in-memory files
+#define CORE_INCREMENT 1024*1024
+
+static H5F_libver_t map_format_bound(FormatBound bound) {
+    switch (bound) {
+        case FormatBound::Earliest:
+            return H5F_LIBVER_EARLIEST;
+#if H5_VERSION_GE(1, 10, 2)
+        case FormatBound::V18:
+            return H5F_LIBVER_V18;
+
+        case FormatBound::V110:
+            return H5F_LIBVER_V110;
+#endif
+        default:
+            return H5F_LIBVER_LATEST;
     }
-    this->mode = mode;
-    this->compr = compression;
-    //we want hdf5 to keep track of the order in which links were created so that
-    //the order for indexed based accessors is stable cf. issue #387
+}
+
+
+static H5Object make_file_create_plist(const FileOptions &options) {
     H5Object fcpl = H5Pcreate(H5P_FILE_CREATE);
     fcpl.check("Could not create file creation plist");
+    //we want hdf5 to keep track of the order in which links were created so that
+    //the order for indexed based accessors is stable cf. issue #387
     HErr res = H5Pset_link_creation_order(fcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
     res.check("Unable to create file (H5Pset_link_creation_order failed.)");
+
+    // groups inherit these settings from their parent, i.e. ultimately from the root group
+    if (options.entity_layout == EntityLayout::Compact) {
+        res = H5Pset_link_phase_change(fcpl.h5id(), 32, 24);
+        res.check("Unable to create file (H5Pset_link_phase_change failed.)");
+        res = H5Pset_est_link_info(fcpl.h5id(), 8, 16);
+        res.check("Unable to create file (H5Pset_est_link_info failed.)");
+        res = H5Pset_attr_phase_change(fcpl.h5id(), 16, 12);
+        res.check("Unable to create file (H5Pset_attr_phase_change failed.)");
+    }
+
+    if (options.paged || options.persist_free_space) {
+#if H5_VERSION_GE(1, 10, 1)
+        H5F_fspace_strategy_t strategy = options.paged ? H5F_FSPACE_STRATEGY_PAGE : H5F_FSPACE_STRATEGY_FSM_AGGR;
+        res = H5Pset_file_space_strategy(fcpl.h5id(), strategy, options.persist_free_space, 1);
+        res.check("Unable to create file (H5Pset_file_space_strategy failed.)");
+        if (options.paged && options.page_size > 0) {
+            res = H5Pset_file_space_page_size(fcpl.h5id(), options.page_size);
+            res.check("Unable to create file (H5Pset_file_space_page_size failed.)");
+        }
+#else
+        throw std::runtime_error("File space strategies require HDF5 1.10.1 or newer");
+#endif
+    }
+
+    return fcpl;
+}
+
+
+static H5Object make_file_access_plist(FileMode mode, OpenFlags flags, const FileOptions &options) {
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+
+    // SWMR writing requires the latest file format
+    H5F_libver_t low = map_format_bound(options.format_low);
+    H5F_libver_t high = map_format_bound(options.format_high);
+    if (mode == FileMode::SwmrWrite) {
+        low = high = H5F_LIBVER_LATEST;
+    }
+    HErr res = H5Pset_libver_bounds(fapl.h5id(), low, high);
+    res.check("Unable to create file (H5Pset_libver_bounds failed.)");
+
+    if (options.metadata_block_size > 0) {
+        res = H5Pset_meta_block_size(fapl.h5id(), options.metadata_block_size);
+        res.check("Unable to create file (H5Pset_meta_block_size failed.)");
+    }
+
+    if (options.page_buffer_size > 0) {
+#if H5_VERSION_GE(1, 10, 1)
+        res = H5Pset_page_buffer_size(fapl.h5id(), options.page_buffer_size, 0, 0);
+        res.check("Unable to create file (H5Pset_page_buffer_size failed.)");
+#else
+        throw std::runtime_error("Page buffering requires HDF5 1.10.1 or newer");
+#endif
+    }
+
+    if ((flags & OpenFlags::InMemory) == OpenFlags::InMemory) {
+        hbool_t backing_store = (flags & OpenFlags::BackingStore) == OpenFlags::BackingStore;
+        HErr res = H5Pset_fapl_core(fapl.h5id(), CORE_INCREMENT, backing_store);
+        res.check("Unable to create file (H5Pset_fapl_core failed.)");
+    }
+
+    return fapl;
+}
+
+
+FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, OpenFlags flags,
+                   const FileOptions &options):
+    file_format_version(HDF5_FF_VERSION) {
+    // in-memory files without backing store never touch the disk, but existing
+    // files are still loaded from it
+    bool exists = fileExists(name);
+    if (!exists && mode != FileMode::SwmrWrite) {
+        mode = FileMode::Overwrite;
+    }
+    this->mode = mode;
+    this->compr = compression;
     unsigned int h5mode =  map_file_mode(mode);
+    H5Object fcpl = make_file_create_plist(options);
+    H5Object fapl = make_file_access_plist(mode, flags, options);
 
-    bool is_create = !fileExists(name) || h5mode == H5F_ACC_TRUNC;
+    bool is_create = !exists || h5mode == H5F_ACC_TRUNC;
 
     if (is_create) {
-        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), H5P_DEFAULT);
+        hid = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), fapl.h5id());
     } else {
-        hid = H5Fopen(name.c_str(), h5mode, H5P_DEFAULT);
+        hid = H5Fopen(name.c_str(), h5mode, fapl.h5id());
     }
 
     if (!H5Iis_valid(hid)) {
         throw H5Exception("Could not open/create file");
     }
 
+    init(mode, is_create, flags, options);
+}
+
+
+FileHDF5::FileHDF5(const void *image, size_t size, FileMode mode, Compression compression, OpenFlags flags,
+                   const FileOptions &options):
+    file_format_version(HDF5_FF_VERSION) {
+    if (mode != FileMode::ReadOnly && mode != FileMode::ReadWrite) {
+        throw std::invalid_argument("Memory images can only be opened ReadOnly or ReadWrite");
+    }
+    this->mode = mode;
+    this->compr = compression;
+
+    // HDF5 copies the image, changes only affect the copy
+    H5Object fapl = make_file_access_plist(mode, OpenFlags::InMemory, options);
+    HErr res = H5Pset_file_image(fapl.h5id(), const_cast<void *>(image), size);
+    res.check("Unable to open file image (H5Pset_file_image failed.)");
+
+    hid = H5Fopen("memory-image", map_file_mode(mode), fapl.h5id());
+    if (!H5Iis_valid(hid)) {
+        throw H5Exception("Could not open file image");
+    }
+
+    init(mode, false, flags, options);
+}
+
+
+void FileHDF5::init(FileMode mode, bool is_create, OpenFlags flags, const FileOptions &options) {
+    if (options.statistics) {
+        stats = make_shared<StatisticsHDF5>();
+    }
+    page_buffered = options.page_buffer_size > 0;
+    default_compression_threads = options.compression_threads;
+    CallScope scope(stats, hid, ObjectType::File, "File::open");
+
     openRoot();
     if (is_create) {
         createHeader();
+        if (options.entity_layout == EntityLayout::Compact) {
+            root.setAttr("entity_layout", std::string("compact"));
+        }
     } else {
         checkHeader(mode, (flags & OpenFlags::Force) != OpenFlags::Force);
     }
 
+    string layout;
+    compact_entities = root.getAttr("entity_layout", layout) && layout == "compact";
+    root.compactLayout(compact_entities);
+
     metadata = root.openGroup("metadata");
     data = root.openGroup("data");
 
+    // SWMR writers can not create the catalog, so theirs stays stale until the next writer closes
+    if (mode == FileMode::ReadOnly || mode == FileMode::SwmrRead) {
+        if (CatalogHDF5::isValid(root)) {
+            catalog = make_shared<CatalogHDF5>(CatalogHDF5::load(root));
+            // files written by versions without catalog support leave it valid but incomplete
+            list_from_catalog = mode == FileMode::ReadOnly &&
+                                catalog->childCount("", ObjectType::Block) == data.objectCount() &&
+                                catalog->childCount("", ObjectType::Section) == metadata.objectCount();
+        }
+    } else if (options.catalog || CatalogHDF5::exists(root)) {
+        catalog_was_valid = CatalogHDF5::isValid(root);
+        maintain_catalog = mode != FileMode::SwmrWrite;
+        if (maintain_catalog) {
+            // only a catalog left stale by a writer that did not close the file is built from the groups
+            catalog = make_shared<CatalogHDF5>(catalog_was_valid ? CatalogHDF5::load(root) : CatalogHDF5::build(root));
+        }
+        CatalogHDF5::invalidate(root);
+    }
+
     setCreatedAt();
     setUpdatedAt();
+
+    if (mode == FileMode::SwmrWrite) {
+        HErr res = H5Fstart_swmr_write(hid);
+        res.check("Could not start SWMR write mode (was the file created in SwmrWrite mode?)");
+    }
 }
 
 
 bool FileHDF5::flush() {
+    CallScope scope(stats, hid, ObjectType::File, "File::flush");
     HErr err = H5Fflush(hid, H5F_SCOPE_GLOBAL);
     return !err.isError();
 }
 
+
+std::vector<char> FileHDF5::image() {
+    HErr res = H5Fflush(hid, H5F_SCOPE_GLOBAL);
+    res.check("FileHDF5::image(): Could not flush file");
+
+    ssize_t size = H5Fget_file_image(hid, nullptr, 0);
+    if (size < 0) {
+        throw H5Exception("FileHDF5::image(): Could not get the size of the file image");
+    }
+
+    std::vector<char> buf(static_cast<size_t>(size));
+    size = H5Fget_file_image(hid, buf.data(), buf.size());
+    if (size < 0) {
+        throw H5Exception("FileHDF5::image(): Could not get the file image");
+    }
+    return buf;
+}
+
+
+void FileHDF5::repack(const std::string &target, const RepackOptions &options) {
+    flush();
+    repackFile(hid, target, options);
+}
+
+
+IOStatistics FileHDF5::statistics() const {
+    IOStatistics result;
+    if (!stats) {
+        return result;
+    }
+
+    result = stats->snapshot();
+#if H5_VERSION_GE(1, 10, 1)
+    if (page_buffered && isOpen()) {
+        // metadata and raw data pages
+        unsigned accesses[2], hits[2], misses[2], evictions[2], bypasses[2];
+        HErr res = H5Fget_page_buffering_stats(hid, accesses, hits, misses, evictions, bypasses);
+        res.check("FileHDF5::statistics(): Could not get page buffer statistics");
+        result.total.cache_hits += hits[0] + hits[1];
+        result.total.cache_misses += misses[0] + misses[1];
+    }
+#endif
+    return result;
+}
+
+
+void FileHDF5::resetStatistics() {
+    if (!stats) {
+        return;
+    }
+
+    stats->reset();
+#if H5_VERSION_GE(1, 10, 1)
+    if (page_buffered && isOpen()) {
+        HErr res = H5Freset_page_buffering_stats(hid);
+        res.check("FileHDF5::resetStatistics(): Could not reset page buffer statistics");
+    }
+#endif
+}
+
 //--------------------------------------------------
 // Methods concerning blocks
 //--------------------------------------------------
 
 
 bool FileHDF5::hasBlock(const std::string &name_or_id) const {
+    CallScope scope(stats, hid, ObjectType::File, "File::hasBlock");
     return getBlock(name_or_id) != nullptr;
 }
 
 
 shared_ptr<base::IBlock> FileHDF5::getBlock(const std::string &name_or_id) const {
+    CallScope scope(stats, hid, ObjectType::File, "File::getBlock");
     shared_ptr<BlockHDF5> block;
 
-    boost::optional<H5Group> group = data.findGroupByNameOrAttribute("entity_id", name_or_id);
+    boost::optional<H5Group> group = findGroupByNameOrId(data, name_or_id);
     if (group)
         block = make_shared<BlockHDF5>(file(), *group);
 
@@ -111,24 +341,40 @@ shared_ptr<base::IBlock> FileHDF5::getBlock(const std::string &name_or_id) const
 
 
 shared_ptr<base::IBlock> FileHDF5::getBlock(ndsize_t index) const {
+    CallScope scope(stats, hid, ObjectType::File, "File::getBlock");
+    if (list_from_catalog) {
+        const CatalogEntry *entry = catalog->child("", ObjectType::Block, index);
+        return entry ? make_shared<BlockHDF5>(file(), *entry) : nullptr;
+    }
+
     string name = data.objectName(index);
     return getBlock(name);
 }
 
 
 shared_ptr<base::IBlock> FileHDF5::createBlock(const string &name, const string &type) {
+    CallScope scope(stats, hid, ObjectType::File, "File::createBlock");
     string id = util::createId();
     H5Group group = data.openGroup(name, true);
-    return make_shared<BlockHDF5>(file(), group, id, type, name, compr);
+    shared_ptr<BlockHDF5> block = make_shared<BlockHDF5>(file(), group, id, type, name, compr);
+    if (maintain_catalog) {
+        catalog->insert(group, ObjectType::Block, "", "data", name);
+    }
+    return block;
 }
 
 
 bool FileHDF5::deleteBlock(const std::string &name_or_id) {
+    CallScope scope(stats, hid, ObjectType::File, "File::deleteBlock");
     bool deleted = false;
 
-    if (hasBlock(name_or_id)) {
+    shared_ptr<base::IBlock> block = getBlock(name_or_id);
+    if (block) {
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = data.removeAllLinks(getBlock(name_or_id)->name());
+        deleted = data.removeAllLinks(block->name());
+        if (deleted && maintain_catalog) {
+            catalog->remove(block->id());
+        }
     }
 
     return deleted;
@@ -136,6 +382,9 @@ bool FileHDF5::deleteBlock(const std::string &name_or_id) {
 
 
 ndsize_t FileHDF5::blockCount() const {
+    if (list_from_catalog) {
+        return catalog->childCount("", ObjectType::Block);
+    }
     return data.objectCount();
 }
 
@@ -146,14 +395,16 @@ ndsize_t FileHDF5::blockCount() const {
 
 
 bool FileHDF5::hasSection(const std::string &name_or_id) const {
+    CallScope scope(stats, hid, ObjectType::File, "File::hasSection");
     return getSection(name_or_id) != nullptr;
 }
 
 
 shared_ptr<base::ISection> FileHDF5::getSection(const std::string &name_or_id) const {
+    CallScope scope(stats, hid, ObjectType::File, "File::getSection");
     shared_ptr<SectionHDF5> sec;
 
-    boost::optional<H5Group> group = metadata.findGroupByNameOrAttribute("entity_id", name_or_id);
+    boost::optional<H5Group> group = findGroupByNameOrId(metadata, name_or_id);
     if (group)
         sec = make_shared<SectionHDF5>(file(), *group);
 
@@ -162,20 +413,32 @@ shared_ptr<base::ISection> FileHDF5::getSection(const std::string &name_or_id) c
 
 
 shared_ptr<base::ISection> FileHDF5::getSection(ndsize_t index) const{
+    CallScope scope(stats, hid, ObjectType::File, "File::getSection");
+    if (list_from_catalog) {
+        const CatalogEntry *entry = catalog->child("", ObjectType::Section, index);
+        return entry ? make_shared<SectionHDF5>(file(), *entry) : nullptr;
+    }
+
     string name = metadata.objectName(index);
     return getSection(name);
 }
 
 
 shared_ptr<base::ISection> FileHDF5::createSection(const string &name, const  string &type) {
+    CallScope scope(stats, hid, ObjectType::File, "File::createSection");
     string id = util::createId();
 
     H5Group group = metadata.openGroup(name, true);
-    return make_shared<SectionHDF5>(file(), group, id, type, name);
+    shared_ptr<SectionHDF5> section = make_shared<SectionHDF5>(file(), group, id, type, name);
+    if (maintain_catalog) {
+        catalog->insert(group, ObjectType::Section, "", "metadata", name);
+    }
+    return section;
 }
 
 
 bool FileHDF5::deleteSection(const std::string &name_or_id) {
+    CallScope scope(stats, hid, ObjectType::File, "File::deleteSection");
     bool deleted = false;
 
     // call deleteSection on sections to trigger recursive call to all sub-sections
@@ -188,6 +451,9 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
         }
         // if hasSection is true then section_group always exists
         deleted = metadata.removeAllLinks(section.name());
+        if (deleted && maintain_catalog) {
+            catalog->remove(section.id());
+        }
     }
 
     return deleted;
@@ -195,6 +461,9 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
 
 
 ndsize_t FileHDF5::sectionCount() const {
+    if (list_from_catalog) {
+        return catalog->childCount("", ObjectType::Section);
+    }
     return metadata.objectCount();
 }
 
@@ -291,6 +560,18 @@ void FileHDF5::close() {
     if (!isOpen())
         return;
 
+    if (maintain_catalog) {
+        CallScope scope(stats, hid, ObjectType::File, "File::close");
+        maintain_catalog = false;
+        if (catalog_was_valid && !catalog->changed()) {
+            CatalogHDF5::validate(root);
+        } else {
+            catalog->save(root);
+        }
+        catalog.reset();
+    }
+    list_from_catalog = false;
+
     data.close();
     metadata.close();
     root.close();
@@ -335,6 +616,92 @@ FileMode FileHDF5::fileMode() const {
 }
 
 
+bool FileHDF5::compactLayout() const {
+    return compact_entities;
+}
+
+
+const std::shared_ptr<StatisticsHDF5> &FileHDF5::ioStats() const {
+    return stats;
+}
+
+
+size_t FileHDF5::compressionThreads(const EntityHDF5 &data_array) const {
+    {
+        // most files never set it per DataArray, so skip reading the id
+        std::lock_guard<std::mutex> lock(compression_mutex);
+        if (compression_threads.empty()) {
+            return default_compression_threads;
+        }
+    }
+    const string id = data_array.id();
+    std::lock_guard<std::mutex> lock(compression_mutex);
+    auto it = compression_threads.find(id);
+    return it != compression_threads.end() ? it->second : default_compression_threads;
+}
+
+
+void FileHDF5::compressionThreads(const EntityHDF5 &data_array, size_t threads) {
+    const string id = data_array.id();
+    std::lock_guard<std::mutex> lock(compression_mutex);
+    compression_threads[id] = threads;
+}
+
+
+boost::optional<H5Group> FileHDF5::findGroupByNameOrId(const H5Group &parent, const std::string &name_or_id) const {
+    if (parent.hasObject(name_or_id)) {
+        return boost::make_optional(parent.openGroup(name_or_id, false));
+    } else if (util::looksLikeUUID(name_or_id)) {
+        return findGroupById(parent, name_or_id);
+    }
+    return boost::optional<H5Group>();
+}
+
+
+boost::optional<H5Group> FileHDF5::findGroupById(const H5Group &parent, const std::string &id) const {
+    if (!catalog || maintain_catalog) {
+        return parent.findGroupByAttribute("entity_id", id);
+    }
+
+    // entities are linked by their name, wherever they appear
+    boost::optional<H5Group> g;
+    const CatalogEntry *entry = catalog->find(id);
+    if (entry && parent.hasGroup(entry->name)) {
+        H5Group group = parent.openGroup(entry->name, false);
+        std::string eid;
+        if (group.getAttr("entity_id", eid) && eid == id) {
+            g = group;
+        }
+    }
+
+    if (IOCounters *counters = h5x::activeCounters()) {
+        if (g) {
+            counters->cache_hits++;
+        } else {
+            counters->cache_misses++;
+        }
+    }
+
+    // files written by versions without catalog support leave it valid but incomplete
+    if (!g) {
+        g = parent.findGroupByAttribute("entity_id", id);
+    }
+    return g;
+}
+
+
+CatalogHDF5 *FileHDF5::maintainedCatalog(const std::shared_ptr<base::IFile> &file) {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(file);
+    return h5file && h5file->maintain_catalog ? h5file->catalog.get() : nullptr;
+}
+
+
+const CatalogHDF5 *FileHDF5::listingCatalog(const std::shared_ptr<base::IFile> &file) {
+    shared_ptr<FileHDF5> h5file = dynamic_pointer_cast<FileHDF5>(file);
+    return h5file && h5file->list_from_catalog ? h5file->catalog.get() : nullptr;
+}
+
+
 Compression FileHDF5::compression() const {
      return compr;
 }
@@ -366,7 +733,7 @@ bool FileHDF5::checkHeader(FileMode mode, bool throw_error) {
             message << "File is not a valid NIX file, could not read version attribute!";
         } else {
             file_format_version = FormatVersion(vv);
-            if (mode == FileMode::ReadWrite) {
+            if (mode == FileMode::ReadWrite || mode == FileMode::SwmrWrite) {
                 check = my_version.canWrite(file_format_version);
                 if (!check) {
                     message << "Cannot open file for ReadWrite access, format mismatch! ";
@@ -13,15 +13,21 @@
 #include <nix/Version.hpp>
 
 #include "h5x/H5Group.hpp"
+#include "CatalogHDF5.hpp"
+#include "StatisticsHDF5.hpp"
 
 #include <string>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #define HDF5_FF_VERSION nix::FormatVersion({1, 2, 0})
 
 namespace nix {
 namespace hdf5 {
 
+class EntityHDF5;
+
 /**
  * Class that represents a NIX file.
  */
@@ -34,6 +40,16 @@ private:
     H5Group root, metadata, data;
     FileMode mode;
     FormatVersion file_format_version;
+    bool compact_entities = false;
+    bool maintain_catalog = false;
+    bool catalog_was_valid = false;
+    bool list_from_catalog = false;
+    std::shared_ptr<CatalogHDF5> catalog;
+    std::shared_ptr<StatisticsHDF5> stats;
+    bool page_buffered = false;
+    size_t default_compression_threads = 0;
+    mutable std::mutex compression_mutex;
+    std::map<std::string, size_t> compression_threads;
 
 public:
 
@@ -43,8 +59,20 @@ public:
      * @param name    The name of the file to open.
      * @param prefix  The prefix used for IDs.
      * @param mode    File open mode ReadOnly, ReadWrite or Overwrite.
+     * @param options Layout and access options of the file.
+     */
+    FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::Auto, OpenFlags flags = OpenFlags::None,
+             const FileOptions &options = FileOptions());
+
+    /**
+     * Constructor that is used to open an in-memory copy of a file image.
+     *
+     * @param image   The file image, e.g. as returned by image().
+     * @param size    The size of the image in bytes.
+     * @param mode    File open mode ReadOnly or ReadWrite.
      */
-    FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::Auto, OpenFlags flags = OpenFlags::None);
+    FileHDF5(const void *image, size_t size, const FileMode mode = FileMode::ReadOnly, const Compression compression = Compression::Auto, OpenFlags flags = OpenFlags::None,
+             const FileOptions &options = FileOptions());
 
     //--------------------------------------------------
     // Methods concerning blocks
@@ -53,6 +81,18 @@ public:
     bool flush();
 
 
+    std::vector<char> image();
+
+
+    void repack(const std::string &target, const RepackOptions &options);
+
+
+    IOStatistics statistics() const;
+
+
+    void resetStatistics();
+
+
     ndsize_t blockCount() const;
 
 
@@ -137,6 +177,58 @@ public:
     FileMode fileMode() const;
 
 
+    /**
+     * Whether entities are stored in the compact layout (EntityLayout::Compact).
+     */
+    bool compactLayout() const;
+
+
+    /**
+     * The statistics of the file, or nullptr if none are collected.
+     */
+    const std::shared_ptr<StatisticsHDF5> &ioStats() const;
+
+
+    /**
+     * The number of threads compressing chunks when writing to the given
+     * DataArray. Set per DataArray for as long as the file is open, so that
+     * all handles to it share the setting; FileOptions::compression_threads
+     * is the default.
+     */
+    size_t compressionThreads(const EntityHDF5 &data_array) const;
+
+
+    void compressionThreads(const EntityHDF5 &data_array, size_t threads);
+
+
+    /**
+     * Find the sub-group of parent with the given name or entity id. Ids are
+     * looked up in the catalog, if the file was opened read-only with a valid
+     * one, and otherwise, or if the catalog does not list them, by scanning the
+     * sub-groups.
+     */
+    boost::optional<H5Group> findGroupByNameOrId(const H5Group &parent, const std::string &name_or_id) const;
+
+
+    boost::optional<H5Group> findGroupById(const H5Group &parent, const std::string &id) const;
+
+
+    /**
+     * The catalog a writer keeps in step with the entities of the file, or
+     * nullptr if the file does not maintain one.
+     */
+    static CatalogHDF5 *maintainedCatalog(const std::shared_ptr<base::IFile> &file);
+
+
+    /**
+     * The catalog to answer listings of blocks, sections, data arrays and tags
+     * from, if the file was opened read-only with a valid catalog that lists all
+     * blocks and sections, or nullptr. Entities listed from it open their group
+     * on first use.
+     */
+    static const CatalogHDF5 *listingCatalog(const std::shared_ptr<base::IFile> &file);
+
+
     Compression compression() const;
 
 
@@ -159,6 +251,9 @@ private:
     void openRoot();
 
 
+    void init(FileMode mode, bool is_create, OpenFlags flags, const FileOptions &options);
+
+
     bool checkHeader(FileMode mode, bool throw_error);
 
 
@@ -118,11 +118,13 @@ GroupHDF5::GroupHDF5(const std::shared_ptr<base::IFile> &file,
 }
 
 bool GroupHDF5::hasEntity(const nix::Identity &ident) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Group, "Group::hasEntity");
     boost::optional<H5Group> p = findEntityGroup(ident);
     return !!p;
 }
 
 std::shared_ptr<base::IEntity> GroupHDF5::getEntity(const nix::Identity &ident) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Group, "Group::getEntity");
     boost::optional<H5Group> eg = findEntityGroup(ident);
 
     switch (ident.type()) {
@@ -161,6 +163,7 @@ std::shared_ptr<base::IEntity> GroupHDF5::getEntity(const nix::Identity &ident)
 }
 
 std::shared_ptr<base::IEntity>GroupHDF5::getEntity(ObjectType type, ndsize_t index) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Group, "Group::getEntity");
     boost::optional<H5Group> eg = groupForObjectType(type);
     std::string name = eg ? eg->objectName(index) : "";
     return getEntity({name, "", type});
@@ -168,12 +171,14 @@ std::shared_ptr<base::IEntity>GroupHDF5::getEntity(ObjectType type, ndsize_t ind
 
 
 ndsize_t GroupHDF5::entityCount(ObjectType type) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Group, "Group::entityCount");
     boost::optional<H5Group> g = groupForObjectType(type);
     return g ? g->objectCount() : ndsize_t(0);
 }
 
 
 bool GroupHDF5::removeEntity(const nix::Identity &ident) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Group, "Group::removeEntity");
     boost::optional<H5Group> p = groupForObjectType(ident.type());
     boost::optional<H5Group> eg = findEntityGroup(ident);
 
@@ -190,6 +195,7 @@ bool GroupHDF5::removeEntity(const nix::Identity &ident) {
 
 
 void GroupHDF5::addEntity(const nix::Identity &ident) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Group, "Group::addEntity");
     boost::optional<H5Group> p = groupForObjectType(ident.type(), true);
     if(!block()->hasEntity(ident)) {
         throw std::runtime_error("Entity does not exist in this block!");
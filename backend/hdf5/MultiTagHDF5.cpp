@@ -45,6 +45,7 @@ MultiTagHDF5::MultiTagHDF5(const std::shared_ptr<IFile> &file, const std::shared
 
 
 std::shared_ptr<IDataArray> MultiTagHDF5::positions() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::MultiTag, "MultiTag::positions");
     std::shared_ptr<IDataArray> da;
     bool error = false;
 
@@ -66,6 +67,7 @@ std::shared_ptr<IDataArray> MultiTagHDF5::positions() const {
 
 
 void MultiTagHDF5::positions(const std::string &name_or_id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::MultiTag, "MultiTag::positions");
     std::shared_ptr<IDataArray> ida = block()->getEntity<IDataArray>(name_or_id);
     if (!ida)
         throw std::runtime_error("MultiTagHDF5::positions: DataArray not found in block!");
@@ -87,6 +89,7 @@ bool MultiTagHDF5::hasPositions() const {
 
 
 std::shared_ptr<IDataArray>  MultiTagHDF5::extents() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::MultiTag, "MultiTag::extents");
     std::shared_ptr<IDataArray> da;
     bool error = false;
 
@@ -106,6 +109,7 @@ std::shared_ptr<IDataArray>  MultiTagHDF5::extents() const {
 
 
 void MultiTagHDF5::extents(const std::string &name_or_id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::MultiTag, "MultiTag::extents");
     std::shared_ptr<IDataArray> ida = block()->getEntity<IDataArray>(name_or_id);
 
     if (!ida)
@@ -122,6 +126,7 @@ void MultiTagHDF5::extents(const std::string &name_or_id) {
 }
 
 void MultiTagHDF5::extents(const none_t t) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::MultiTag, "MultiTag::extents");
     if (group().hasGroup("extents")) {
         group().removeGroup("extents");
     }
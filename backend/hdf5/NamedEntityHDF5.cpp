@@ -26,6 +26,12 @@ NamedEntityHDF5::NamedEntityHDF5(const std::shared_ptr<IFile> &file, const H5Gro
 }
 
 
+NamedEntityHDF5::NamedEntityHDF5(const std::shared_ptr<IFile> &file, const CatalogEntry &entry)
+    : EntityHDF5(file, entry)
+{
+}
+
+
 NamedEntityHDF5::NamedEntityHDF5(const std::shared_ptr<IFile> &file, const H5Group &group, const string &id, const string &type,
                                  const string &name)
     : NamedEntityHDF5(file, group, id, type, name, util::getTime())
@@ -54,12 +60,17 @@ void NamedEntityHDF5::type(const string &type) {
         throw EmptyString("type");
     } else {
         group().setAttr("type", type);
+        catalogUpdate(&CatalogEntry::type, type);
         forceUpdatedAt();
     }
 }
 
 
 string NamedEntityHDF5::type() const {
+    if (const CatalogEntry *entry = catalogEntry()) {
+        return entry->type;
+    }
+
     string type;
     if (group().hasAttr("type")) {
         group().getAttr("type", type);
@@ -71,6 +82,10 @@ string NamedEntityHDF5::type() const {
 
 
 string NamedEntityHDF5::name() const {
+    if (const CatalogEntry *entry = catalogEntry()) {
+        return entry->name;
+    }
+
     string name;
     if (group().hasAttr("name")) {
         group().getAttr("name", name);
@@ -31,6 +31,11 @@ public:
      */
     NamedEntityHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group);
 
+    /**
+     * Constructor for existing entity listed from the catalog
+     */
+    NamedEntityHDF5(const std::shared_ptr<base::IFile> &file, const CatalogEntry &entry);
+
     /**
      * Standard constructor for new entity
      */
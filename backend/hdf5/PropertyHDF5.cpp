@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "PropertyHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include <nix/util/util.hpp>
 #include <nix/Version.hpp>
@@ -36,8 +37,25 @@ struct to_data_type<const char *> {
 namespace hdf5 {
 
 
+static std::shared_ptr<StatisticsHDF5> stats_of(const std::shared_ptr<IFile> &file) {
+    std::shared_ptr<FileHDF5> h5file = std::dynamic_pointer_cast<FileHDF5>(file);
+    return h5file ? h5file->ioStats() : std::shared_ptr<StatisticsHDF5>();
+}
+
+
+// the id is not yet set while a new property is constructed, its row is added afterwards
+static void update_catalog(const std::shared_ptr<IFile> &file, const DataSet &dataset,
+                           std::string CatalogEntry::*field, const std::string &value) {
+    CatalogHDF5 *catalog = FileHDF5::maintainedCatalog(file);
+    std::string id;
+    if (catalog && dataset.getAttr("entity_id", id)) {
+        catalog->update(id, field, value);
+    }
+}
+
+
 PropertyHDF5::PropertyHDF5(const std::shared_ptr<IFile> &file, const DataSet &dataset)
-    : entity_file(file)
+    : entity_file(file), entity_stats(stats_of(file))
 {
     this->entity_dataset = dataset;
 }
@@ -52,7 +70,7 @@ PropertyHDF5::PropertyHDF5(const std::shared_ptr<IFile> &file, const DataSet &da
 
     PropertyHDF5::PropertyHDF5(const std::shared_ptr<IFile> &file, const DataSet &dataset, const string &id,
                                const string &name, time_t time)
-    : entity_file(file)
+    : entity_file(file), entity_stats(stats_of(file))
 {
     this->entity_dataset = dataset;
     // set name
@@ -101,6 +119,7 @@ void PropertyHDF5::setUpdatedAt() {
 void PropertyHDF5::forceUpdatedAt() {
     time_t t = util::getTime();
     dataset().setAttr("updated_at", util::timeToStr(t));
+    update_catalog(entity_file, dataset(), &CatalogEntry::updated_at, util::timeToStr(t));
 }
 
 
@@ -121,6 +140,7 @@ void PropertyHDF5::setCreatedAt() {
 
 void PropertyHDF5::forceCreatedAt(time_t t) {
     dataset().setAttr("created_at", util::timeToStr(t));
+    update_catalog(entity_file, dataset(), &CatalogEntry::created_at, util::timeToStr(t));
 }
 
 
@@ -395,6 +415,7 @@ ndsize_t PropertyHDF5::valueCount() const {
 
 
 void PropertyHDF5::values(const std::vector<Variant> &values) {
+    CallScope scope(entity_stats, entity_dataset.h5id(), ObjectType::Property, "Property::values");
     if (values.size() < 1) {
         deleteValues();
         return;
@@ -467,6 +488,7 @@ std::vector<Value> PropertyHDF5::readOldstyleValues() const {
 
 
 std::vector<Variant> PropertyHDF5::values(void) const {
+    CallScope scope(entity_stats, entity_dataset.h5id(), ObjectType::Property, "Property::values");
     std::vector<Variant> values;
     nix::FormatVersion ver(this->entity_file->version());
     if (ver < nix::FormatVersion({1, 1, 1})) {
@@ -26,6 +26,7 @@ class PropertyHDF5 : virtual public base::IProperty {
 
     std::shared_ptr<base::IFile>  entity_file;
     DataSet                       entity_dataset;
+    std::shared_ptr<StatisticsHDF5> entity_stats;
 
 public:
 
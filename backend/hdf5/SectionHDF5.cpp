@@ -36,6 +36,14 @@ SectionHDF5::SectionHDF5(const std::shared_ptr<base::IFile> &file, const std::sh
 }
 
 
+SectionHDF5::SectionHDF5(const std::shared_ptr<base::IFile> &file, const CatalogEntry &entry)
+    : NamedEntityHDF5(file, entry)
+{
+    property_group = openOptGroup("properties");
+    section_group = openOptGroup("sections");
+}
+
+
 SectionHDF5::SectionHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id,
                          const string &type, const string &name)
     : SectionHDF5(file, nullptr, group, id, type, name)
@@ -94,6 +102,7 @@ void SectionHDF5::repository(const none_t t) {
 
 
 void SectionHDF5::link(const std::string &id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::link");
     if (group().hasGroup("link"))
         link(none);
 
@@ -109,6 +118,7 @@ void SectionHDF5::link(const std::string &id) {
 
 
 shared_ptr<ISection> SectionHDF5::link() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::link");
     shared_ptr<ISection> sec;
 
     if (group().hasGroup("link")) {
@@ -126,6 +136,7 @@ shared_ptr<ISection> SectionHDF5::link() const {
 
 
 void SectionHDF5::link(const none_t t) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::link");
     if (group().hasGroup("link")) {
         group().removeGroup("link");
     }
@@ -139,6 +150,7 @@ void SectionHDF5::link(const none_t t) {
 
 
 shared_ptr<ISection> SectionHDF5::parent() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::parent");
     return parent_section;
 }
 
@@ -149,22 +161,25 @@ shared_ptr<ISection> SectionHDF5::parent() const {
 
 
 ndsize_t SectionHDF5::sectionCount() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::sectionCount");
     boost::optional<H5Group> g = section_group();
     return g ? g->objectCount() : size_t(0);
 }
 
 
 bool SectionHDF5::hasSection(const string &name_or_id) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::hasSection");
     return getSection(name_or_id) != nullptr;
 }
 
 
 shared_ptr<ISection> SectionHDF5::getSection(const string &name_or_id) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::getSection");
     shared_ptr<SectionHDF5> section;
     boost::optional<H5Group> g = section_group();
 
     if(g) {
-        boost::optional<H5Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<H5Group> group = findGroupByNameOrId(*g, name_or_id);
         if (group) {
             auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
             section = make_shared<SectionHDF5>(file(), p, *group);
@@ -176,6 +191,7 @@ shared_ptr<ISection> SectionHDF5::getSection(const string &name_or_id) const {
 
 
 shared_ptr<ISection> SectionHDF5::getSection(ndsize_t index) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::getSection");
     boost::optional<H5Group> g = section_group();
     string name = g ? g->objectName(index) : "";
     return getSection(name);
@@ -183,16 +199,20 @@ shared_ptr<ISection> SectionHDF5::getSection(ndsize_t index) const {
 
 
 shared_ptr<ISection> SectionHDF5::createSection(const string &name, const string &type) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::createSection");
     string new_id = util::createId();
     boost::optional<H5Group> g = section_group(true);
 
     auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
     H5Group grp = g->openGroup(name, true);
-    return make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
+    shared_ptr<SectionHDF5> section = make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
+    catalogInsert(grp, ObjectType::Section, "sections", name);
+    return section;
 }
 
 
 bool SectionHDF5::deleteSection(const string &name_or_id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::deleteSection");
     boost::optional<H5Group> g = section_group();
     bool deleted = false;
 
@@ -207,6 +227,9 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
             }
             // if hasSection is true then section_group always exists
             deleted = g->removeAllLinks(section.name());
+            if (deleted) {
+                catalogRemove(section.id());
+            }
         }
     }
 
@@ -220,17 +243,20 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
 
 
 ndsize_t SectionHDF5::propertyCount() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::propertyCount");
     boost::optional<H5Group> g = property_group();
     return g ? g->objectCount() : size_t(0);
 }
 
 
 bool SectionHDF5::hasProperty(const string &name_or_id) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::hasProperty");
     return getProperty(name_or_id) != nullptr;
 }
 
 
 shared_ptr<IProperty> SectionHDF5::getProperty(const string &name_or_id) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::getProperty");
     shared_ptr<PropertyHDF5> prop;
     boost::optional<H5Group> g = property_group();
 
@@ -245,6 +271,7 @@ shared_ptr<IProperty> SectionHDF5::getProperty(const string &name_or_id) const {
 
 
 shared_ptr<IProperty> SectionHDF5::getProperty(ndsize_t index) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::getProperty");
     boost::optional<H5Group> g = property_group();
     string name = g ? g->objectName(index) : "";
     return getProperty(name);
@@ -252,21 +279,26 @@ shared_ptr<IProperty> SectionHDF5::getProperty(ndsize_t index) const {
 
 
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const DataType &dtype, const NDSize &shape) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::createProperty");
     string new_id = util::createId();
     boost::optional<H5Group> g = property_group(true);
     DataSet ds = g->createData(name, data_type_to_h5_filetype(dtype), shape, Compression::DeflateNormal,
                                {}, shape, true, false);
-    return make_shared<PropertyHDF5>(file(), ds, new_id, name);
+    shared_ptr<PropertyHDF5> prop = make_shared<PropertyHDF5>(file(), ds, new_id, name);
+    catalogInsert(ds, ObjectType::Property, "properties", name);
+    return prop;
 }
 
 
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const DataType &dtype) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::createProperty");
     shared_ptr<IProperty> p = createProperty(name, dtype, {DEFAULT_PROPERTY_SIZE});
     return p;
 }
 
 
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const Variant &value) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::createProperty");
     shared_ptr<IProperty> p = createProperty(name, value.type(), {DEFAULT_PROPERTY_SIZE});
     vector<Variant> val{value};
     p->values(val);
@@ -275,6 +307,7 @@ shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const Vari
 
 
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const vector<Variant> &values) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::createProperty");
     NDSize shape(1, values.size());
     shared_ptr<IProperty> p = createProperty(name, values[0].type(), shape);
     p->values(values);
@@ -283,10 +316,13 @@ shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const vect
 
 
 bool SectionHDF5::deleteProperty(const string &name_or_id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Section, "Section::deleteProperty");
     boost::optional<H5Group> g = property_group();
     bool deleted = false;
     if (g && hasProperty(name_or_id)) {
-        g->removeData(getProperty(name_or_id)->name());
+        shared_ptr<IProperty> prop = getProperty(name_or_id);
+        g->removeData(prop->name());
+        catalogRemove(prop->id());
         deleted = true;
     }
 
@@ -40,6 +40,11 @@ public:
      */
     SectionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group);
 
+    /**
+     * Constructor for existing root section listed from the catalog
+     */
+    SectionHDF5(const std::shared_ptr<base::IFile> &file, const CatalogEntry &entry);
+
     /**
      * Standard constructor for existing entity
      */
@@ -38,16 +38,18 @@ SourceHDF5::SourceHDF5(const shared_ptr<IFile> &file,  const std::shared_ptr<IBl
 
 
 bool SourceHDF5::hasSource(const string &name_or_id) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Source, "Source::hasSource");
     return getSource(name_or_id) != nullptr;
 }
 
 
 shared_ptr<ISource> SourceHDF5::getSource(const string &name_or_id) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Source, "Source::getSource");
     shared_ptr<SourceHDF5> source;
     boost::optional<H5Group> g = source_group();
 
     if (g) {
-        boost::optional<H5Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<H5Group> group = findGroupByNameOrId(*g, name_or_id);
         if (group)
             source = make_shared<SourceHDF5>(file(), parentBlock(), *group);
     }
@@ -57,6 +59,7 @@ shared_ptr<ISource> SourceHDF5::getSource(const string &name_or_id) const {
 
 
 shared_ptr<ISource> SourceHDF5::getSource(ndsize_t index) const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Source, "Source::getSource");
     boost::optional<H5Group> g = source_group();
     string name = g ? g->objectName(index) : "";
     return getSource(name);
@@ -64,21 +67,26 @@ shared_ptr<ISource> SourceHDF5::getSource(ndsize_t index) const {
 
 
 ndsize_t SourceHDF5::sourceCount() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Source, "Source::sourceCount");
     boost::optional<H5Group> g = source_group(false);
     return g ? g->objectCount() : size_t(0);
 }
 
 
 shared_ptr<ISource> SourceHDF5::createSource(const string &name, const string &type) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Source, "Source::createSource");
     string id = util::createId();
     boost::optional<H5Group> g = source_group(true);
 
     H5Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), parentBlock(), group, id, type, name);
+    shared_ptr<SourceHDF5> source = make_shared<SourceHDF5>(file(), parentBlock(), group, id, type, name);
+    catalogInsert(group, ObjectType::Source, "sources", name);
+    return source;
 }
 
 
 bool SourceHDF5::deleteSource(const string &name_or_id) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Source, "Source::deleteSource");
     boost::optional<H5Group> g = source_group();
     bool deleted = false;
     
@@ -93,6 +101,9 @@ bool SourceHDF5::deleteSource(const string &name_or_id) {
             }
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
+            if (deleted) {
+                catalogRemove(source.id());
+            }
         }
     }
 
@@ -0,0 +1,110 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "StatisticsHDF5.hpp"
+#include "h5x/H5Stats.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+std::atomic<uint64_t> next_key(1);
+
+} // anonymous namespace
+
+
+StatisticsHDF5::StatisticsHDF5()
+    : key(next_key++)
+{
+}
+
+
+StatisticsHDF5::ThreadCounters &StatisticsHDF5::local() {
+    static thread_local std::unordered_map<uint64_t, std::shared_ptr<ThreadCounters>> counters;
+
+    std::shared_ptr<ThreadCounters> &slot = counters[key];
+    if (!slot) {
+        // drop the counters of statistics that were destroyed in the meantime
+        for (auto it = counters.begin(); it != counters.end();) {
+            if (it->second && it->second.use_count() == 1) {
+                it = counters.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        slot = std::make_shared<ThreadCounters>();
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.push_back(slot);
+    }
+
+    return *slot;
+}
+
+
+void StatisticsHDF5::record(ObjectType type, const char *call, const IOCounters &counters) {
+    ThreadCounters &tc = local();
+    std::lock_guard<std::mutex> lock(tc.mutex);
+    auto &entry = tc.calls[call];
+    entry.first = type;
+    entry.second += counters;
+}
+
+
+IOStatistics StatisticsHDF5::snapshot() const {
+    IOStatistics stats;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &tc : threads) {
+        std::lock_guard<std::mutex> tc_lock(tc->mutex);
+        for (const auto &call : tc->calls) {
+            stats.calls[std::string(call.first)] += call.second.second;
+            stats.entities[call.second.first] += call.second.second;
+            stats.total += call.second.second;
+        }
+    }
+
+    return stats;
+}
+
+
+void StatisticsHDF5::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &tc : threads) {
+        std::lock_guard<std::mutex> tc_lock(tc->mutex);
+        tc->calls.clear();
+    }
+}
+
+
+CallScope::CallScope(const std::shared_ptr<StatisticsHDF5> &stats, hid_t obj, ObjectType type, const char *call)
+    : span(call, "nix", obj), type(type), call(call)
+{
+    IOCounters *&active = h5x::activeCounters();
+    if (stats && !active) {
+        this->stats = stats;
+        counters.calls = 1;
+        active = &counters;
+    }
+}
+
+
+CallScope::~CallScope() {
+    if (stats) {
+        h5x::activeCounters() = nullptr;
+        stats->record(type, call, counters);
+    }
+}
+
+
+} // namespace hdf5
+} // namespace nix
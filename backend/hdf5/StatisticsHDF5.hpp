@@ -0,0 +1,105 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STATISTICS_HDF5_H
+#define NIX_STATISTICS_HDF5_H
+
+#include <nix/Statistics.hpp>
+#include <nix/ObjectType.hpp>
+#include "h5x/H5Trace.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * The I/O statistics of a file. Every thread records into counters of its
+ * own, which are only summed up when a snapshot is taken, so that recording
+ * never contends with other threads.
+ */
+class StatisticsHDF5 {
+
+public:
+
+    StatisticsHDF5();
+
+
+    void record(ObjectType type, const char *call, const IOCounters &counters);
+
+
+    IOStatistics snapshot() const;
+
+
+    void reset();
+
+private:
+
+    // the counters of one thread, keyed by the (static) name of the call
+    struct ThreadCounters {
+        std::mutex mutex;
+        std::unordered_map<const char *, std::pair<ObjectType, IOCounters>> calls;
+    };
+
+
+    ThreadCounters &local();
+
+
+    const uint64_t key;
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadCounters>> threads;
+};
+
+
+/**
+ * Marks an API call on the HDF5 object obj: traces it, and collects its
+ * operations if the file has statistics. For statistics the scopes of nested
+ * calls are inactive, so operations are counted once, for the call made by
+ * the user.
+ *
+ * ~~~
+ * std::vector<double> DataArrayHDF5::polynomCoefficients() const {
+ *     CallScope scope(ioStats(), groupHandle(), ObjectType::DataArray, "DataArray::polynomCoefficients");
+ *     ...
+ * ~~~
+ */
+class CallScope {
+
+public:
+
+    CallScope(const std::shared_ptr<StatisticsHDF5> &stats, hid_t obj, ObjectType type, const char *call);
+
+
+    CallScope(const CallScope &other) = delete;
+
+
+    CallScope &operator=(const CallScope &other) = delete;
+
+
+    ~CallScope();
+
+private:
+
+    h5x::TraceSpan span;
+    std::shared_ptr<StatisticsHDF5> stats;
+    ObjectType type;
+    const char *call;
+    IOCounters counters;
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_STATISTICS_HDF5_H
@@ -24,6 +24,12 @@ TagHDF5::TagHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBloc
 }
 
 
+TagHDF5::TagHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block, const CatalogEntry &entry)
+    : BaseTagHDF5(file, block, entry)
+{
+}
+
+
 TagHDF5::TagHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block, const H5Group &group,
                  const std::string &id, const std::string &type, const std::string &name,
                  const std::vector<double> &position)
@@ -63,6 +69,7 @@ void TagHDF5::units(const none_t t) {
 
 
 std::vector<double> TagHDF5::position() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Tag, "Tag::position");
     std::vector<double> position;
 
     if (group().hasData("position")) {
@@ -74,11 +81,13 @@ std::vector<double> TagHDF5::position() const {
 
 
 void TagHDF5::position(const std::vector<double> &position) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Tag, "Tag::position");
     group().setData("position", position);
 }
 
 
 std::vector<double> TagHDF5::extent() const {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Tag, "Tag::extent");
     std::vector<double> extent;
     group().getData("extent", extent);
     return extent;
@@ -86,11 +95,13 @@ std::vector<double> TagHDF5::extent() const {
 
 
 void TagHDF5::extent(const std::vector<double> &extent) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Tag, "Tag::extent");
     group().setData("extent", extent);
 }
 
 
 void TagHDF5::extent(const none_t t) {
+    CallScope scope(ioStats(), groupHandle(), ObjectType::Tag, "Tag::extent");
     if (group().hasData("extent")) {
         group().removeData("extent");
     }
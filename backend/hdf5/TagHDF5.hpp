@@ -34,6 +34,11 @@ public:
      */
     TagHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group);
 
+    /**
+     * Constructor for existing Tag listed from the catalog
+     */
+    TagHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const CatalogEntry &entry);
+
     /**
      * Standard constructor for new Tag
      */
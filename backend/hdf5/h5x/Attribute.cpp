@@ -10,6 +10,10 @@
 
 #include "Attribute.hpp"
 #include "H5DataType.hpp"
+#include "H5Stats.hpp"
+
+#include <algorithm>
+#include <vector>
 
 namespace nix {
 namespace hdf5 {
@@ -28,9 +32,24 @@ Attribute::Attribute(const Attribute &other) : H5Object(other) {
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, void *data) {
     HErr status = H5Aread(hid, mem_type.h5id(), data);
     status.check("Attribute::read(): Could not read data");
+    count(mem_type, false);
 }
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *data) {
+    // there is no conversion between fixed-size and variable length strings
+    h5x::DataType file_type = dataType();
+    if (file_type.class_t() == H5T_STRING && !file_type.isVariableString()) {
+        const size_t len = file_type.size();
+        const size_t n = static_cast<size_t>(size.nelms());
+        std::vector<char> buf(n * len);
+        read(file_type, size, static_cast<void *>(buf.data()));
+        for (size_t i = 0; i < n; i++) {
+            const char *str = buf.data() + i * len;
+            data[i].assign(str, std::find(str, str + len, '\0'));
+        }
+        return;
+    }
+
     StringWriter writer(size, data);
     read(mem_type, size, *writer);
     writer.finish();
@@ -44,13 +63,48 @@ void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *da
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const void *data) {
     HErr status = H5Awrite(hid, mem_type.h5id(), data);
     status.check("Attribute::write(): Could not write data");
+    count(mem_type, true);
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const std::string *data) {
+    h5x::DataType file_type = dataType();
+    if (file_type.class_t() == H5T_STRING && !file_type.isVariableString()) {
+        const size_t len = file_type.size();
+        const size_t n = static_cast<size_t>(size.nelms());
+        std::vector<char> buf(n * len, 0);
+        for (size_t i = 0; i < n; i++) {
+            if (data[i].size() > len) {
+                throw H5Exception("Attribute::write(): String too long for fixed-size attribute");
+            }
+            std::copy(data[i].begin(), data[i].end(), buf.begin() + i * len);
+        }
+        write(file_type, size, static_cast<const void *>(buf.data()));
+        return;
+    }
+
     StringReader reader(size, data);
     write(mem_type, size, *reader);
 }
 
+void Attribute::count(const h5x::DataType &mem_type, bool is_write) const {
+    IOCounters *counters = h5x::activeCounters();
+    if (!counters) {
+        return;
+    }
+
+    if (is_write) {
+        counters->attribute_writes++;
+    } else {
+        counters->attribute_reads++;
+    }
+
+    hid_t file_type = H5Aget_type(hid);
+    if (file_type >= 0) {
+        counters->conversions += h5x::isConversion(mem_type.h5id(), file_type) ? 1 : 0;
+        H5Tclose(file_type);
+    }
+}
+
 PList Attribute::createPList() const {
     PList pl = H5Aget_create_plist(hid);
     pl.check("Attribute::createPList(): Could not get creation property list");
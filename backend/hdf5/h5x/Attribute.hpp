@@ -41,6 +41,9 @@ public:
         H5Object::operator=(other);
         return *this;
     }
+
+private:
+    void count(const h5x::DataType &mem_type, bool is_write) const;
 };
 
 
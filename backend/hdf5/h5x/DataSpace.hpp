@@ -13,6 +13,8 @@
 
 #include "H5Object.hpp"
 
+#include <vector>
+
 #ifndef NIX_DATASPACE_H
 #define NIX_DATASPACE_H
 
@@ -33,6 +35,10 @@ public:
 
     void hyperslab(const NDSize &count, const NDSize &start, H5S_seloper_t op = H5S_SELECT_SET);
 
+    void elements(const std::vector<ndsize_t> &coords, H5S_seloper_t op = H5S_SELECT_SET);
+
+    void selectNone();
+
     DataSpace &operator=(const DataSpace &other) {
         H5Object::operator=(other);
         return *this;
@@ -8,9 +8,22 @@
 
 #include "H5DataSet.hpp"
 #include "H5Exception.hpp"
+#include "H5Stats.hpp"
+#include "H5Trace.hpp"
+#include "WorkerPool.hpp"
 
 #include <iostream>
+#include <chrono>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#ifdef NIX_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 namespace nix {
 namespace hdf5 {
@@ -25,16 +38,65 @@ DataSet::DataSet(const DataSet &other)
 
 }
 
+/**
+ * Count a transfer of the given types and selection with the active
+ * statistics, if any, cf. h5x::activeCounters(), and report its size
+ * to the trace span
+ */
+static void count_transfer(hid_t dset, const h5x::DataType &memType, const DataSpace &memSpace, bool is_write,
+                           std::chrono::steady_clock::time_point start, h5x::TraceSpan &span)
+{
+    IOCounters *counters = h5x::activeCounters();
+    if (!counters && !span.active()) {
+        return;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    hid_t space = memSpace.h5id() == H5S_ALL ? H5Dget_space(dset) : memSpace.h5id();
+    hssize_t n = H5Sget_select_npoints(space);
+    if (space != memSpace.h5id()) {
+        H5Sclose(space);
+    }
+    uint64_t bytes = n > 0 ? static_cast<uint64_t>(n) * memType.size() : 0;
+    span.bytes(bytes);
+    if (!counters) {
+        return;
+    }
+
+    hid_t file_type = H5Dget_type(dset);
+    if (file_type >= 0) {
+        counters->conversions += h5x::isConversion(memType.h5id(), file_type) ? 1 : 0;
+        H5Tclose(file_type);
+    }
+
+    if (is_write) {
+        counters->dataset_writes++;
+        counters->bytes_written += bytes;
+        counters->write_time += elapsed.count();
+    } else {
+        counters->dataset_reads++;
+        counters->bytes_read += bytes;
+        counters->read_time += elapsed.count();
+    }
+}
+
 void DataSet::read(void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace) const
 {
+    h5x::TraceSpan span("DataSet::read", "hdf5", hid);
+    auto start = std::chrono::steady_clock::now();
     HErr res = H5Dread(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::read() IO error");
+    count_transfer(hid, memType, memSpace, false, start, span);
 }
 
 void DataSet::write(const void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace)
 {
+    h5x::TraceSpan span("DataSet::write", "hdf5", hid);
+    auto start = std::chrono::steady_clock::now();
     HErr res = H5Dwrite(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::write() IOError");
+    count_transfer(hid, memType, memSpace, true, start, span);
 }
 
 void DataSet::read(void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset) const
@@ -146,6 +208,109 @@ NDSize DataSet::guessChunking(NDSize chunks, size_t element_size)
     return chunks;
 }
 
+NDSize DataSet::adviseChunking(const NDSize &dims, size_t element_size,
+                               boost::optional<size_t> append_axis,
+                               boost::optional<size_t> read_axis,
+                               size_t cache_size)
+{
+    const size_t rank = dims.size();
+    if (rank == 0) {
+        throw InvalidRank("Cannot advise chunks for 0-dimensional data");
+    }
+    if ((append_axis && *append_axis >= rank) || (read_axis && *read_axis >= rank)) {
+        throw InvalidRank("Access pattern axis exceeds the rank of the data");
+    }
+    if (!append_axis && !read_axis) {
+        return guessChunking(dims, element_size);
+    }
+
+    // number of elements that fit into the cache, at least one
+    const ndsize_t budget = std::max<ndsize_t>(cache_size / std::max<size_t>(element_size, 1), 1);
+
+    const NDSize guessed = guessChunking(dims, element_size);
+    NDSize chunks(rank, 1);
+    for (size_t i = 0; i < rank; i++) {
+        if (append_axis && i == *append_axis) {
+            continue;
+        }
+        if (!read_axis || i == *read_axis) {
+            // whole extent along the read axis, or across the appended slab if
+            // there is no read axis; an empty axis defaults to the guessed length
+            chunks[i] = dims[i] > 0 ? dims[i] : guessed[i];
+        }
+    }
+
+    // shrink the largest non-append dimension until a single chunk fits the cache
+    while (chunks.nelms() > budget) {
+        size_t largest = rank;
+        for (size_t i = 0; i < rank; i++) {
+            if (append_axis && i == *append_axis) {
+                continue;
+            }
+            if (largest == rank || chunks[i] > chunks[largest]) {
+                largest = i;
+            }
+        }
+        if (largest == rank || chunks[largest] == 1) {
+            break;
+        }
+        chunks[largest] = (chunks[largest] + 1) / 2;
+    }
+
+    if (append_axis) {
+        // all chunks covering one slab along the append axis must fit the cache together
+        ndsize_t slab = 1;
+        for (size_t i = 0; i < rank; i++) {
+            if (i != *append_axis) {
+                ndsize_t n = dims[i] > 0 ? (dims[i] + chunks[i] - 1) / chunks[i] : 1;
+                slab *= n * chunks[i];
+            }
+        }
+        chunks[*append_axis] = std::max<ndsize_t>(budget / slab, 1);
+    }
+
+    // keep a single chunk within the bounds used by guessChunking
+    const ndsize_t max_elms = std::max<ndsize_t>(CHUNK_MAX / std::max<size_t>(element_size, 1), 1);
+    while (chunks.nelms() > max_elms) {
+        size_t largest = 0;
+        for (size_t i = 1; i < rank; i++) {
+            if (chunks[i] > chunks[largest]) {
+                largest = i;
+            }
+        }
+        chunks[largest] = (chunks[largest] + 1) / 2;
+    }
+
+    // grow small chunks along the append axis first, then the read axis, then the rest
+    const ndsize_t min_elms = (CHUNK_MIN + element_size - 1) / std::max<size_t>(element_size, 1);
+    std::vector<size_t> order;
+    if (append_axis) {
+        order.push_back(*append_axis);
+    }
+    if (read_axis && (!append_axis || *read_axis != *append_axis)) {
+        order.push_back(*read_axis);
+    }
+    for (size_t i = 0; i < rank; i++) {
+        if (std::find(order.begin(), order.end(), i) == order.end()) {
+            order.push_back(i);
+        }
+    }
+    for (size_t i : order) {
+        if (chunks.nelms() >= min_elms) {
+            break;
+        }
+        const ndsize_t others = chunks.nelms() / chunks[i];
+        ndsize_t wanted = (min_elms + others - 1) / others;
+        if (dims[i] > 0 && !(append_axis && i == *append_axis)) {
+            wanted = std::min(wanted, dims[i]);
+        }
+        chunks[i] = std::max(chunks[i], wanted);
+    }
+
+    return chunks;
+}
+
+
 std::tuple<ndsize_t, ndsize_t> DataSet::getChunkBounds()
 {
     return std::make_tuple(CHUNK_MIN, CHUNK_MAX);
@@ -171,6 +336,399 @@ NDSize DataSet::size() const
     return getSpace().extent();
 }
 
+
+void DataSet::refresh()
+{
+    HErr res = H5Drefresh(hid);
+    res.check("DataSet::refresh(): Could not refresh the DataSet");
+}
+
+
+NDSize DataSet::chunkShape() const
+{
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::chunkShape(): Could not get the creation property list");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize{};
+    }
+
+    int rank = H5Pget_chunk(dcpl.h5id(), 0, nullptr);
+    if (rank < 0) {
+        throw H5Exception("DataSet::chunkShape(): Could not get the chunk rank");
+    }
+    NDSize chunks(static_cast<size_t>(rank));
+    HErr res = H5Pget_chunk(dcpl.h5id(), rank, chunks.data());
+    res.check("DataSet::chunkShape(): Could not get the chunk shape");
+    return chunks;
+}
+
+static void checkChunkOffset(const DataSet &ds, const NDSize &offset)
+{
+    NDSize chunks = ds.chunkShape();
+    if (!chunks) {
+        throw H5Exception("DataSet: chunk access requires a chunked dataset");
+    }
+    if (offset.size() != chunks.size()) {
+        throw InvalidRank("DataSet: chunk offset must have the rank of the dataset");
+    }
+    NDSize extent = ds.size();
+    for (size_t i = 0; i < offset.size(); i++) {
+        if (offset[i] % chunks[i] != 0) {
+            throw std::invalid_argument("DataSet: chunk offset is not aligned to the chunk shape");
+        }
+        if (offset[i] >= extent[i]) {
+            throw OutOfBounds("DataSet: chunk offset exceeds the extent of the dataset", offset[i]);
+        }
+    }
+}
+
+
+// chunks are transferred as they are stored, i.e. without conversion
+static void count_chunk(size_t size, bool is_write, std::chrono::steady_clock::time_point start)
+{
+    IOCounters *counters = h5x::activeCounters();
+    if (!counters) {
+        return;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (is_write) {
+        counters->dataset_writes++;
+        counters->bytes_written += size;
+        counters->write_time += elapsed.count();
+    } else {
+        counters->dataset_reads++;
+        counters->bytes_read += size;
+        counters->read_time += elapsed.count();
+    }
+}
+
+
+void DataSet::writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask)
+{
+    checkChunkOffset(*this, offset);
+#if H5_VERSION_GE(1, 10, 3)
+    auto start = std::chrono::steady_clock::now();
+    HErr res = H5Dwrite_chunk(hid, H5P_DEFAULT, filter_mask, offset.data(), size, data);
+    res.check("DataSet::writeChunk(): Could not write chunk");
+    count_chunk(size, true, start);
+#else
+    throw std::runtime_error("DataSet::writeChunk() requires HDF5 1.10.3 or newer");
+#endif
+}
+
+
+size_t DataSet::chunkStorageSize(const NDSize &offset) const
+{
+    checkChunkOffset(*this, offset);
+    hsize_t nbytes = 0;
+#if H5_VERSION_GE(1, 10, 5)
+    // unlike H5Dget_chunk_storage_size this does not fail for chunks that were never written
+    unsigned filter_mask;
+    haddr_t addr;
+    HErr res = H5Dget_chunk_info_by_coord(hid, offset.data(), &filter_mask, &addr, &nbytes);
+#else
+    HErr res = H5Dget_chunk_storage_size(hid, offset.data(), &nbytes);
+#endif
+    res.check("DataSet::chunkStorageSize(): Could not get chunk size");
+    return static_cast<size_t>(nbytes);
+}
+
+
+uint32_t DataSet::readChunk(const NDSize &offset, void *data) const
+{
+    checkChunkOffset(*this, offset);
+#if H5_VERSION_GE(1, 10, 3)
+    uint32_t filter_mask = 0;
+    size_t size = h5x::activeCounters() ? chunkStorageSize(offset) : 0;
+    auto start = std::chrono::steady_clock::now();
+    HErr res = H5Dread_chunk(hid, H5P_DEFAULT, offset.data(), &filter_mask, data);
+    res.check("DataSet::readChunk(): Could not read chunk");
+    count_chunk(size, false, start);
+    return filter_mask;
+#else
+    throw std::runtime_error("DataSet::readChunk() requires HDF5 1.10.3 or newer");
+#endif
+}
+
+
+#if defined(NIX_HAVE_ZLIB) && H5_VERSION_GE(1, 10, 3)
+
+/**
+ * Check that the filter pipeline of the dataset consists of deflate, optionally
+ * preceded by shuffle, which are the filters writeChunksParallel can apply itself.
+ */
+static bool deflatePipeline(hid_t dcpl, bool &shuffle, int &level)
+{
+    int nfilters = H5Pget_nfilters(dcpl);
+    if (nfilters < 1 || nfilters > 2) {
+        return false;
+    }
+
+    shuffle = false;
+    level = -1;
+    for (unsigned i = 0; i < static_cast<unsigned>(nfilters); i++) {
+        unsigned int flags;
+        unsigned int cd_values[8];
+        size_t cd_nelmts = 8;
+        unsigned int config;
+        H5Z_filter_t filter = H5Pget_filter2(dcpl, i, &flags, &cd_nelmts, cd_values, 0, nullptr, &config);
+
+        if (filter == H5Z_FILTER_SHUFFLE && i == 0 && nfilters == 2) {
+            shuffle = true;
+        } else if (filter == H5Z_FILTER_DEFLATE && i + 1 == static_cast<unsigned>(nfilters) && cd_nelmts > 0) {
+            level = static_cast<int>(cd_values[0]);
+        } else {
+            return false;
+        }
+    }
+
+    return level >= 0;
+}
+
+/**
+ * Copy the part of the box (at box_start, of shape box_count) of a row-major
+ * block of shape count that falls into chunk number index of the box into buf,
+ * shuffle and deflate it.
+ */
+static void compressChunk(const char *data, const NDSize &count, const NDSize &box_start, const NDSize &box_count,
+                          const NDSize &chunks, const NDSize &grid, size_t index, size_t elem_size,
+                          bool shuffle, int level, std::vector<char> &tmp, std::vector<unsigned char> &buf)
+{
+    const size_t rank = count.size();
+    NDSize origin(rank), valid(rank);
+    bool partial = false;
+    for (size_t i = rank; i > 0; i--) {
+        origin[i - 1] = box_start[i - 1] + (index % grid[i - 1]) * chunks[i - 1];
+        index /= grid[i - 1];
+        valid[i - 1] = std::min(chunks[i - 1], box_start[i - 1] + box_count[i - 1] - origin[i - 1]);
+        partial = partial || valid[i - 1] != chunks[i - 1];
+    }
+
+    const size_t chunk_bytes = static_cast<size_t>(chunks.nelms()) * elem_size;
+    tmp.resize(chunk_bytes);
+    if (partial) {
+        std::fill(tmp.begin(), tmp.end(), 0);
+    }
+
+    // copy all rows of the chunk, i.e. runs along the last dimension
+    const size_t row_bytes = static_cast<size_t>(valid[rank - 1]) * elem_size;
+    const ndsize_t nrows = valid.nelms() / valid[rank - 1];
+    NDSize pos(rank, 0);
+    for (ndsize_t r = 0; r < nrows; r++) {
+        ndsize_t src = 0, dst = 0;
+        for (size_t i = 0; i < rank; i++) {
+            src = src * count[i] + origin[i] + pos[i];
+            dst = dst * chunks[i] + pos[i];
+        }
+        std::memcpy(tmp.data() + dst * elem_size, data + src * elem_size, row_bytes);
+
+        for (size_t i = rank - 1; i > 0; i--) {
+            if (++pos[i - 1] < valid[i - 1]) {
+                break;
+            }
+            pos[i - 1] = 0;
+        }
+    }
+
+    const char *src = tmp.data();
+    std::vector<char> shuffled;
+    if (shuffle && elem_size > 1) {
+        shuffled.resize(chunk_bytes);
+        const size_t n = chunk_bytes / elem_size;
+        for (size_t b = 0; b < elem_size; b++) {
+            char *out = shuffled.data() + b * n;
+            for (size_t e = 0; e < n; e++) {
+                out[e] = src[e * elem_size + b];
+            }
+        }
+        src = shuffled.data();
+    }
+
+    uLongf nbytes = compressBound(static_cast<uLong>(chunk_bytes));
+    buf.resize(nbytes);
+    int res = compress2(buf.data(), &nbytes, reinterpret_cast<const Bytef *>(src),
+                        static_cast<uLong>(chunk_bytes), level);
+    if (res != Z_OK) {
+        throw H5Exception("DataSet::writeChunksParallel(): Could not compress chunk");
+    }
+    buf.resize(nbytes);
+}
+
+#endif
+
+
+bool DataSet::writeChunksParallel(const void *data, const h5x::DataType &memType, const NDSize &count,
+                                  const NDSize &offset, size_t threads)
+{
+#if defined(NIX_HAVE_ZLIB) && H5_VERSION_GE(1, 10, 3)
+    if (threads == 0 || !count) {
+        return false;
+    }
+
+    NDSize chunks = chunkShape();
+    if (!chunks || chunks.size() != count.size()) {
+        return false;
+    }
+
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::writeChunksParallel(): Could not get the creation property list");
+    bool shuffle;
+    int level;
+    if (!deflatePipeline(dcpl.h5id(), shuffle, level)) {
+        return false;
+    }
+
+    h5x::DataType fileType = dataType();
+    H5T_class_t klass = fileType.class_t();
+    if ((klass != H5T_INTEGER && klass != H5T_FLOAT) || !memType.equal(fileType)) {
+        return false;
+    }
+
+    // the box of whole chunks inside the selection; the last chunk along a
+    // dimension may be cut by the extent of the dataset
+    const size_t rank = count.size();
+    NDSize extent = size();
+    NDSize start = offset ? offset : NDSize(rank, 0);
+    if (start.size() != rank) {
+        return false;
+    }
+    NDSize box_start(rank), box_count(rank), grid(rank);
+    for (size_t i = 0; i < rank; i++) {
+        const ndsize_t end = start[i] + count[i];
+        if (end > extent[i]) {
+            return false;
+        }
+        const ndsize_t first = (start[i] + chunks[i] - 1) / chunks[i] * chunks[i];
+        const ndsize_t last = end == extent[i] ? end : end / chunks[i] * chunks[i];
+        if (first >= last) {
+            return false;
+        }
+        box_start[i] = first - start[i];
+        box_count[i] = last - first;
+        grid[i] = (box_count[i] + chunks[i] - 1) / chunks[i];
+    }
+
+    const size_t elem_size = fileType.size();
+    const size_t total = static_cast<size_t>(grid.nelms());
+    const size_t window = threads * 4;
+
+    struct Slot {
+        std::vector<unsigned char> buf;
+        bool ready = false;
+    };
+    std::vector<Slot> slots(window);
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t next = 0;
+    size_t written = 0;
+    bool abort = false;
+    bool write_failed = false;
+
+    // workers compress the chunks in any order, but at most window chunks
+    // ahead of the writer, which bounds the memory held by compressed chunks
+    auto worker = [&]() {
+        std::vector<char> tmp;
+        std::vector<unsigned char> buf;
+        for (;;) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&] { return abort || next >= total || next < written + window; });
+                if (abort || next >= total) {
+                    return;
+                }
+                index = next++;
+            }
+
+            try {
+                compressChunk(static_cast<const char *>(data), count, box_start, box_count, chunks, grid, index,
+                              elem_size, shuffle, level, tmp, buf);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                abort = true;
+                cond.notify_all();
+                throw;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            slots[index % window].buf.swap(buf);
+            slots[index % window].ready = true;
+            cond.notify_all();
+        }
+    };
+
+    // the calling thread writes the compressed chunks in order
+    auto writer = [&]() {
+        // workers wait for the writer, so they must learn that it failed
+        try {
+            std::vector<unsigned char> buf;
+            NDSize chunk_offset(rank);
+            for (size_t c = 0; c < total; c++) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond.wait(lock, [&] { return abort || slots[c % window].ready; });
+                    if (abort) {
+                        return;
+                    }
+                    buf.swap(slots[c % window].buf);
+                    slots[c % window].ready = false;
+                    written = c + 1;
+                    cond.notify_all();
+                }
+
+                size_t index = c;
+                for (size_t i = rank; i > 0; i--) {
+                    chunk_offset[i - 1] = start[i - 1] + box_start[i - 1] + (index % grid[i - 1]) * chunks[i - 1];
+                    index /= grid[i - 1];
+                }
+
+                auto t_start = std::chrono::steady_clock::now();
+                HErr res = H5Dwrite_chunk(hid, H5P_DEFAULT, 0, chunk_offset.data(), buf.size(), buf.data());
+                count_chunk(buf.size(), true, t_start);
+                if (res.isError()) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    abort = write_failed = true;
+                    cond.notify_all();
+                    return;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            abort = true;
+            cond.notify_all();
+            throw;
+        }
+    };
+
+    h5x::WorkerPool::shared().run(std::min(threads, total), worker, writer);
+    if (write_failed) {
+        throw H5Exception("DataSet::writeChunksParallel(): Could not write chunk");
+    }
+
+    // the rest of the selection, i.e. the partial chunks around the box, goes
+    // through the filter pipeline with a single H5Dwrite
+    if (box_count != count) {
+        DataSpace memSpace = DataSpace::create(count, false);
+        memSpace.hyperslab(count, NDSize(rank, 0));
+        memSpace.hyperslab(box_count, box_start, H5S_SELECT_NOTB);
+        DataSpace fileSpace = getSpace();
+        fileSpace.hyperslab(count, start);
+        NDSize file_box(rank);
+        for (size_t i = 0; i < rank; i++) {
+            file_box[i] = start[i] + box_start[i];
+        }
+        fileSpace.hyperslab(box_count, file_box, H5S_SELECT_NOTB);
+        write(data, memType, memSpace, fileSpace);
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
 void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace) const
 {
     HErr res;
@@ -214,5 +772,61 @@ std::tuple<DataSpace, DataSpace> DataSet::offsetCount2DataSpaces(const NDSize &c
     return std::tuple<DataSpace, DataSpace>(memSpace, fileSpace);
 }
 
+
+std::tuple<DataSpace, DataSpace> DataSet::rows2DataSpaces(const std::vector<ndsize_t> &rows) const
+{
+    DataSpace fileSpace = getSpace();
+    NDSize extent = fileSpace.extent();
+
+    if (extent.size() == 0) {
+        throw InvalidRank("Cannot select rows of 0-dimensional data");
+    }
+
+    NDSize mem_extent(extent);
+    mem_extent[0] = rows.size();
+    DataSpace memSpace = DataSpace::create(mem_extent, false);
+
+    if (rows.empty()) {
+        fileSpace.selectNone();
+        return std::tuple<DataSpace, DataSpace>(memSpace, fileSpace);
+    }
+
+    // collect runs of consecutive rows as (start, length) pairs
+    std::vector<std::pair<ndsize_t, ndsize_t>> runs;
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (rows[i] >= extent[0] || (i > 0 && rows[i] <= rows[i - 1])) {
+            throw OutOfBounds("DataSet::rows2DataSpaces(): rows must be ascending and within the extent", i);
+        }
+        if (runs.size() && runs.back().first + runs.back().second == rows[i]) {
+            runs.back().second++;
+        } else {
+            runs.emplace_back(rows[i], 1);
+        }
+    }
+
+    ndsize_t row_elms = mem_extent.nelms() / rows.size();
+    bool sparse = runs.size() * 2 > rows.size();
+
+    if (sparse && row_elms == 1) {
+        std::vector<ndsize_t> coords(rows.size() * extent.size(), 0);
+        for (size_t i = 0; i < rows.size(); i++) {
+            coords[i * extent.size()] = rows[i];
+        }
+        fileSpace.elements(coords);
+    } else {
+        NDSize count(extent);
+        NDSize offset(extent.size(), 0);
+        H5S_seloper_t op = H5S_SELECT_SET;
+        for (const auto &run : runs) {
+            offset[0] = run.first;
+            count[0] = run.second;
+            fileSpace.hyperslab(count, offset, op);
+            op = H5S_SELECT_OR;
+        }
+    }
+
+    return std::tuple<DataSpace, DataSpace>(memSpace, fileSpace);
+}
+
 } // namespace hdf5
 } // namespace nix
@@ -17,7 +17,10 @@
 
 #include <nix/Platform.hpp>
 
+#include <boost/optional.hpp>
+
 #include <tuple>
+#include <vector>
 
 namespace nix {
 namespace hdf5 {
@@ -47,6 +50,26 @@ public:
 
     static NDSize guessChunking(NDSize dims, size_t element_size);
 
+    /**
+     * @brief Derive a chunk shape from the way the data is accessed.
+     *
+     * The chunks are long along the read axis and narrow across it, and the
+     * length along the append axis is chosen such that all chunks touched by
+     * appending along it fit into the chunk cache together. Like with
+     * guessChunking the size of a chunk is kept within the bounds returned by
+     * getChunkBounds, which takes precedence over the cache.
+     *
+     * @param dims          The initial shape of the data.
+     * @param element_size  The size of a single element in bytes.
+     * @param append_axis   The axis along which the data grows, if any.
+     * @param read_axis     The axis along which the data is read, if any.
+     * @param cache_size    The size of the chunk cache in bytes.
+     */
+    static NDSize adviseChunking(const NDSize &dims, size_t element_size,
+                                 boost::optional<size_t> append_axis,
+                                 boost::optional<size_t> read_axis,
+                                 size_t cache_size);
+
     /**
      * @brief returns the minimum and maximum chunk sizes
      *
@@ -56,6 +79,66 @@ public:
     void setExtent(const NDSize &dims);
     NDSize size() const;
 
+    /**
+     * @brief Re-read the metadata of the dataset (e.g. its extent) from the file.
+     *
+     * Needed by SWMR readers to see data appended by the writer.
+     */
+    void refresh();
+
+    /**
+     * @brief The chunk shape of the dataset, empty if the layout is not chunked.
+     */
+    NDSize chunkShape() const;
+
+    /**
+     * @brief Write a chunk as is, bypassing type conversion and the filter pipeline.
+     *
+     * @param offset       The offset of the chunk in elements, aligned to the chunk shape.
+     * @param data         The (already filtered) chunk data.
+     * @param size         The size of the data in bytes.
+     * @param filter_mask  Bit i set means filter i of the pipeline was skipped.
+     */
+    void writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask = 0);
+
+    /**
+     * @brief The number of bytes the chunk at offset occupies in the file, 0 if it
+     * was not written yet.
+     */
+    size_t chunkStorageSize(const NDSize &offset) const;
+
+    /**
+     * @brief Read a chunk as stored, i.e. without applying the filter pipeline.
+     *
+     * @param offset  The offset of the chunk in elements, aligned to the chunk shape.
+     * @param data    Buffer of at least chunkStorageSize(offset) bytes.
+     *
+     * @return The filter mask of the chunk.
+     */
+    uint32_t readChunk(const NDSize &offset, void *data) const;
+
+    /**
+     * @brief Write data by compressing whole chunks on a pool of threads.
+     *
+     * The whole chunks covered by the selection (a chunk cut by the extent of
+     * the dataset counts as whole) are shuffled and deflated on the threads of
+     * a shared worker pool and then written in order with direct chunk writes;
+     * the partial chunks around them are written through the filter pipeline.
+     * This is only possible if the filter pipeline consists of deflate,
+     * optionally preceded by shuffle, the memory type equals the file type,
+     * and the selection covers at least one whole chunk.
+     *
+     * @param data      The data to write.
+     * @param memType   The type of the data in memory.
+     * @param count     The size of the selection.
+     * @param offset    The offset of the selection.
+     * @param threads   The number of compression threads.
+     *
+     * @return False if the preconditions are not met and nothing was written.
+     */
+    bool writeChunksParallel(const void *data, const h5x::DataType &memType, const NDSize &count,
+                             const NDSize &offset, size_t threads);
+
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
     h5x::DataType dataType(void) const;
@@ -64,6 +147,17 @@ public:
 
     std::tuple<DataSpace, DataSpace> offsetCount2DataSpaces(const NDSize &count, const NDSize &offset={}) const;
 
+    /**
+     * @brief Create the memory and file space to read the given rows, i.e.
+     * slices along the first dimension, in one operation.
+     *
+     * Runs of consecutive rows are merged into a single hyperslab. If every row is
+     * a single element and most rows are isolated, a point selection is used instead.
+     *
+     * @param rows   The row indices, sorted in strictly ascending order.
+     */
+    std::tuple<DataSpace, DataSpace> rows2DataSpaces(const std::vector<ndsize_t> &rows) const;
+
     DataSet &operator=(const DataSet &other) {
         LocID::operator=(other);
         return *this;
@@ -64,6 +64,12 @@ public:
         }
     }
 
+    static void check(herr_t result, const char *msg_if_fail) {
+        if (result < 0) {
+            throw H5Error(result, msg_if_fail);
+        }
+    }
+
     herr_t code(void) {
         return error;
     }
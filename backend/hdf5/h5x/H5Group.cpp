@@ -10,6 +10,8 @@
 #include <nix/util/util.hpp>
 #include "H5Exception.hpp"
 #include "H5PList.hpp"
+#include "H5Stats.hpp"
+#include "H5Trace.hpp"
 
 namespace nix {
 namespace hdf5 {
@@ -18,7 +20,15 @@ optGroup::optGroup(const H5Group &parent, const std::string &g_name)
     : parent(parent), g_name(g_name)
 {}
 
+optGroup::optGroup(const std::function<H5Group()> &open_parent, const std::string &g_name)
+    : g_name(g_name), open_parent(open_parent)
+{}
+
 boost::optional<H5Group> optGroup::operator() (bool create) const {
+    if (open_parent) {
+        parent = open_parent();
+        open_parent = nullptr;
+    }
     if (parent.hasGroup(g_name)) {
         g = boost::optional<H5Group>(parent.openGroup(g_name));
     } else if (create) {
@@ -34,7 +44,7 @@ H5Group::H5Group() : LocID() {}
 H5Group::H5Group(hid_t hid) : LocID(hid) {}
 
 
-H5Group::H5Group(const H5Group &other) : LocID(other) {}
+H5Group::H5Group(const H5Group &other) : LocID(other), compact_layout(other.compact_layout) {}
 
 
 bool H5Group::hasObject(const std::string &name) const {
@@ -56,6 +66,10 @@ bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
         return false;
     }
 
+    if (IOCounters *counters = h5x::activeCounters()) {
+        counters->object_opens++;
+    }
+
     HErr err = H5Oget_info(obj, &info);
     err.check("Could not obtain object info");
 
@@ -187,10 +201,75 @@ void H5Group::removeData(const std::string &name) {
 }
 
 
+// ids of the HDF5 filter plugins as registered with The HDF Group
+static const H5Z_filter_t FILTER_LZ4 = 32004;
+static const H5Z_filter_t FILTER_BITSHUFFLE = 32008;
+static const H5Z_filter_t FILTER_ZSTD = 32015;
+
+static void setPluginFilter(hid_t dcpl, H5Z_filter_t filter, const std::string &filter_name,
+                            const std::vector<unsigned int> &values) {
+    if (H5Zfilter_avail(filter) <= 0) {
+        throw std::runtime_error("The " + filter_name + " filter plugin is not available to HDF5 (check HDF5_PLUGIN_PATH)!");
+    }
+    HErr res = H5Pset_filter(dcpl, filter, H5Z_FLAG_MANDATORY, values.size(), values.data());
+    res.check("Could not set " + filter_name + " filter!");
+}
+
+
+void H5Group::setCompression(hid_t dcpl, const CompressionOptions &compression) {
+    if (compression.isAuto()) {
+        return;
+    }
+
+    switch (compression.shuffle) {
+        case ShuffleFilter::None :
+            break;
+        case ShuffleFilter::Byte : {
+            HErr res = H5Pset_shuffle(dcpl);
+            res.check("Could not set shuffle filter!");
+            break;
+        }
+        case ShuffleFilter::Bit :
+            setPluginFilter(dcpl, FILTER_BITSHUFFLE, "bitshuffle", {});
+            break;
+        default :
+            throw std::invalid_argument("Invalid shuffle filter!");
+    }
+
+    int level = compression.level;
+    switch (compression.codec) {
+        case CompressionCodec::None :
+            break;
+        case CompressionCodec::Deflate : {
+            level = level < 0 ? 6 : level;
+            if (level > 9) {
+                throw std::invalid_argument("Deflate compression level must be between 0 and 9!");
+            }
+            HErr res = H5Pset_deflate(dcpl, static_cast<unsigned int>(level));
+            res.check("Could not set compression!");
+            break;
+        }
+        case CompressionCodec::LZ4 :
+            setPluginFilter(dcpl, FILTER_LZ4, "LZ4", {});
+            break;
+        case CompressionCodec::Zstd : {
+            level = level < 0 ? 3 : level;
+            if (level < 1 || level > 22) {
+                throw std::invalid_argument("Zstd compression level must be between 1 and 22!");
+            }
+            setPluginFilter(dcpl, FILTER_ZSTD, "Zstd", {static_cast<unsigned int>(level)});
+            break;
+        }
+        default :
+            throw std::invalid_argument("Invalid compression flag!");
+    }
+}
+
+
 DataSet H5Group::createData(const std::string &name,
                             const h5x::DataType &fileType,
                             const NDSize &size,
-                            const Compression &compression,
+                            const CompressionOptions &compression,
                             const NDSize &maxsize,
                             NDSize chunks,
                             bool max_size_unlimited,
@@ -219,20 +298,7 @@ DataSet H5Group::createData(const std::string &name,
         res.check("Could not set chunk size on data set creation plist");
     }
     DataSet ds;
-    switch (compression) {
-        case Compression::None :
-            break;
-        case Compression::Auto :
-            break;
-        case Compression::DeflateNormal : {
-            HErr status = H5Pset_deflate (dcpl.h5id(), 6);
-            status.check("Could not set compression!");
-            break;
-        }
-        default : {
-            throw std::invalid_argument("Invalid compression flag!");
-        }
-    }
+    setCompression(dcpl.h5id(), compression);
     ds = H5Dcreate(hid,
                    name.c_str(),
                    fileType.h5id(),
@@ -246,9 +312,27 @@ DataSet H5Group::createData(const std::string &name,
 }
 
 
+size_t H5Group::chunkCacheSize() const {
+    H5Object file = H5Iget_file_id(hid);
+    file.check("H5Group::chunkCacheSize(): Could not get the file");
+    H5Object fapl = H5Fget_access_plist(file.h5id());
+    fapl.check("H5Group::chunkCacheSize(): Could not get the file access property list");
+
+    int mdc_nelmts;
+    size_t rdcc_nslots, rdcc_nbytes;
+    double rdcc_w0;
+    HErr res = H5Pget_cache(fapl.h5id(), &mdc_nelmts, &rdcc_nslots, &rdcc_nbytes, &rdcc_w0);
+    res.check("H5Group::chunkCacheSize(): Could not get the chunk cache size");
+    return rdcc_nbytes;
+}
+
+
 DataSet H5Group::openData(const std::string &name) const {
     DataSet ds = H5Dopen(hid, name.c_str(), H5P_DEFAULT);
     ds.check("H5Group::openData(): Could not open DataSet");
+    if (IOCounters *counters = h5x::activeCounters()) {
+        counters->object_opens++;
+    }
     return ds;
 }
 
@@ -260,16 +344,41 @@ bool H5Group::hasGroup(const std::string &name) const {
 
 H5Group H5Group::openGroup(const std::string &name, bool create) const {
     check_h5_arg_name(name);
+    h5x::TraceSpan span("H5Group::openGroup", "hdf5", hid, name, '/');
 
     H5Group g;
 
     if (hasGroup(name)) {
         g = H5Group(H5Gopen(hid, name.c_str(), H5P_DEFAULT));
         g.check("H5Group::openGroup(): Could not open group: " + name);
+        if (IOCounters *counters = h5x::activeCounters()) {
+            counters->object_opens++;
+        }
     } else if (create) {
         H5Object gcpl = H5Pcreate(H5P_GROUP_CREATE);
         gcpl.check("Unable to create group with name '" + name + "'! (H5Pcreate)");
 
+        // groups of files with the compact layout inherit the link and attribute
+        // storage settings of their parent, cf. EntityLayout
+        if (compact_layout) {
+            const std::string msg = "Unable to create group with name '" + name + "'! ";
+            H5Object parent_gcpl = H5Gget_create_plist(hid);
+            parent_gcpl.check(msg + "(H5Gget_create_plist)");
+            unsigned max_compact, min_dense, est_num, est_len;
+            HErr res = H5Pget_link_phase_change(parent_gcpl.h5id(), &max_compact, &min_dense);
+            res.check(msg + "(H5Pget_link_phase_change)");
+            res = H5Pset_link_phase_change(gcpl.h5id(), max_compact, min_dense);
+            res.check(msg + "(H5Pset_link_phase_change)");
+            res = H5Pget_est_link_info(parent_gcpl.h5id(), &est_num, &est_len);
+            res.check(msg + "(H5Pget_est_link_info)");
+            res = H5Pset_est_link_info(gcpl.h5id(), est_num, est_len);
+            res.check(msg + "(H5Pset_est_link_info)");
+            res = H5Pget_attr_phase_change(parent_gcpl.h5id(), &max_compact, &min_dense);
+            res.check(msg + "(H5Pget_attr_phase_change)");
+            res = H5Pset_attr_phase_change(gcpl.h5id(), max_compact, min_dense);
+            res.check(msg + "(H5Pset_attr_phase_change)");
+        }
+
         //we want hdf5 to keep track of the order in which links were created so that
         //the order for indexed based accessors is stable cf. issue #387
         HErr res = H5Pset_link_creation_order(gcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
@@ -282,6 +391,7 @@ H5Group H5Group::openGroup(const std::string &name, bool create) const {
         throw H5Exception("Unable to open group with name '" + name + "'!");
     }
 
+    g.compact_layout = compact_layout;
     return g;
 }
 
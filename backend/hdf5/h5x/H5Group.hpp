@@ -18,6 +18,7 @@
 
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -48,11 +49,19 @@ public:
     bool hasData(const std::string &name) const;
 
     DataSet createData(const std::string &name, const h5x::DataType &fileType,
-                       const NDSize &size,  const Compression &compression = Compression::Auto,
+                       const NDSize &size,  const CompressionOptions &compression = Compression::Auto,
                        const NDSize &maxsize = {}, NDSize chunks = {},
                        bool maxSizeUnlimited = true, bool guessChunks = true) const;
 
     DataSet openData(const std::string &name) const;
+
+    static void setCompression(hid_t dcpl, const CompressionOptions &compression);
+
+    /**
+     * @brief The size in bytes of the raw data chunk cache configured
+     * for the file containing this group.
+     */
+    size_t chunkCacheSize() const;
     void removeData(const std::string &name);
 
     template<typename T>
@@ -159,8 +168,22 @@ public:
      */
     bool removeAllLinks(const std::string &name);
 
+    /**
+     * @brief Whether groups created below this group copy its link and
+     *        attribute storage settings, i.e. the file uses the compact
+     *        entity layout. Groups opened from this group inherit the flag.
+     */
+    bool compactLayout() const {
+        return compact_layout;
+    }
+
+    void compactLayout(bool compact) {
+        compact_layout = compact;
+    }
+
     H5Group &operator=(const H5Group &other) {
         H5Object::operator=(other);
+        compact_layout = other.compact_layout;
         return *this;
     }
 
@@ -169,6 +192,8 @@ public:
 
 private:
 
+    bool compact_layout = false;
+
     bool objectOfType(const std::string &name, H5O_type_t type) const;
 
 }; // group H5Group
@@ -250,12 +275,16 @@ bool H5Group::getData(const std::string &name, T &value) const
  */
 struct NIXAPI optGroup {
     mutable boost::optional<H5Group> g;
-    H5Group parent;
+    mutable H5Group parent;
     std::string g_name;
+    // opens the parent on first use, if it was not given
+    mutable std::function<H5Group()> open_parent;
 
 public:
     optGroup(const H5Group &parent, const std::string &g_name);
 
+    optGroup(const std::function<H5Group()> &open_parent, const std::string &g_name);
+
     optGroup(){};
 
     /**
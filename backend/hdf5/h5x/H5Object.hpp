@@ -14,6 +14,7 @@
 
 #include <nix/Platform.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/util/memory.hpp>
 #include "H5Exception.hpp"
 
 #include <string>
@@ -38,6 +39,7 @@ public:
 		size_t bs = nix::check::fits_in_size_t(nelms,
                          "Cannot allocate storage (exceeds memory)");
         buffer = new data_type[bs];
+        account.resize(bs * sizeof(data_type));
     }
 
     data_ptr operator*() {
@@ -58,6 +60,7 @@ private:
     ndsize_t nelms;
     pointer  data;
     data_ptr buffer;
+    util::TemporaryAllocation account;
 };
 
 class StringReader {
@@ -75,6 +78,7 @@ public:
 		size_t bs = nix::check::fits_in_size_t(nelms,
                          "Cannot allocate storage (exceeds memory)");
         buffer = new data_type[bs];
+        account.resize(bs * sizeof(data_type));
         for (ndsize_t i = 0; i < bs; i++) {
             buffer[i] = data[i].c_str();
         }
@@ -92,6 +96,7 @@ private:
     ndsize_t   nelms;
     pointer  data;
     data_ptr buffer;
+    util::TemporaryAllocation account;
 };
 
 
@@ -138,6 +143,13 @@ public:
         }
     }
 
+    // literals are only turned into strings if the check fails
+    void check(const char *msg_if_fail) {
+        if (type() == H5I_BADID) {
+            throw H5Exception(msg_if_fail);
+        }
+    }
+
     std::string name() const;
 
     H5I_type_t type() const;
@@ -181,6 +193,14 @@ struct NIXAPI HTri {
         return result();
     }
 
+    inline bool check(const char *msg) {
+        if (value < 0) {
+            throw H5Exception(msg);
+        }
+
+        return result();
+    }
+
     value_type value;
 };
 
@@ -206,6 +226,14 @@ struct NIXAPI HErr {
         return true;
     }
 
+    inline bool check(const char *msg) {
+        if (isError()) {
+            throw H5Error(value, msg);
+        }
+
+        return true;
+    }
+
     value_type value;
 };
 
@@ -0,0 +1,354 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5Repack.hpp"
+#include "H5DataSet.hpp"
+#include "H5Group.hpp"
+#include "H5PList.hpp"
+#include "H5Exception.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+bool has_vlen(hid_t type) {
+    return H5Tdetect_class(type, H5T_VLEN) > 0 || H5Tdetect_class(type, H5T_STRING) > 0;
+}
+
+
+// the data of DataArrays lives in <block>/data_arrays/<array>/data
+bool is_data_array_data(const std::string &path) {
+    const std::string suffix = "/data";
+    if (path.size() < suffix.size() || path.compare(path.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        return false;
+    }
+    std::string parent = path.substr(0, path.size() - suffix.size());
+    parent = parent.substr(0, parent.rfind('/'));
+    return parent.size() >= 12 && parent.compare(parent.size() - 12, 12, "/data_arrays") == 0;
+}
+
+
+/**
+ * The largest shape made of whole chunks that holds at most max_elements
+ * elements, grown along the last dimensions first; at least one chunk.
+ */
+NDSize copy_block_shape(const NDSize &extent, const NDSize &chunks, ndsize_t max_elements) {
+    const size_t rank = extent.size();
+    NDSize block(rank);
+    for (size_t i = 0; i < rank; i++) {
+        block[i] = std::min(chunks[i], extent[i]);
+    }
+
+    for (size_t i = rank; i > 0; i--) {
+        const size_t k = i - 1;
+        ndsize_t rest = block.nelms() / block[k];
+        ndsize_t nchunks = max_elements / rest / chunks[k];
+        if (nchunks > 1) {
+            block[k] = std::min(extent[k], nchunks * chunks[k]);
+        }
+    }
+    return block;
+}
+
+
+class Repacker {
+public:
+
+    Repacker(hid_t dst_file, const RepackOptions &options)
+        : dst_file(dst_file), options(options), lcpl(PList::linkUTF8()) { }
+
+
+    void copyGroup(hid_t src, hid_t dst, const std::string &path) {
+        H5G_info_t info;
+        HErr res = H5Gget_info(src, &info);
+        res.check("repackFile: Could not get group info of " + path);
+
+        H5Object gcpl = H5Gget_create_plist(src);
+        gcpl.check("repackFile: Could not get group creation plist of " + path);
+        unsigned crt_order_flags = 0;
+        res = H5Pget_link_creation_order(gcpl.h5id(), &crt_order_flags);
+        res.check("repackFile: Could not get link creation order of " + path);
+        const H5_index_t index = (crt_order_flags & H5P_CRT_ORDER_TRACKED) ? H5_INDEX_CRT_ORDER : H5_INDEX_NAME;
+
+        for (hsize_t i = 0; i < info.nlinks; i++) {
+            ssize_t len = H5Lget_name_by_idx(src, ".", index, H5_ITER_INC, i, nullptr, 0, H5P_DEFAULT);
+            if (len < 0) {
+                throw H5Exception("repackFile: Could not get link name in " + path);
+            }
+            std::vector<char> name(static_cast<size_t>(len) + 1, 0);
+            len = H5Lget_name_by_idx(src, ".", index, H5_ITER_INC, i, name.data(), name.size(), H5P_DEFAULT);
+            if (len < 0) {
+                throw H5Exception("repackFile: Could not get link name in " + path);
+            }
+            copyLink(src, dst, std::string(name.data()), path);
+        }
+    }
+
+
+    void copyAttributes(hid_t src, hid_t dst) {
+        H5O_info_t info;
+        HErr res = H5Oget_info(src, &info);
+        res.check("repackFile: Could not get object info");
+
+        for (hsize_t i = 0; i < info.num_attrs; i++) {
+            H5Object attr = H5Aopen_by_idx(src, ".", H5_INDEX_NAME, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT);
+            attr.check("repackFile: Could not open attribute");
+
+            ssize_t len = H5Aget_name(attr.h5id(), 0, nullptr);
+            if (len < 0) {
+                throw H5Exception("repackFile: Could not get attribute name");
+            }
+            std::vector<char> name(static_cast<size_t>(len) + 1, 0);
+            H5Aget_name(attr.h5id(), name.size(), name.data());
+
+            H5Object ftype = H5Aget_type(attr.h5id());
+            ftype.check("repackFile: Could not get attribute type");
+            H5Object mtype = H5Tget_native_type(ftype.h5id(), H5T_DIR_DEFAULT);
+            mtype.check("repackFile: Could not get native attribute type");
+            H5Object space = H5Aget_space(attr.h5id());
+            space.check("repackFile: Could not get attribute space");
+            H5Object acpl = H5Aget_create_plist(attr.h5id());
+            acpl.check("repackFile: Could not get attribute creation plist");
+
+            H5Object copy = H5Acreate2(dst, name.data(), ftype.h5id(), space.h5id(), acpl.h5id(), H5P_DEFAULT);
+            copy.check("repackFile: Could not create attribute " + std::string(name.data()));
+
+            hssize_t npoints = H5Sget_simple_extent_npoints(space.h5id());
+            if (npoints <= 0) {
+                continue;
+            }
+
+            std::vector<char> buf(static_cast<size_t>(npoints) * H5Tget_size(mtype.h5id()));
+            res = H5Aread(attr.h5id(), mtype.h5id(), buf.data());
+            res.check("repackFile: Could not read attribute " + std::string(name.data()));
+            res = H5Awrite(copy.h5id(), mtype.h5id(), buf.data());
+            if (has_vlen(mtype.h5id())) {
+                H5Dvlen_reclaim(mtype.h5id(), space.h5id(), H5P_DEFAULT, buf.data());
+            }
+            res.check("repackFile: Could not write attribute " + std::string(name.data()));
+        }
+    }
+
+
+private:
+
+    void copyLink(hid_t src, hid_t dst, const std::string &name, const std::string &path) {
+        const std::string child = (path == "/" ? path : path + "/") + name;
+
+        H5L_info_t linfo;
+        HErr res = H5Lget_info(src, name.c_str(), &linfo, H5P_DEFAULT);
+        res.check("repackFile: Could not get link info of " + child);
+
+        if (linfo.type == H5L_TYPE_SOFT || linfo.type == H5L_TYPE_EXTERNAL) {
+            std::vector<char> value(linfo.u.val_size);
+            res = H5Lget_val(src, name.c_str(), value.data(), value.size(), H5P_DEFAULT);
+            res.check("repackFile: Could not get link value of " + child);
+
+            if (linfo.type == H5L_TYPE_SOFT) {
+                res = H5Lcreate_soft(value.data(), dst, name.c_str(), lcpl.h5id(), H5P_DEFAULT);
+            } else {
+                unsigned flags;
+                const char *file_name, *obj_name;
+                res = H5Lunpack_elink_val(value.data(), value.size(), &flags, &file_name, &obj_name);
+                res.check("repackFile: Could not unpack external link " + child);
+                res = H5Lcreate_external(file_name, obj_name, dst, name.c_str(), lcpl.h5id(), H5P_DEFAULT);
+            }
+            res.check("repackFile: Could not create link " + child);
+            return;
+        } else if (linfo.type != H5L_TYPE_HARD) {
+            throw H5Exception("repackFile: Unsupported link type of " + child);
+        }
+
+        H5O_info_t oinfo;
+        res = H5Oget_info_by_name(src, name.c_str(), &oinfo, H5P_DEFAULT);
+        res.check("repackFile: Could not get object info of " + child);
+
+        // objects reachable via several hard links are copied only once
+        auto it = copied.find(oinfo.addr);
+        if (it != copied.end()) {
+            res = H5Lcreate_hard(dst_file, it->second.c_str(), dst, name.c_str(), lcpl.h5id(), H5P_DEFAULT);
+            res.check("repackFile: Could not create link " + child);
+            return;
+        }
+        copied[oinfo.addr] = child;
+
+        if (oinfo.type == H5O_TYPE_GROUP) {
+            H5Object group = H5Gopen2(src, name.c_str(), H5P_DEFAULT);
+            group.check("repackFile: Could not open group " + child);
+            H5Object gcpl = H5Gget_create_plist(group.h5id());
+            gcpl.check("repackFile: Could not get group creation plist of " + child);
+            H5Object copy = H5Gcreate2(dst, name.c_str(), lcpl.h5id(), gcpl.h5id(), H5P_DEFAULT);
+            copy.check("repackFile: Could not create group " + child);
+
+            copyAttributes(group.h5id(), copy.h5id());
+            copyGroup(group.h5id(), copy.h5id(), child);
+        } else if (oinfo.type == H5O_TYPE_DATASET && is_data_array_data(child) &&
+                   (!options.compression.isAuto() || !options.chunking.isAuto())) {
+            copyData(src, dst, name, child);
+        } else {
+            res = H5Ocopy(src, name.c_str(), dst, name.c_str(), H5P_DEFAULT, lcpl.h5id());
+            res.check("repackFile: Could not copy object " + child);
+        }
+    }
+
+
+    NDSize chunkShape(const DataSet &ds, const NDSize &extent, size_t element_size) const {
+        const size_t rank = extent.size();
+        const ChunkingOptions &chunking = options.chunking;
+        NDSize chunks = ds.chunkShape();
+
+        if (chunking.shape) {
+            if (chunking.shape.size() == rank) {
+                chunks = chunking.shape;
+            }
+        } else if (!chunking.isAuto() &&
+                   (!chunking.append_axis || *chunking.append_axis < rank) &&
+                   (!chunking.read_axis || *chunking.read_axis < rank)) {
+            H5Group root(H5Gopen2(dst_file, "/", H5P_DEFAULT));
+            chunks = DataSet::adviseChunking(extent, element_size, chunking.append_axis, chunking.read_axis,
+                                             root.chunkCacheSize());
+        }
+
+        if (!chunks) {
+            chunks = DataSet::guessChunking(extent, element_size);
+        }
+        return chunks;
+    }
+
+
+    // re-chunk and/or re-compress, copying at most options.buffer_size bytes at a time
+    void copyData(hid_t src, hid_t dst, const std::string &name, const std::string &path) {
+        DataSet ds = H5Dopen2(src, name.c_str(), H5P_DEFAULT);
+        ds.check("repackFile: Could not open data set " + path);
+
+        DataSpace space = ds.getSpace();
+        const size_t rank = space.extent().size();
+        if (rank == 0) {
+            HErr res = H5Ocopy(src, name.c_str(), dst, name.c_str(), H5P_DEFAULT, lcpl.h5id());
+            res.check("repackFile: Could not copy object " + path);
+            return;
+        }
+
+        NDSize extent(rank), maxdims(rank);
+        HErr res = H5Sget_simple_extent_dims(space.h5id(), extent.data(), maxdims.data());
+        res.check("repackFile: Could not get the extent of " + path);
+
+        h5x::DataType ftype = ds.dataType();
+        NDSize chunks = chunkShape(ds, extent, ftype.size());
+        for (size_t i = 0; i < rank; i++) {
+            if (maxdims[i] != H5S_UNLIMITED) {
+                chunks[i] = std::max<ndsize_t>(1, std::min(chunks[i], maxdims[i]));
+            }
+        }
+
+        H5Object src_dcpl = H5Dget_create_plist(ds.h5id());
+        src_dcpl.check("repackFile: Could not get data set creation plist of " + path);
+        H5Object dcpl = H5Pcopy(src_dcpl.h5id());
+        dcpl.check("repackFile: Could not copy data set creation plist of " + path);
+        res = H5Pset_chunk(dcpl.h5id(), static_cast<int>(rank), chunks.data());
+        res.check("repackFile: Could not set chunk shape of " + path);
+        if (!options.compression.isAuto()) {
+            if (H5Pget_nfilters(dcpl.h5id()) > 0) {
+                res = H5Premove_filter(dcpl.h5id(), H5Z_FILTER_ALL);
+                res.check("repackFile: Could not remove filters of " + path);
+            }
+            H5Group::setCompression(dcpl.h5id(), options.compression);
+        }
+
+        DataSet copy = H5Dcreate2(dst, name.c_str(), ftype.h5id(), space.h5id(), lcpl.h5id(),
+                                  dcpl.h5id(), H5P_DEFAULT);
+        copy.check("repackFile: Could not create data set " + path);
+        copyAttributes(ds.h5id(), copy.h5id());
+
+        if (extent.nelms() == 0) {
+            return;
+        }
+
+        h5x::DataType mtype = H5Tget_native_type(ftype.h5id(), H5T_DIR_DEFAULT);
+        mtype.check("repackFile: Could not get native type of " + path);
+        const size_t msize = mtype.size();
+        const bool vlen = has_vlen(mtype.h5id());
+
+        NDSize block = copy_block_shape(extent, chunks, std::max<size_t>(1, options.buffer_size / msize));
+        std::vector<char> buf(static_cast<size_t>(block.nelms()) * msize);
+
+        NDSize offset(rank, 0), count(rank);
+        for (;;) {
+            for (size_t i = 0; i < rank; i++) {
+                count[i] = std::min(block[i], extent[i] - offset[i]);
+            }
+
+            ds.read(buf.data(), mtype, count, offset);
+            copy.write(buf.data(), mtype, count, offset);
+            if (vlen) {
+                DataSpace mspace = DataSpace::create(count, false);
+                ds.vlenReclaim(mtype, buf.data(), &mspace);
+            }
+
+            size_t k = rank;
+            while (k > 0) {
+                offset[k - 1] += block[k - 1];
+                if (offset[k - 1] < extent[k - 1]) {
+                    break;
+                }
+                offset[k - 1] = 0;
+                k--;
+            }
+            if (k == 0) {
+                break;
+            }
+        }
+    }
+
+    hid_t dst_file;
+    const RepackOptions &options;
+    PList lcpl;
+    std::map<haddr_t, std::string> copied;
+};
+
+} // anonymous namespace
+
+
+void repackFile(hid_t src, const std::string &target, const RepackOptions &options) {
+    H5Object fcpl = H5Fget_create_plist(src);
+    fcpl.check("repackFile: Could not get file creation plist");
+
+    H5Object src_fapl = H5Fget_access_plist(src);
+    src_fapl.check("repackFile: Could not get file access plist");
+    H5F_libver_t low, high;
+    HErr res = H5Pget_libver_bounds(src_fapl.h5id(), &low, &high);
+    res.check("repackFile: Could not get library version bounds");
+
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("repackFile: Could not create file access plist");
+    res = H5Pset_libver_bounds(fapl.h5id(), low, high);
+    res.check("repackFile: Could not set library version bounds");
+
+    H5Object dst = H5Fcreate(target.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), fapl.h5id());
+    dst.check("repackFile: Could not create " + target);
+
+    H5Object src_root = H5Gopen2(src, "/", H5P_DEFAULT);
+    src_root.check("repackFile: Could not open root group");
+    H5Object dst_root = H5Gopen2(dst.h5id(), "/", H5P_DEFAULT);
+    dst_root.check("repackFile: Could not open root group of " + target);
+
+    Repacker repacker(dst.h5id(), options);
+    repacker.copyAttributes(src_root.h5id(), dst_root.h5id());
+    repacker.copyGroup(src_root.h5id(), dst_root.h5id(), "/");
+
+    res = H5Fflush(dst.h5id(), H5F_SCOPE_LOCAL);
+    res.check("repackFile: Could not flush " + target);
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,41 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REPACK_HDF5_H
+#define NIX_REPACK_HDF5_H
+
+#include <nix/Platform.hpp>
+#include <nix/Repack.hpp>
+
+#include <hdf5.h>
+
+#include <string>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Copy everything reachable from the root group of a file into a new file.
+ *
+ * Groups are recreated with their creation properties, links are recreated in
+ * creation order and objects reachable via several hard links are copied once,
+ * so the new file has the same object graph without the space left behind by
+ * deleted objects. Datasets are copied with H5Ocopy, i.e. chunk by chunk and
+ * without decoding them, unless the options require the data of DataArrays
+ * to be re-chunked or re-compressed.
+ *
+ * @param src      The file to copy.
+ * @param target   The path of the new file, which is overwritten.
+ * @param options  Options for re-encoding the data of DataArrays.
+ */
+NIXAPI void repackFile(hid_t src, const std::string &target, const RepackOptions &options);
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_REPACK_HDF5_H
@@ -0,0 +1,28 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5Stats.hpp"
+
+namespace nix {
+namespace hdf5 {
+namespace h5x {
+
+
+IOCounters *&activeCounters() {
+    static thread_local IOCounters *counters = nullptr;
+    return counters;
+}
+
+
+bool isConversion(hid_t mem_type, hid_t file_type) {
+    return H5Tequal(mem_type, file_type) <= 0;
+}
+
+} // namespace h5x
+} // namespace hdf5
+} // namespace nix
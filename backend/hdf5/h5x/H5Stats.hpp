@@ -0,0 +1,36 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_H5_STATS_H
+#define NIX_H5_STATS_H
+
+#include <nix/Statistics.hpp>
+#include <nix/Platform.hpp>
+#include "H5Exception.hpp"
+
+namespace nix {
+namespace hdf5 {
+namespace h5x {
+
+/**
+ * The counters of the API call the current thread is executing, or nullptr
+ * if no statistics are collected for it; cf. CallScope.
+ */
+NIXAPI IOCounters *&activeCounters();
+
+
+/**
+ * Whether transferring data between the two types converts it.
+ */
+bool isConversion(hid_t mem_type, hid_t file_type);
+
+} // namespace h5x
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_H5_STATS_H
@@ -0,0 +1,80 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5Trace.hpp"
+
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+namespace h5x {
+
+namespace {
+
+std::string object_path(hid_t obj) {
+    if (H5Iget_type(obj) == H5I_FILE) {
+        return "/";
+    }
+
+    ssize_t size = H5Iget_name(obj, nullptr, 0);
+    if (size <= 0) {
+        return std::string();
+    }
+
+    std::vector<char> buf(static_cast<size_t>(size) + 1, 0);
+    H5Iget_name(obj, buf.data(), buf.size());
+    return std::string(buf.data());
+}
+
+} // anonymous namespace
+
+
+TraceSpan::TraceSpan(const char *name, const char *category, hid_t obj)
+    : sink(traceSink())
+{
+    if (sink) {
+        event.entity = object_path(obj);
+        begin(name, category);
+    }
+}
+
+
+TraceSpan::TraceSpan(const char *name, const char *category, hid_t obj, const std::string &child, char sep)
+    : sink(traceSink())
+{
+    if (sink) {
+        event.entity = object_path(obj);
+        if (sep == '/' && !event.entity.empty() && event.entity.back() == '/') {
+            event.entity += child;
+        } else {
+            event.entity += sep + child;
+        }
+        begin(name, category);
+    }
+}
+
+
+void TraceSpan::begin(const char *name, const char *category) {
+    event.name = name;
+    event.category = category;
+    event.start = std::chrono::steady_clock::now();
+    sink->begin(event);
+}
+
+
+TraceSpan::~TraceSpan() {
+    if (sink) {
+        std::chrono::duration<double> d = std::chrono::steady_clock::now() - event.start;
+        event.duration = d.count();
+        sink->end(event);
+    }
+}
+
+} // namespace h5x
+} // namespace hdf5
+} // namespace nix
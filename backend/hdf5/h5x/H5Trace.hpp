@@ -0,0 +1,72 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_H5_TRACE_H
+#define NIX_H5_TRACE_H
+
+#include <nix/Trace.hpp>
+#include <nix/Platform.hpp>
+#include "H5Exception.hpp"
+
+#include <memory>
+#include <string>
+
+namespace nix {
+namespace hdf5 {
+namespace h5x {
+
+/**
+ * Reports an operation on an HDF5 object to the installed trace sink, if any:
+ * begins it when constructed and ends it when destroyed.
+ */
+class NIXAPI TraceSpan {
+
+public:
+
+    TraceSpan(const char *name, const char *category, hid_t obj);
+
+
+    /**
+     * An operation on the child of obj with the given name; sep is '/' for
+     * links and '@' for attributes.
+     */
+    TraceSpan(const char *name, const char *category, hid_t obj, const std::string &child, char sep);
+
+
+    TraceSpan(const TraceSpan &other) = delete;
+
+
+    TraceSpan &operator=(const TraceSpan &other) = delete;
+
+
+    bool active() const {
+        return static_cast<bool>(sink);
+    }
+
+
+    void bytes(uint64_t n) {
+        event.bytes = n;
+    }
+
+
+    ~TraceSpan();
+
+private:
+
+    void begin(const char *name, const char *category);
+
+
+    std::shared_ptr<TraceSink> sink;
+    TraceEvent event;
+};
+
+} // namespace h5x
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_H5_TRACE_H
@@ -11,6 +11,8 @@
 #include "LocID.hpp"
 #include "H5PList.hpp"
 
+#include <algorithm>
+
 namespace nix {
 
 namespace hdf5 {
@@ -63,6 +65,22 @@ Attribute LocID::createAttr(const std::string &name, h5x::DataType fileType, con
 }
 
 
+void LocID::setFixedStringAttr(const std::string &name, const std::string &value) const {
+    if (hasAttr(name)) {
+        setAttr(name, value);
+        return;
+    }
+
+    h5x::TraceSpan span("LocID::setAttr", "hdf5", hid, name, '@');
+    h5x::DataType fileType = h5x::DataType::makeStrType(std::max<size_t>(1, value.size()));
+    HErr res = H5Tset_strpad(fileType.h5id(), H5T_STR_NULLPAD);
+    res.check("LocID::setFixedStringAttr(): Could not set string padding");
+    DataSpace fileSpace = DataSpace::create(NDSize{}, false);
+    Attribute attr = createAttr(name, fileType, fileSpace);
+    attr.write(fileType, NDSize{}, &value);
+}
+
+
 void LocID::deleteLink(std::string name, hid_t plist) {
     HErr res = H5Ldelete(hid, name.c_str(), plist);
     res.check("LocIDL::deleteLink: Could not delete link: " + name);
@@ -15,6 +15,7 @@
 #include "Attribute.hpp"
 #include <nix/Hydra.hpp>
 #include "H5DataType.hpp"
+#include "H5Trace.hpp"
 
 namespace nix {
 namespace hdf5 {
@@ -40,6 +41,9 @@ public:
     template <typename T>
     bool getAttr(const std::string &name, T &value) const;
 
+    // store a new string attribute with a fixed-size string type of the length of value
+    void setFixedStringAttr(const std::string &name, const std::string &value) const;
+
     void deleteLink(std::string name, hid_t plist = H5L_SAME_LOC);
 
     unsigned int referenceCount() const;
@@ -58,6 +62,7 @@ public:
 
 template<typename T> void LocID::setAttr(const std::string &name, const T &value) const
 {
+    h5x::TraceSpan span("LocID::setAttr", "hdf5", hid, name, '@');
     typedef Hydra<const T> hydra_t;
 
     const hydra_t hydra(value);
@@ -81,6 +86,7 @@ template<typename T> void LocID::setAttr(const std::string &name, const T &value
 
 template<typename T> bool LocID::getAttr(const std::string &name, T &value) const
 {
+    h5x::TraceSpan span("LocID::getAttr", "hdf5", hid, name, '@');
     if (!hasAttr(name)) {
         return false;
     }
@@ -0,0 +1,107 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "WorkerPool.hpp"
+
+namespace nix {
+namespace hdf5 {
+namespace h5x {
+
+
+WorkerPool &WorkerPool::shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+
+void WorkerPool::run(size_t n, const std::function<void()> &job, const std::function<void()> &local) {
+    Batch batch;
+    batch.job = &job;
+    batch.pending = n;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (threads.size() < n) {
+            threads.emplace_back(&WorkerPool::work, this);
+        }
+        for (size_t i = 0; i < n; i++) {
+            queue.push_back(&batch);
+        }
+    }
+    cond.notify_all();
+
+    std::exception_ptr error;
+    try {
+        local();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // job refers to the state of the caller, so wait even if local failed
+    std::unique_lock<std::mutex> lock(mutex);
+    batch.done.wait(lock, [&batch] { return batch.pending == 0; });
+    if (!error) {
+        error = batch.error;
+    }
+    lock.unlock();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+size_t WorkerPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return threads.size();
+}
+
+
+void WorkerPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        cond.wait(lock, [this] { return stop || !queue.empty(); });
+        if (stop) {
+            return;
+        }
+        Batch *batch = queue.front();
+        queue.pop_front();
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            (*batch->job)();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (error && !batch->error) {
+            batch->error = error;
+        }
+        if (--batch->pending == 0) {
+            batch->done.notify_all();
+        }
+    }
+}
+
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    for (std::thread &t : threads) {
+        t.join();
+    }
+}
+
+} // namespace h5x
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,81 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_WORKER_POOL_H
+#define NIX_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+namespace h5x {
+
+/**
+ * Threads that are started once and reused by every parallel write, instead
+ * of starting and joining threads per call. The pool grows to the largest
+ * number of threads requested so far.
+ */
+class WorkerPool {
+
+public:
+
+    WorkerPool() = default;
+
+    WorkerPool(const WorkerPool &other) = delete;
+
+    WorkerPool &operator=(const WorkerPool &other) = delete;
+
+    /**
+     * The pool shared by all writers of the process.
+     */
+    static WorkerPool &shared();
+
+    /**
+     * Run job on n threads of the pool while the calling thread runs local,
+     * and wait until all of them returned. The first exception thrown by
+     * job or local is rethrown.
+     */
+    void run(size_t n, const std::function<void()> &job, const std::function<void()> &local);
+
+    /**
+     * The number of threads of the pool.
+     */
+    size_t size() const;
+
+    ~WorkerPool();
+
+private:
+
+    struct Batch {
+        const std::function<void()> *job;
+        size_t pending;
+        std::exception_ptr error;
+        std::condition_variable done;
+    };
+
+    void work();
+
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Batch *> queue;
+    std::vector<std::thread> threads;
+    bool stop = false;
+};
+
+} // namespace h5x
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_WORKER_POOL_H
@@ -0,0 +1,120 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace po = boost::program_options;
+
+static nix::NDSize parse_shape(const std::string &str) {
+    std::vector<nix::ndsize_t> dims;
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        dims.push_back(std::stoull(item));
+    }
+    nix::NDSize shape(dims.size());
+    for (size_t i = 0; i < dims.size(); i++) {
+        shape[i] = dims[i];
+    }
+    return shape;
+}
+
+
+static nix::CompressionOptions parse_compression(const std::string &codec, int level, bool shuffle) {
+    nix::ShuffleFilter sf = shuffle ? nix::ShuffleFilter::Byte : nix::ShuffleFilter::None;
+    if (codec == "keep") {
+        return nix::Compression::Auto;
+    } else if (codec == "none") {
+        return nix::Compression::None;
+    } else if (codec == "deflate") {
+        return nix::CompressionOptions(nix::CompressionCodec::Deflate, level, sf);
+    } else if (codec == "lz4") {
+        return nix::CompressionOptions(nix::CompressionCodec::LZ4, level, sf);
+    } else if (codec == "zstd") {
+        return nix::CompressionOptions(nix::CompressionCodec::Zstd, level, sf);
+    }
+    throw std::invalid_argument("Unknown compression codec: " + codec);
+}
+
+
+int main(int argc, char **argv) {
+    std::string source, target, codec, chunks;
+    int level;
+    size_t buffer_mb;
+
+    po::options_description desc("Usage: nix-repack [options] SOURCE TARGET\n\n"
+                                 "Copy a NIX file into a new file, reclaiming the space of deleted entities.\n\n"
+                                 "Options");
+    desc.add_options()
+        ("help,h", "print this help")
+        ("compression,c", po::value<std::string>(&codec)->default_value("keep"),
+         "compression of DataArray data: keep, none, deflate, lz4 or zstd")
+        ("level,l", po::value<int>(&level)->default_value(-1), "compression level, -1 for the codec default")
+        ("shuffle,s", "apply the byte shuffle filter before compressing")
+        ("chunks", po::value<std::string>(&chunks), "chunk shape of DataArray data, e.g. 4096,16")
+        ("append-axis", po::value<size_t>(), "derive chunks for data growing along this axis")
+        ("read-axis", po::value<size_t>(), "derive chunks for data read along this axis")
+        ("buffer", po::value<size_t>(&buffer_mb)->default_value(64), "memory used for re-encoding, in MiB");
+
+    po::options_description hidden;
+    hidden.add_options()
+        ("source", po::value<std::string>(&source))
+        ("target", po::value<std::string>(&target));
+
+    po::options_description all;
+    all.add(desc).add(hidden);
+    po::positional_options_description pos;
+    pos.add("source", 1).add("target", 1);
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv).options(all).positional(pos).run(), vm);
+        po::notify(vm);
+    } catch (const po::error &e) {
+        std::cerr << e.what() << std::endl << desc << std::endl;
+        return 2;
+    }
+
+    if (vm.count("help") || source.empty() || target.empty()) {
+        std::cout << desc << std::endl;
+        return vm.count("help") ? 0 : 2;
+    }
+
+    try {
+        nix::RepackOptions options;
+        options.compression = parse_compression(codec, level, vm.count("shuffle") > 0);
+        options.buffer_size = buffer_mb * 1024 * 1024;
+        if (!chunks.empty()) {
+            options.chunking = nix::ChunkingOptions(parse_shape(chunks));
+        } else if (vm.count("append-axis") || vm.count("read-axis")) {
+            boost::optional<size_t> append_axis, read_axis;
+            if (vm.count("append-axis")) {
+                append_axis = vm["append-axis"].as<size_t>();
+            }
+            if (vm.count("read-axis")) {
+                read_axis = vm["read-axis"].as<size_t>();
+            }
+            options.chunking = nix::ChunkingOptions::accessPattern(append_axis, read_axis);
+        }
+
+        nix::File file = nix::File::open(source, nix::FileMode::ReadOnly);
+        file.repack(target, options);
+        file.close();
+    } catch (const std::exception &e) {
+        std::cerr << "nix-repack: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -24,3 +24,8 @@
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
 #include <nix/Compression.hpp>
+#include <nix/Chunking.hpp>
+#include <nix/Repack.hpp>
+#include <nix/FileOptions.hpp>
+#include <nix/Statistics.hpp>
+#include <nix/Trace.hpp>
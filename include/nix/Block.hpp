@@ -351,7 +351,10 @@ public:
     * @param type         The type of the data array.
     * @param data_type    A nix::DataType indicating the format to store values.
     * @param shape        A NDSize holding the extent of the array to create.
-    * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param compression  The dataset compression, a nix::Compression mode or nix::CompressionOptions,
+    *                     default nix::Compression::Auto.
+    * @param chunking     The chunk shape or an access pattern to derive it from, by default
+    *                     the chunk shape is guessed from the shape.
     *
     * @return The newly created data array.
     */
@@ -359,7 +362,8 @@ public:
                               const std::string &type,
                               nix::DataType      data_type,
                               const NDSize      &shape,
-                              const Compression &compression=Compression::Auto);
+                              const CompressionOptions &compression=Compression::Auto,
+                              const ChunkingOptions &chunking=ChunkingOptions());
 
     /**
     * @brief Create a new data array associated with this block.
@@ -368,7 +372,10 @@ public:
     * @param type      The type of the data array.
     * @param data      Data to create array with.
     * @param data_type A optional nix::DataType indicating the format to store values.
-    * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param compression  The dataset compression, a nix::Compression mode or nix::CompressionOptions,
+    *                     default nix::Compression::Auto.
+    * @param chunking     The chunk shape or an access pattern to derive it from, by default
+    *                     the chunk shape is guessed from the shape of the data.
     *
     * Create a data array with shape and type inferred from data. After
     * successful creation, the contents of data will be written to the
@@ -382,7 +389,8 @@ public:
                               const std::string &type,
                               const T &data,
                               DataType data_type=DataType::Nothing,
-                              const Compression &compression=Compression::Auto) {
+                              const CompressionOptions &compression=Compression::Auto,
+                              const ChunkingOptions &chunking=ChunkingOptions()) {
          const Hydra<const T> hydra(data);
 
          if (data_type == DataType::Nothing) {
@@ -390,7 +398,7 @@ public:
          }
 
          const NDSize shape = hydra.shape();
-         DataArray da = createDataArray(name, type, data_type, shape, compression);
+         DataArray da = createDataArray(name, type, data_type, shape, compression, chunking);
 
          const NDSize offset(shape.size(), 0);
          da.setData(data, offset);
@@ -439,14 +447,15 @@ public:
      * @param name         The name of the data frame to create.
      * @param type         The type of the data frame.
      * @param cols         A vector of nix::Column representing the columns to create.
-     * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+     * @param compression  The dataset compression, a nix::Compression mode or nix::CompressionOptions,
+     *                     default nix::Compression::Auto.
      *
      * @return The newly created data frame.
      */
     DataFrame createDataFrame(const std::string &name,
                               const std::string &type,
                               const std::vector<Column> &cols,
-                              const Compression &compression=Compression::Auto) {
+                              const CompressionOptions &compression=Compression::Auto) {
         std::set<std::string> names;
         for (const Column &c : cols) {
             if (!Variant::supports_type(c.dtype)) {
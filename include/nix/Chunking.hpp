@@ -0,0 +1,73 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+#ifndef NIX_CHUNKING_H
+#define NIX_CHUNKING_H
+
+#include <nix/NDSize.hpp>
+
+#include <boost/optional.hpp>
+
+namespace nix {
+
+/**
+ * @brief Describes how the data of a DataArray is split into chunks.
+ *
+ * By default the chunk shape is guessed from the initial shape and the element
+ * size. Alternatively an explicit chunk shape can be given, or hints about how
+ * the data is accessed, from which a chunk shape is derived that fits the
+ * chunk cache of the file.
+ *
+ * ~~~
+ * // samples x channels, appended along time, read channel by channel
+ * block.createDataArray("signal", "nix.sampled", DataType::Int16, {0, 384}, Compression::None,
+ *                       ChunkingOptions::accessPattern(0, 0));
+ * ~~~
+ */
+struct ChunkingOptions {
+
+    /**
+     * @brief Automatic chunking, guessed from the shape of the data.
+     */
+    ChunkingOptions() {}
+
+    /**
+     * @brief Chunking with an explicit chunk shape.
+     *
+     * @param shape  The chunk shape, must have the rank of the data.
+     */
+    ChunkingOptions(const NDSize &shape) : shape(shape) {}
+
+    /**
+     * @brief Chunking derived from the access pattern.
+     *
+     * @param append_axis  The axis along which the data grows, i.e. the dimension
+     *                     that is extended for each write.
+     * @param read_axis    The axis along which the data is read, e.g. the time axis
+     *                     if single channels are read as time series.
+     */
+    static ChunkingOptions accessPattern(boost::optional<size_t> append_axis,
+                                         boost::optional<size_t> read_axis = boost::none) {
+        ChunkingOptions opts;
+        opts.append_axis = append_axis;
+        opts.read_axis = read_axis;
+        return opts;
+    }
+
+    /**
+     * @brief Whether the chunk shape is left to the default guess.
+     */
+    bool isAuto() const { return !shape && !append_axis && !read_axis; }
+
+    NDSize                  shape;
+    boost::optional<size_t> append_axis;
+    boost::optional<size_t> read_axis;
+};
+
+}
+
+#endif // NIX_CHUNKING_H
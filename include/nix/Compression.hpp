@@ -18,6 +18,81 @@ enum class Compression {
     DeflateNormal,
     Auto
 };
+
+/**
+ * @brief Compression codecs that can be selected with {@link CompressionOptions}.
+ *
+ * Deflate is built into HDF5. LZ4 and Zstd are applied as HDF5 filter plugins
+ * (registered filter ids 32004 and 32015) and require the respective plugin to
+ * be available to the HDF5 library, e.g. via the HDF5_PLUGIN_PATH environment
+ * variable.
+ */
+enum class CompressionCodec {
+    None = 0,
+    Deflate,
+    LZ4,
+    Zstd
+};
+
+/**
+ * @brief Shuffle pre-filters applied before the compression codec.
+ *
+ * Byte shuffle is built into HDF5, bit shuffle is applied as HDF5 filter
+ * plugin (registered filter id 32008).
+ */
+enum class ShuffleFilter {
+    None = 0,
+    Byte,
+    Bit
+};
+
+/**
+ * @brief Describes the compression of a dataset.
+ *
+ * Can be implicitly constructed from a {@link Compression} mode, so that it can
+ * be used wherever the plain mode was accepted before.
+ *
+ * ~~~
+ * // Zstd at level 5 with byte shuffling
+ * block.createDataArray("signal", "nix.sampled", DataType::Int16, {0, 384},
+ *                       CompressionOptions(CompressionCodec::Zstd, 5, ShuffleFilter::Byte));
+ * ~~~
+ */
+struct CompressionOptions {
+
+    /**
+     * @brief Options equivalent to the given compression mode.
+     *
+     * Compression::Auto means that the file's default compression is used.
+     */
+    CompressionOptions(Compression mode = Compression::Auto)
+        : codec(mode == Compression::DeflateNormal ? CompressionCodec::Deflate : CompressionCodec::None),
+          level(-1), shuffle(ShuffleFilter::None), automatic(mode == Compression::Auto) {}
+
+    /**
+     * @brief Options for the given codec.
+     *
+     * @param codec     The compression codec.
+     * @param level     The compression level, -1 selects the codec's default
+     *                  (6 for Deflate, 3 for Zstd). Ignored for LZ4.
+     * @param shuffle   The shuffle pre-filter.
+     */
+    CompressionOptions(CompressionCodec codec, int level = -1, ShuffleFilter shuffle = ShuffleFilter::None)
+        : codec(codec), level(level), shuffle(shuffle), automatic(false) {}
+
+    /**
+     * @brief Whether the options defer to the file's default compression.
+     */
+    bool isAuto() const { return automatic; }
+
+    CompressionCodec codec;
+    int              level;
+    ShuffleFilter    shuffle;
+
+private:
+    bool             automatic;
+};
+
 }
 
 #endif // NIX_COMPRESSION_H
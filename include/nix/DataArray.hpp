@@ -544,6 +544,29 @@ public:
     }
 
 
+    /**
+     * @brief Read whole rows, i.e. slices along the first dimension, of the data.
+     *
+     * All requested rows are fetched with a single read and stored one after the
+     * other in the buffer, in the order in which they are requested. Rows may be
+     * given unsorted and more than once.
+     *
+     * @param dtype     The data type of the buffer.
+     * @param data      Buffer with room for `rows.size()` rows.
+     * @param rows      The indices of the rows to read.
+     */
+    void getDataRows(DataType dtype, void *data, const std::vector<ndsize_t> &rows) const;
+
+    /**
+     * @brief Read whole rows, i.e. slices along the first dimension, of the data.
+     *
+     * The value is resized to hold `rows.size()` rows.
+     *
+     * @param value     The variable to store the data in.
+     * @param rows      The indices of the rows to read.
+     */
+    template<typename T> void getDataRows(T &value, const std::vector<ndsize_t> &rows) const;
+
     /**
      * @brief Get the extent of the data of the DataArray entity.
      *
@@ -562,6 +585,99 @@ public:
         backend()->dataExtent(extent);
     }
 
+    /**
+     * @brief Re-read the data extent from the file.
+     *
+     * For files opened in FileMode::SwmrRead, this makes data appended by the
+     * writer (and published via File::flush) visible without reopening the file.
+     */
+    void refresh() {
+        backend()->refresh();
+    }
+
+    /**
+     * @brief Get the chunk shape used to store the data of the DataArray entity.
+     *
+     * @return The chunk shape, empty if the data is not stored in chunks.
+     */
+    NDSize chunkShape() const {
+        return backend()->chunkShape();
+    }
+
+    /**
+     * @brief Get the number of chunks along each dimension of the data.
+     *
+     * @return The chunk grid, empty if the data is not stored in chunks.
+     */
+    NDSize chunkGrid() const;
+
+    /**
+     * @brief Write a chunk exactly as it should be stored in the file.
+     *
+     * The data bypasses type conversion and the filter pipeline (e.g. compression),
+     * i.e. it must already be in the file's data type and filtered. The extent of
+     * the DataArray must already cover the chunk.
+     *
+     * @param offset       The offset of the chunk in elements, aligned to the chunk shape.
+     * @param data         The chunk data.
+     * @param size         The size of the data in bytes.
+     * @param filter_mask  Bit i set means filter i of the pipeline was not applied, default 0.
+     */
+    void writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask = 0) {
+        backend()->writeChunk(offset, data, size, filter_mask);
+    }
+
+    /**
+     * @brief The number of bytes the chunk at offset occupies in the file.
+     *
+     * @param offset  The offset of the chunk in elements, aligned to the chunk shape.
+     *
+     * @return The stored size in bytes, 0 if the chunk was never written.
+     */
+    size_t chunkStorageSize(const NDSize &offset) const {
+        return backend()->chunkStorageSize(offset);
+    }
+
+    /**
+     * @brief Read a chunk exactly as it is stored in the file.
+     *
+     * No filters are applied, so the chunk can be passed to {@link writeChunk} of
+     * a DataArray with the same type, chunk shape and filters without transcoding.
+     *
+     * @param offset  The offset of the chunk in elements, aligned to the chunk shape.
+     * @param buffer  Receives the stored chunk, empty if the chunk was never written.
+     *
+     * @return The filter mask of the chunk.
+     */
+    uint32_t readChunk(const NDSize &offset, std::vector<char> &buffer) const;
+
+    /**
+     * @brief Compress chunks on a pool of threads when writing data.
+     *
+     * If enabled, the whole chunks covered by writes of deflate (optionally
+     * shuffle) compressed data are compressed in parallel and written in order
+     * bypassing the HDF5 filter pipeline; partial chunks, strings and converted
+     * data use the regular path. The threads are shared by all writers.
+     * Builds without zlib always use the regular path.
+     * The setting applies to every handle of this DataArray while the file is
+     * open and is not stored in the file; FileOptions::compression_threads sets
+     * the default of all DataArrays.
+     *
+     * @param threads  The number of threads, 0 (the default) disables it.
+     */
+    void compressionThreads(size_t threads) {
+        backend()->compressionThreads(threads);
+    }
+
+    /**
+     * @brief The number of threads used to compress chunks when writing data.
+     *
+     * @return The number of threads, 0 if parallel compression is disabled.
+     */
+    size_t compressionThreads() const {
+        return backend()->compressionThreads();
+    }
+
     /**
      * @brief Get the data type of the data stored in the DataArray entity.
      *
@@ -613,6 +729,23 @@ protected:
 };
 
 
+template<typename T>
+void DataArray::getDataRows(T &value, const std::vector<ndsize_t> &rows) const
+{
+    Hydra<T> hydra(value);
+    DataType dtype = hydra.element_data_type();
+
+    NDSize shape = dataExtent();
+    if (!shape) {
+        throw InvalidRank("Cannot read rows of 0-dimensional data");
+    }
+    shape[0] = rows.size();
+
+    hydra.resize(shape);
+    getDataRows(dtype, hydra.data(), rows);
+}
+
+
 template<>
 struct objectToType<nix::DataArray> {
     static const bool isValid = true;
@@ -20,13 +20,14 @@ public:
     DataView(DataArray da, NDSize count, NDSize offset)
             : array(std::move(da)), offset(std::move(offset)), count(std::move(count)) {
 
-        if (this->offset.size() != array.dataExtent().size()) {
+        NDSize extent = array.dataExtent();
+        if (this->offset.size() != extent.size()) {
             throw IncompatibleDimensions("DataView offset dimensionality does not match dimensionality of data", "nix::DataView");
         }
-        if (this->count.size() != array.dataExtent().size()) {
+        if (this->count.size() != extent.size()) {
             throw IncompatibleDimensions("DataView count dimensionality does not match dimensionality of data", "nix::DataView");
         }
-        if (this->offset + this->count > array.dataExtent()) {
+        if (this->offset + this->count > extent) {
             throw OutOfBounds("Trying to create DataView which is out of bounds");
         }
     }
@@ -14,9 +14,13 @@
 
 #include <nix/DataFrame.hpp>
 
+#include <cstdint>
+#include <iterator>
+
 namespace nix {
 class DataArray;
 class Dimension;
+class RangeAxis;
 
 /**
  * @brief Enumeration providing constants for position matching.
@@ -57,6 +61,107 @@ enum class PositionInRange{
                           NoRange = -1
 };
 
+/**
+ * @brief A lazily evaluated axis of a SampledDimension.
+ *
+ * The view stores only the sampling interval, offset and index range; each position is
+ * computed when it is accessed. It can be indexed and iterated like a vector, but does
+ * not allocate memory for the positions. Obtained via {@link SampledDimension::axisView}.
+ */
+class NIXAPI SampledAxis {
+
+public:
+
+    /**
+     * @brief Random access iterator over the positions of a SampledAxis.
+     */
+    class const_iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef double                          value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef const double*                   pointer;
+        typedef double                          reference;
+
+        const_iterator() : axis(nullptr), index(0) {}
+        const_iterator(const SampledAxis *axis, ndsize_t index) : axis(axis), index(index) {}
+
+        double operator*() const { return (*axis)[index]; }
+        double operator[](difference_type n) const { return (*axis)[index + n]; }
+
+        const_iterator &operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator tmp(*this); ++index; return tmp; }
+        const_iterator &operator--() { --index; return *this; }
+        const_iterator operator--(int) { const_iterator tmp(*this); --index; return tmp; }
+        const_iterator &operator+=(difference_type n) { index += n; return *this; }
+        const_iterator &operator-=(difference_type n) { index -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(axis, index + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(axis, index - n); }
+        difference_type operator-(const const_iterator &other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const const_iterator &other) const { return index == other.index; }
+        bool operator!=(const const_iterator &other) const { return index != other.index; }
+        bool operator<(const const_iterator &other) const { return index < other.index; }
+        bool operator>(const const_iterator &other) const { return index > other.index; }
+        bool operator<=(const const_iterator &other) const { return index <= other.index; }
+        bool operator>=(const const_iterator &other) const { return index >= other.index; }
+
+    private:
+        const SampledAxis *axis;
+        ndsize_t index;
+    };
+
+    /**
+     * @brief Creates an axis view.
+     *
+     * @param sampling_interval The sampling interval.
+     * @param offset            The offset of the axis.
+     * @param count             The number of positions.
+     * @param start_index       The index of the first position.
+     */
+    SampledAxis(double sampling_interval, double offset, ndsize_t count, ndsize_t start_index = 0)
+        : interval(sampling_interval), offset(offset), count(count), start(start_index)
+    {
+    }
+
+    /**
+     * @brief The number of positions in the view.
+     */
+    ndsize_t size() const { return count; }
+
+    /**
+     * @brief Whether the view contains no positions.
+     */
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Returns the position at the given index, relative to the start of the view.
+     *
+     * The index is not checked, use {@link at} for a checked access.
+     */
+    double operator[](ndsize_t index) const {
+        return (static_cast<double>(index) + start) * interval + offset;
+    }
+
+    /**
+     * @brief Returns the position at the given index, relative to the start of the view.
+     *
+     * Throws an {@link nix::OutOfBounds} exception if the index exceeds the view.
+     */
+    double at(ndsize_t index) const;
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+private:
+    double   interval;
+    double   offset;
+    ndsize_t count;
+    ndsize_t start;
+};
+
 /**
  * @brief Dimension descriptor for regularly sampled dimensions.
  *
@@ -365,6 +470,43 @@ public:
     DEPRECATED std::vector<std::pair<ndsize_t, ndsize_t>> indexOf(const std::vector<double> &start_positions,
                                                                   const std::vector<double> &end_positions) const;
 
+    /**
+     * @brief Converts arrays of start and end positions into index ranges.
+     *
+     * Batch version of {@link SampledDimension::indexOf(const std::vector<double>&, const std::vector<double>&, const RangeMatch)}
+     * that writes into caller provided arrays instead of creating an optional for each
+     * range. The sampling interval and offset are read only once. Ranges that are invalid
+     * are marked with a 0 in the valid mask and get start and end index 0.
+     *
+     * @param start_positions    Array of count start positions.
+     * @param end_positions      Array of count end positions.
+     * @param count              The number of ranges.
+     * @param match              RangeMatch enum to control whether the range should be
+     *                           including the end position or exclusive.
+     * @param start_indices      Array of count elements receiving the start indices.
+     * @param end_indices        Array of count elements receiving the end indices.
+     * @param valid              Array of count elements receiving 1 for valid ranges, 0 otherwise.
+     *
+     * @return The number of valid ranges.
+     */
+    size_t indexOf(const double *start_positions, const double *end_positions, size_t count, RangeMatch match,
+                   ndsize_t *start_indices, ndsize_t *end_indices, uint8_t *valid) const;
+
+    /**
+     * @brief Converts arrays of start and end positions into index ranges for the given
+     * sampling interval and offset.
+     *
+     * The loop does not allocate and contains neither calls nor data dependent branches,
+     * so that compilers vectorize it at -O2 -ftree-vectorize or -O3. Ranges whose indices
+     * reach 2^51 are converted one by one afterwards. The results equal those of the per
+     * range overload; the indexof suite of nix-bench compares the two.
+     *
+     * @see indexOf(const double*, const double*, size_t, RangeMatch, ndsize_t*, ndsize_t*, uint8_t*) const
+     */
+    static size_t indexOf(const double *start_positions, const double *end_positions, size_t count,
+                          double sampling_interval, double offset, RangeMatch match,
+                          ndsize_t *start_indices, ndsize_t *end_indices, uint8_t *valid);
+
 
 
     /**
@@ -393,6 +535,20 @@ public:
      */
     std::vector<double> axis(const ndsize_t count, const ndsize_t startIndex = 0) const;
 
+    /**
+     * @brief Returns a lazy view on the positions defined by this dimension.
+     *
+     * Unlike {@link axis} no vector is allocated, the positions are computed
+     * when they are accessed. Offset and sampling interval are read once, when
+     * the view is created.
+     *
+     * @param count        The number of indices
+     * @param startIndex   The start index, default = 0
+     *
+     * @returns A SampledAxis view of the positions.
+     */
+    SampledAxis axisView(const ndsize_t count, const ndsize_t startIndex = 0) const;
+
     /**
      * @brief Assignment operator.
      *
@@ -803,6 +959,42 @@ public:
         backend()->labels(t);
     }
 
+    /**
+     * @brief Returns the index of the given label.
+     *
+     * If a label occurs more than once, the index of its first occurrence is returned.
+     *
+     * @param label     The label.
+     *
+     * @return An optional containing the index, empty if the label does not exist.
+     */
+    boost::optional<ndsize_t> indexOf(const std::string &label) const;
+
+    /**
+     * @brief Returns the indices of several labels.
+     *
+     * The lookups use a table of the labels that the backend shares between all handles
+     * of the dimension. The table is rebuilt on the first lookup after the labels were
+     * written.
+     *
+     * @param labels    The labels.
+     *
+     * @return A vector of optionals containing the indices, one entry per label.
+     */
+    std::vector<boost::optional<ndsize_t>> indexOf(const std::vector<std::string> &labels) const;
+
+    /**
+     * @brief Returns the indices of several labels into a preallocated array.
+     *
+     * @param labels    The labels.
+     * @param indices   Receives the indices, must hold labels.size() entries. Missing labels get 0.
+     * @param valid     Receives 1 for each label that was found and 0 otherwise, must
+     *                  hold labels.size() entries.
+     *
+     * @return The number of labels found.
+     */
+    size_t indexOf(const std::vector<std::string> &labels, ndsize_t *indices, uint8_t *valid) const;
+
     /**
      * @brief converts a position given as a double to an index in this dimension, if 
      * it contains labels, then the position will be validated within these limits.
@@ -1226,6 +1418,23 @@ public:
      */
     std::vector<double> axis(const ndsize_t count, const ndsize_t startIndex = 0) const;
 
+    /**
+     * @brief Returns a lazy view on a number of ticks.
+     *
+     * The ticks are read on demand in chunks of chunk_size values, so that
+     * iterating over a long axis only keeps a single chunk in memory.
+     *
+     * @param count       The number of ticks.
+     * @param startIndex  The starting index. Default 0.
+     * @param chunk_size  The number of ticks read at once. Default 65536.
+     *
+     * @return A RangeAxis view of the ticks.
+     *
+     * Accessing the view will throw a nix::OutOfBounds exception if startIndex + count
+     * is beyond the number of ticks.
+     */
+    RangeAxis axisView(const ndsize_t count, const ndsize_t startIndex = 0, size_t chunk_size = 65536) const;
+
     /**
      * @brief Assignment operator.
      *
@@ -1264,6 +1473,103 @@ public:
 };
 
 
+/**
+ * @brief A lazily loaded axis of a RangeDimension.
+ *
+ * The ticks are read from the file in chunks when they are accessed. Only the most
+ * recently read chunk is kept, so sequential iteration over an axis of any length
+ * needs a constant amount of memory. Obtained via {@link RangeDimension::axisView}.
+ */
+class NIXAPI RangeAxis {
+
+public:
+
+    /**
+     * @brief Iterator over the ticks of a RangeAxis.
+     *
+     * All iterators share the chunk buffer of their axis.
+     */
+    class const_iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef double                  value_type;
+        typedef std::ptrdiff_t          difference_type;
+        typedef const double*           pointer;
+        typedef double                  reference;
+
+        const_iterator() : axis(nullptr), index(0) {}
+        const_iterator(const RangeAxis *axis, ndsize_t index) : axis(axis), index(index) {}
+
+        double operator*() const { return (*axis)[index]; }
+
+        const_iterator &operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator tmp(*this); ++index; return tmp; }
+
+        bool operator==(const const_iterator &other) const { return index == other.index; }
+        bool operator!=(const const_iterator &other) const { return index != other.index; }
+
+    private:
+        const RangeAxis *axis;
+        ndsize_t index;
+    };
+
+    /**
+     * @brief Creates an axis view.
+     *
+     * @param dimension   The RangeDimension providing the ticks.
+     * @param count       The number of ticks.
+     * @param start_index The index of the first tick.
+     * @param chunk_size  The number of ticks read at once.
+     */
+    RangeAxis(const RangeDimension &dimension, ndsize_t count, ndsize_t start_index = 0, size_t chunk_size = 65536);
+
+    /**
+     * @brief The number of ticks in the view.
+     */
+    ndsize_t size() const { return count; }
+
+    /**
+     * @brief Whether the view contains no ticks.
+     */
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Returns the tick at the given index, relative to the start of the view.
+     *
+     * Reads the chunk containing the tick if it is not buffered. The buffer never
+     * holds ticks beyond the view, so the index is checked as well: an index that
+     * exceeds the view throws an {@link nix::OutOfBounds} exception, like {@link at}.
+     */
+    double operator[](ndsize_t index) const {
+        if (index < buffer_start || index - buffer_start >= buffer.size()) {
+            load(index);
+        }
+        return buffer[static_cast<size_t>(index - buffer_start)];
+    }
+
+    /**
+     * @brief Returns the tick at the given index, relative to the start of the view.
+     *
+     * Throws an {@link nix::OutOfBounds} exception if the index exceeds the view.
+     */
+    double at(ndsize_t index) const;
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+private:
+
+    void load(ndsize_t index) const;
+
+    RangeDimension              dimension;
+    ndsize_t                    count;
+    ndsize_t                    start;
+    size_t                      chunk_size;
+    mutable std::vector<double> buffer;
+    mutable ndsize_t            buffer_start;
+};
+
+
 /**
  * @brief Instances of the Dimension subclasses are used to define the different dimensions of data in a DataArray.
  *
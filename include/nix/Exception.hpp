@@ -135,9 +135,11 @@ public:
 
 namespace check {
 
+// the messages are only turned into strings if the check fails
+
 template<typename T>
 inline typename std::enable_if<! std::is_same<T, size_t>::value, size_t>::type
-fits_in_size_t(T size, const std::string &msg_if_fail) {
+fits_in_size_t(T size, const char *msg_if_fail) {
     if (size > std::numeric_limits<size_t>::max()) {
         throw OutOfBounds(msg_if_fail);
     }
@@ -146,13 +148,18 @@ fits_in_size_t(T size, const std::string &msg_if_fail) {
 
 template<typename T>
 inline typename std::enable_if<std::is_same<T, size_t>::value, size_t>::type
-fits_in_size_t(T size, const std::string &msg_if_fail) {
+fits_in_size_t(T size, const char *msg_if_fail) {
     return size;
 }
 
+template<typename T>
+inline size_t fits_in_size_t(T size, const std::string &msg_if_fail) {
+    return fits_in_size_t(size, msg_if_fail.c_str());
+}
+
 template<typename T>
 inline typename std::enable_if<std::is_integral<T>::value, double>::type
-converts_to_double(T num, const std::string &msg_if_fail) {
+converts_to_double(T num, const char *msg_if_fail) {
     double dbl = static_cast<double>(num);
     if (static_cast<T>(dbl) != num) {
         throw OutOfBounds(msg_if_fail);
@@ -160,6 +167,11 @@ converts_to_double(T num, const std::string &msg_if_fail) {
     return dbl;
 }
 
+template<typename T>
+inline double converts_to_double(T num, const std::string &msg_if_fail) {
+    return converts_to_double(num, msg_if_fail.c_str());
+}
+
 } // nix::check::
 
 
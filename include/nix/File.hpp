@@ -95,12 +95,99 @@ public:
                      const std::string &impl="hdf5", Compression compression=Compression::Auto,
                      OpenFlags flags=OpenFlags::None);
 
+    /**
+     * @brief Opens a file with layout and access options.
+     *
+     * @param name          The name/path of the file.
+     * @param mode          The open mode.
+     * @param options       Options for the layout of new files and for accessing
+     *                      the file, e.g. paged aggregation and page buffering.
+     * @param impl          The back-end implementation to be used to open the file.
+     *                      (currently only hdf5)
+     * @param compression   The compression mode, defaults to Compression::None (can be
+     *                      overridden upon DataArray creation)
+     * @param flags         Control aspects of the file opening process
+     *
+     * @return The opened file.
+     */
+    static File open(const std::string &name, FileMode mode, const FileOptions &options,
+                     const std::string &impl="hdf5", Compression compression=Compression::Auto,
+                     OpenFlags flags=OpenFlags::None);
+
+    /**
+     * @brief Opens an in-memory copy of a file image.
+     *
+     * The image is copied, i.e. changes made in ReadWrite mode only affect the
+     * copy and can be retrieved via {@link image}. To build a file in memory
+     * from scratch use {@link open} with OpenFlags::InMemory instead.
+     *
+     * @param image         The file image, e.g. as returned by {@link image}.
+     * @param size          The size of the image in bytes.
+     * @param mode          The open mode, ReadOnly or ReadWrite.
+     * @param impl          The back-end implementation to be used to open the file.
+     *                      (currently only hdf5)
+     * @param compression   The compression mode, defaults to Compression::None (can be
+     *                      overridden upon DataArray creation)
+     * @param flags         Control aspects of the file opening process
+     *
+     * @return The opened file.
+     */
+    static File openImage(const void *image, size_t size, FileMode mode=FileMode::ReadOnly,
+                          const std::string &impl="hdf5", Compression compression=Compression::Auto,
+                          OpenFlags flags=OpenFlags::None);
+
     /**
      * @brief Persists all cached changes to the backend.
      *
      */
     bool flush();
 
+    /**
+     * @brief Get the serialized file, e.g. to store an in-memory file.
+     *
+     * The result can be written to disk or passed to {@link openImage}.
+     *
+     * @return The bytes of the file.
+     */
+    std::vector<char> image() {
+        return backend()->image();
+    }
+
+    /**
+     * @brief Copy the file into a new, compact file.
+     *
+     * Deleting entities does not free the space they occupied in the file.
+     * Repacking copies all live entities, including their ids, metadata and
+     * links between entities, into a fresh file. The data of DataArrays can
+     * optionally be re-chunked and re-compressed on the way; otherwise it is
+     * copied chunk by chunk without being decoded.
+     *
+     * @param target    The path of the new file, which is overwritten. Must
+     *                  not be the file itself.
+     * @param options   Options for re-encoding the data of DataArrays.
+     */
+    void repack(const std::string &target, const RepackOptions &options = RepackOptions());
+
+    /**
+     * @brief Get the I/O statistics of the file.
+     *
+     * Statistics are only collected for files opened with
+     * FileOptions::statistics set, the counters of other files stay zero.
+     *
+     * @return A snapshot of the counters since the file was opened or the
+     *         statistics were last reset.
+     */
+    IOStatistics statistics() const {
+        return backend()->statistics();
+    }
+
+    /**
+     * @brief Set all I/O statistics of the file to zero.
+     */
+    void resetStatistics() {
+        backend()->resetStatistics();
+    }
+
 
     /**
      * @brief Get the number of blocks in in the file.
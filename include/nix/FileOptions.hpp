@@ -0,0 +1,120 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+#ifndef NIX_FILE_OPTIONS_H
+#define NIX_FILE_OPTIONS_H
+
+#include <cstddef>
+
+namespace nix {
+
+/**
+ * @brief Versions of the storage format that objects in a file may use.
+ */
+enum class FormatBound {
+    Earliest = 0, // the most compatible format for each object
+    V18,          // readable by HDF5 1.8 and newer
+    V110,         // readable by HDF5 1.10 and newer
+    Latest        // the latest format known to the library
+};
+
+/**
+ * @brief How the groups and attributes of entities are stored.
+ */
+enum class EntityLayout {
+    Default = 0, // HDF5 default group settings, variable length strings
+    Compact      // compact link and attribute storage, fixed-size ids and timestamps
+};
+
+/**
+ * @brief Options that control how a file is laid out and accessed.
+ *
+ * Files with many small entities are dominated by metadata, which by default
+ * is scattered across the file. With paged aggregation metadata and raw data
+ * are allocated in separate pages, so that opening and listing a file needs
+ * few, large reads; together with a page buffer this makes cold opens on
+ * network file systems considerably faster.
+ *
+ * ~~~
+ * FileOptions opts;
+ * opts.paged = true;
+ * opts.page_size = 64 * 1024;
+ * File f = File::open("many-entities.nix", FileMode::Overwrite, opts);
+ * ...
+ * opts.page_buffer_size = 4 * 1024 * 1024;
+ * f = File::open("many-entities.nix", FileMode::ReadOnly, opts);
+ * ~~~
+ *
+ * The creation options (paged, page_size, persist_free_space, entity_layout)
+ * only apply to new files; the others apply whenever a file is opened. A size of 0 keeps
+ * the library default.
+ */
+struct FileOptions {
+
+    /**
+     * @brief Use paged aggregation for new files.
+     */
+    bool paged = false;
+
+    /**
+     * @brief The page size of paged files in bytes.
+     */
+    size_t page_size = 0;
+
+    /**
+     * @brief Keep track of free space across open/close cycles.
+     */
+    bool persist_free_space = false;
+
+    /**
+     * @brief The storage layout of entities. The compact layout keeps the links
+     * and attributes of entities in their object headers instead of separate
+     * heaps and stores ids and timestamps as fixed-size strings, which makes
+     * files with many entities smaller and faster to open.
+     */
+    EntityLayout entity_layout = EntityLayout::Default;
+
+    /**
+     * @brief Maintain a catalog of all entities at the file root. The catalog
+     * is rebuilt when a file changed by a writer is closed and lets read-only
+     * opens look up entities by id without visiting every group. Once a file
+     * has a catalog it is maintained by every writer.
+     */
+    bool catalog = false;
+
+    /**
+     * @brief Count the storage operations of the file, cf. {@link File::statistics}.
+     */
+    bool statistics = false;
+
+    /**
+     * @brief The number of threads compressing chunks when writing the
+     * DataArrays of the file, cf. {@link DataArray::compressionThreads}.
+     */
+    size_t compression_threads = 0;
+
+    /**
+     * @brief The minimum size of blocks allocated for metadata, in bytes.
+     */
+    size_t metadata_block_size = 0;
+
+    /**
+     * @brief The bounds of the format versions used when writing objects.
+     */
+    FormatBound format_low = FormatBound::Earliest;
+    FormatBound format_high = FormatBound::Latest;
+
+    /**
+     * @brief The size of the page buffer in bytes; opening a file that is not
+     * paged fails if this is set.
+     */
+    size_t page_buffer_size = 0;
+};
+
+}
+
+#endif // NIX_FILE_OPTIONS_H
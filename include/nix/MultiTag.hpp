@@ -185,6 +185,22 @@ public:
         backend()->extents(t);
     }
 
+    /**
+     * @brief Reads the positions and extents for a set of position indices.
+     *
+     * The distinct requested rows are fetched with a single bulk read from each of
+     * the positions and extents DataArrays, instead of one read per index.
+     *
+     * @param indices     The position indices.
+     * @param positions   Receives the positions, one vector per column (i.e. dimension)
+     *                    each holding one entry per requested index.
+     * @param extents     Receives the extents in the same layout, filled with zeros
+     *                    if the tag has no extents.
+     */
+    void positionsAndExtents(const std::vector<ndsize_t> &indices,
+                             std::vector<std::vector<double>> &positions,
+                             std::vector<std::vector<double>> &extents) const;
+
     /**
      * @brief Gets for the units of the tag.
      *
@@ -18,17 +18,160 @@
 #include <vector>
 #include <iostream>
 #include <cstring>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace nix {
 
+/**
+ * @brief Provides the storage of NDArrays.
+ *
+ * Allocators are shared between the arrays that use them and must be thread
+ * safe if the arrays are used by several threads.
+ */
+class NIXAPI NDArrayAllocator {
+
+public:
+
+    /**
+     * @brief Allocate at least bytes bytes aligned to alignment, a power of two.
+     * Throws std::bad_alloc on failure.
+     */
+    virtual void *allocate(size_t bytes, size_t alignment) = 0;
+
+    /**
+     * @brief Release memory returned by allocate(bytes, alignment).
+     */
+    virtual void deallocate(void *ptr, size_t bytes, size_t alignment) = 0;
+
+
+    virtual ~NDArrayAllocator() {}
+};
+
+/**
+ * @brief The allocator of NDArrays that are not given one, which allocates
+ * aligned memory from the heap.
+ */
+NIXAPI std::shared_ptr<NDArrayAllocator> defaultNDArrayAllocator();
+
+/**
+ * @brief An allocator that keeps released buffers for reuse.
+ *
+ * Buffers are kept in power of two size classes, up to max_cached bytes in
+ * total, so that arrays of the same shape created in a loop are served from
+ * the pool after the first iteration. New buffers are requested from the
+ * upstream allocator, by default defaultNDArrayAllocator().
+ *
+ * ~~~
+ * auto pool = std::make_shared<nix::NDArrayPool>();
+ * for (...) {
+ *     nix::NDArray block(nix::DataType::Double, shape, pool);
+ *     da.getData(block.dtype(), block.data(), shape, offset);
+ * }
+ * ~~~
+ */
+class NIXAPI NDArrayPool : public NDArrayAllocator {
+
+public:
+
+    explicit NDArrayPool(size_t max_cached = 64 * 1024 * 1024,
+                         const std::shared_ptr<NDArrayAllocator> &upstream = nullptr);
+
+
+    void *allocate(size_t bytes, size_t alignment);
+
+
+    void deallocate(void *ptr, size_t bytes, size_t alignment);
+
+    /**
+     * @brief The bytes of the buffers that are kept for reuse.
+     */
+    size_t cachedBytes() const;
+
+    /**
+     * @brief Allocations served by a kept buffer, and those that were not.
+     */
+    uint64_t hits() const;
+
+
+    uint64_t misses() const;
+
+    /**
+     * @brief Release all kept buffers.
+     */
+    void clear();
+
+
+    ~NDArrayPool();
+
+private:
+
+    mutable std::mutex mutex;
+    // free buffers by size class and alignment
+    std::map<std::pair<size_t, size_t>, std::vector<void *>> free_buffers;
+    std::shared_ptr<NDArrayAllocator> upstream;
+    size_t max_cached;
+    size_t cached;
+    uint64_t n_hits;
+    uint64_t n_misses;
+};
+
+
 class NIXAPI NDArray {
 
 public:
 
     typedef uint8_t byte_type;
 
+    /**
+     * @brief The alignment of the data of NDArrays, suitable for SIMD loads
+     * of up to 512 bits.
+     */
+    static const size_t default_alignment = 64;
+
     NDArray(DataType dtype, NDSize dims);
 
+    /**
+     * @brief Create an NDArray whose data is provided by allocator.
+     *
+     * @param alignment  The alignment of the data, a power of two.
+     */
+    NDArray(DataType dtype, NDSize dims, const std::shared_ptr<NDArrayAllocator> &allocator,
+            size_t alignment = default_alignment);
+
+    /**
+     * @brief Create an NDArray that takes ownership of data, which holds the
+     * elements of dims, and releases it with deleter.
+     */
+    static NDArray adopt(DataType dtype, NDSize dims, void *data, std::function<void(void *)> deleter);
+
+    /**
+     * @brief Create an NDArray on top of data, which holds the elements of
+     * dims and must outlive the array. The array cannot grow beyond it.
+     */
+    static NDArray borrow(DataType dtype, NDSize dims, void *data);
+
+    /**
+     * @brief Copies the data into storage of the same allocator, or of the
+     * default allocator if the data was adopted or borrowed.
+     */
+    NDArray(const NDArray &other);
+
+
+    NDArray(NDArray &&other);
+
+
+    NDArray &operator=(const NDArray &other);
+
+
+    NDArray &operator=(NDArray &&other);
+
+
+    ~NDArray();
+
     size_t rank() const { return extends.size(); }
     ndsize_t num_elements() const { return extends.nelms(); }
     NDSize  shape() const { return extends; }
@@ -40,23 +183,53 @@ public:
     template<typename T> void set(size_t index, T value);
     template<typename T> void set(const NDSize &index, T value);
 
-    byte_type *data() { return dstore.data(); }
-    const byte_type *data() const { return dstore.data(); }
-
+    byte_type *data() { return dstore; }
+    const byte_type *data() const { return dstore; }
+
+    /**
+     * @brief The alignment of the data; for adopted and borrowed data the one
+     * of the given pointer.
+     */
+    size_t alignment() const { return align; }
+
+    /**
+     * @brief The number of bytes the array can grow to without reallocating.
+     */
+    size_t capacity() const { return store_capacity; }
+
+    /**
+     * @brief Whether the data belongs to the caller, see borrow().
+     */
+    bool borrowed() const { return !allocator && !deleter; }
+
+    /**
+     * @brief Change the shape. The data is kept as flat array and extended
+     * with zeros; storage is only reallocated if it is too small.
+     */
     void resize(const NDSize &new_size);
 
     size_t sub2index(const NDSize &sub) const;
 
 private:
 
+    NDArray(DataType dtype, NDSize dims, void *data, std::function<void(void *)> deleter);
+
     DataType  dataType;
     void allocate_space();
     void calc_strides();
+    void release();
+    void take(NDArray &other);
 
     NDSize                  extends;
     NDSize                  strides;
-    std::vector<byte_type> dstore;
 
+    // the storage is owned via allocator, via deleter or not at all (borrowed)
+    std::shared_ptr<NDArrayAllocator> allocator;
+    std::function<void(void *)> deleter;
+    byte_type *dstore;
+    size_t store_size;
+    size_t store_capacity;
+    size_t align;
 };
 
 /* ******************************************* */
@@ -65,7 +238,7 @@ template<typename T>
 const T NDArray::get(size_t index) const
 {
     T value;
-    const byte_type *offset = dstore.data() + sizeof(T) * index;
+    const byte_type *offset = dstore + sizeof(T) * index;
     memcpy(&value, offset, sizeof(T));
     return value;
 }
@@ -82,7 +255,7 @@ const T NDArray::get(const NDSize &index) const
 template<typename T>
 void NDArray::set(size_t index, T value)
 {
-    byte_type *offset = dstore.data() + sizeof(T) * index;
+    byte_type *offset = dstore + sizeof(T) * index;
     memcpy(offset, &value, sizeof(T));
 }
 
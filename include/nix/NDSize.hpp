@@ -20,6 +20,7 @@
 #include <iostream>
 #include <vector>
 #include <type_traits>
+#include <utility>
 
 
 namespace nix {
@@ -61,20 +62,20 @@ public:
     typedef size_t   size_type;
 
     NDSizeBase()
-        : rank(0), dims(nullptr)
+        : rank(0), dims(inline_dims)
     {
     }
 
 
     explicit NDSizeBase(size_t rank)
-        : rank(rank), dims(nullptr)
+        : rank(rank), dims(inline_dims)
     {
         allocate();
     }
 
 
     explicit NDSizeBase(size_t rank, T fill_value)
-        : rank(rank), dims(nullptr)
+        : rank(rank), dims(inline_dims)
     {
         allocate();
         fill(fill_value);
@@ -82,7 +83,7 @@ public:
 
     template<typename U>
     NDSizeBase(std::initializer_list<U> args)
-        : rank(args.size())
+        : rank(args.size()), dims(inline_dims)
     {
         allocate();
 
@@ -102,7 +103,7 @@ public:
 
     template<typename U>
     NDSizeBase(const std::vector<U> &args)
-        : rank(args.size())
+        : rank(args.size()), dims(inline_dims)
     {
         allocate();
 
@@ -121,23 +122,38 @@ public:
 
     //copy
     NDSizeBase(const NDSizeBase &other)
-        : rank(other.rank), dims(nullptr)
+        : rank(other.rank), dims(inline_dims)
     {
         allocate();
         nd_copy(other.dims, rank, dims);
     }
 
-    //move (not tested due to: http://llvm.org/bugs/show_bug.cgi?id=12208)
+    //move: steals the heap storage of other, if any
     NDSizeBase(NDSizeBase &&other)
-        : rank(other.rank), dims(other.dims)
+        : rank(0), dims(inline_dims)
     {
-        other.dims = nullptr;
-        other.rank = 0;
+        take(other);
+    }
+
+
+    NDSizeBase& operator=(const NDSizeBase &other) {
+        if (this != &other) {
+            if (rank != other.rank) {
+                release();
+                rank = other.rank;
+                allocate();
+            }
+            nd_copy(other.dims, rank, dims);
+        }
+        return *this;
     }
 
-    //copy and move assignment operator (not tested, see above)
-    NDSizeBase& operator=(NDSizeBase other) {
-        swap(other);
+
+    NDSizeBase& operator=(NDSizeBase &&other) {
+        if (this != &other) {
+            release();
+            take(other);
+        }
         return *this;
     }
 
@@ -244,9 +260,9 @@ public:
 
 
     void swap(NDSizeBase &other) {
-        using std::swap;
-        swap(dims, other.dims);
-        rank = other.rank;
+        NDSizeBase tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
     }
 
 
@@ -316,7 +332,7 @@ public:
 
 
     ~NDSizeBase() {
-        delete[] dims;
+        release();
     }
 
 
@@ -337,14 +353,40 @@ public:
 
 private:
 
+    // shapes up to this rank are stored inline, without a heap allocation
+    static const size_t inline_rank = 4;
+
     void allocate() {
-        if (rank > 0) {
+        if (rank > inline_rank) {
             dims = new T[rank];
         }
     }
 
+
+    void release() {
+        if (dims != inline_dims) {
+            delete[] dims;
+            dims = inline_dims;
+        }
+        rank = 0;
+    }
+
+
+    // moves the dimensions of other into this, which must not own heap storage
+    void take(NDSizeBase &other) {
+        rank = other.rank;
+        if (other.dims != other.inline_dims) {
+            dims = other.dims;
+            other.dims = other.inline_dims;
+        } else {
+            nd_copy(other.inline_dims, rank, inline_dims);
+        }
+        other.rank = 0;
+    }
+
     size_t   rank;
     T *dims;
+    T inline_dims[inline_rank];
 };
 
 
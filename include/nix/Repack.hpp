@@ -0,0 +1,52 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+#ifndef NIX_REPACK_H
+#define NIX_REPACK_H
+
+#include <nix/Compression.hpp>
+#include <nix/Chunking.hpp>
+
+#include <cstddef>
+
+namespace nix {
+
+/**
+ * @brief Controls how {@link File::repack} copies a file.
+ *
+ * By default all entities are copied as they are stored. The data of
+ * DataArrays can optionally be re-chunked and/or re-compressed on the way.
+ *
+ * ~~~
+ * RepackOptions opts;
+ * opts.compression = CompressionOptions(CompressionCodec::Deflate, 4, ShuffleFilter::Byte);
+ * file.repack("compact.nix", opts);
+ * ~~~
+ */
+struct RepackOptions {
+
+    /**
+     * @brief The compression of the DataArray data; Compression::Auto keeps
+     * the existing filters, Compression::None removes them.
+     */
+    CompressionOptions compression = Compression::Auto;
+
+    /**
+     * @brief The chunking of the DataArray data; automatic chunking keeps the
+     * existing chunks. An explicit shape only applies to data of the same rank.
+     */
+    ChunkingOptions chunking;
+
+    /**
+     * @brief The maximum number of bytes buffered in memory while re-encoding data.
+     */
+    size_t buffer_size = 64 * 1024 * 1024;
+};
+
+}
+
+#endif // NIX_REPACK_H
@@ -0,0 +1,116 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+#ifndef NIX_STATISTICS_H
+#define NIX_STATISTICS_H
+
+#include <nix/ObjectType.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace nix {
+
+/**
+ * @brief Counters of the storage operations caused by calls into the library.
+ */
+struct IOCounters {
+
+    /**
+     * @brief The number of API calls the counters belong to.
+     */
+    uint64_t calls = 0;
+
+    /**
+     * @brief Groups and datasets opened.
+     */
+    uint64_t object_opens = 0;
+
+    uint64_t attribute_reads = 0;
+    uint64_t attribute_writes = 0;
+
+    /**
+     * @brief Dataset reads and writes, i.e. H5Dread and H5Dwrite calls.
+     */
+    uint64_t dataset_reads = 0;
+    uint64_t dataset_writes = 0;
+
+    /**
+     * @brief The number of bytes moved by dataset reads and writes, in their
+     * in-memory representation.
+     */
+    uint64_t bytes_read = 0;
+    uint64_t bytes_written = 0;
+
+    /**
+     * @brief The time spent in dataset reads and writes, in seconds.
+     */
+    double read_time = 0.0;
+    double write_time = 0.0;
+
+    /**
+     * @brief Dataset and attribute transfers whose in-memory type differs
+     * from the stored one.
+     */
+    uint64_t conversions = 0;
+
+    /**
+     * @brief Lookups answered by the entity catalog and the page buffer,
+     * or missed by them.
+     */
+    uint64_t cache_hits = 0;
+    uint64_t cache_misses = 0;
+
+    IOCounters &operator+=(const IOCounters &other) {
+        calls += other.calls;
+        object_opens += other.object_opens;
+        attribute_reads += other.attribute_reads;
+        attribute_writes += other.attribute_writes;
+        dataset_reads += other.dataset_reads;
+        dataset_writes += other.dataset_writes;
+        bytes_read += other.bytes_read;
+        bytes_written += other.bytes_written;
+        read_time += other.read_time;
+        write_time += other.write_time;
+        conversions += other.conversions;
+        cache_hits += other.cache_hits;
+        cache_misses += other.cache_misses;
+        return *this;
+    }
+};
+
+/**
+ * @brief A snapshot of the I/O statistics of a file.
+ *
+ * Operations are attributed to the outermost API call that caused them, e.g.
+ * the groups opened while looking up a DataArray by id are counted for
+ * "Block::getEntity". Calls are named "<Entity>::<method>" and additionally
+ * summed up per entity type. Page buffer hits and misses are only known for
+ * the file as a whole and are only included in the total.
+ *
+ * ~~~
+ * FileOptions opts;
+ * opts.statistics = true;
+ * File f = File::open("recording.nix", FileMode::ReadOnly, opts);
+ * ...
+ * IOStatistics stats = f.statistics();
+ * std::cout << stats.calls["DataArray::read"].bytes_read << std::endl;
+ * ~~~
+ */
+struct IOStatistics {
+
+    IOCounters total;
+
+    std::map<ObjectType, IOCounters> entities;
+
+    std::map<std::string, IOCounters> calls;
+};
+
+}
+
+#endif // NIX_STATISTICS_H
@@ -0,0 +1,132 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+#ifndef NIX_TRACE_H
+#define NIX_TRACE_H
+
+#include <nix/Platform.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace nix {
+
+/**
+ * @brief A traced operation, either a call of the NIX API or a storage
+ * operation of the backend.
+ */
+struct TraceEvent {
+
+    /**
+     * @brief The name of the operation, e.g. "DataArray::read" or "DataSet::read".
+     */
+    const char *name = "";
+
+    /**
+     * @brief "nix" for calls of the NIX API, "hdf5" for storage operations.
+     */
+    const char *category = "";
+
+    /**
+     * @brief The HDF5 path of the object that is operated on; attributes are
+     * appended with an "@", e.g. "/data/block@entity_id".
+     */
+    std::string entity;
+
+    /**
+     * @brief The number of bytes read or written by the operation.
+     */
+    uint64_t bytes = 0;
+
+    std::chrono::steady_clock::time_point start;
+
+    /**
+     * @brief The duration of the operation in seconds, zero for begin events.
+     */
+    double duration = 0.0;
+};
+
+/**
+ * @brief Receives the traced operations of all files.
+ *
+ * Operations nest: the storage operations of an API call, and the API calls
+ * it makes itself, begin after and end before the call. Sinks are called from
+ * the thread that executes the operation and must be thread safe.
+ */
+class NIXAPI TraceSink {
+
+public:
+
+    virtual void begin(const TraceEvent &event) = 0;
+
+
+    virtual void end(const TraceEvent &event) = 0;
+
+
+    virtual ~TraceSink() {}
+};
+
+/**
+ * @brief Writes the traced operations as Chrome trace events, which can be
+ * loaded in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * ~~~
+ * nix::setTraceSink(std::make_shared<nix::ChromeTraceSink>("nix-trace.json"));
+ * ...
+ * nix::setTraceSink(nullptr); // completes the file
+ * ~~~
+ */
+class NIXAPI ChromeTraceSink : public TraceSink {
+
+public:
+
+    explicit ChromeTraceSink(const std::string &path);
+
+
+    void begin(const TraceEvent &event);
+
+
+    void end(const TraceEvent &event);
+
+
+    /**
+     * @brief Complete the trace file; later events are dropped.
+     */
+    void close();
+
+
+    ~ChromeTraceSink();
+
+private:
+
+    std::mutex mutex;
+    std::ofstream out;
+    std::chrono::steady_clock::time_point origin;
+    std::unordered_map<std::thread::id, size_t> threads;
+    bool first = true;
+};
+
+/**
+ * @brief Install the sink that receives the traced operations, or remove it
+ * by passing nullptr. Tracing costs nothing while no sink is installed.
+ */
+NIXAPI void setTraceSink(const std::shared_ptr<TraceSink> &sink);
+
+/**
+ * @brief The installed trace sink, if any.
+ */
+NIXAPI std::shared_ptr<TraceSink> traceSink();
+
+}
+
+#endif // NIX_TRACE_H
@@ -17,6 +17,7 @@
 #include <nix/base/IMultiTag.hpp>
 #include <nix/base/IGroup.hpp>
 #include <nix/Compression.hpp>
+#include <nix/Chunking.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/Identity.hpp>
 
@@ -78,7 +79,8 @@ public:
 
     virtual std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                               DataType data_type, const NDSize &shape,
-                                                              const Compression &compression) = 0;
+                                                              const CompressionOptions &compression,
+                                                              const ChunkingOptions &chunking) = 0;
 
     //--------------------------------------------------
     // Methods concerning data frame
@@ -87,7 +89,7 @@ public:
     virtual std::shared_ptr<base::IDataFrame> createDataFrame(const std::string &name,
                                                               const std::string &type,
                                                               const std::vector<Column> &cols,
-                                                              const Compression &compression) = 0;
+                                                              const CompressionOptions &compression) = 0;
 
     //--------------------------------------------------
     // Methods concerning tags.
@@ -13,6 +13,7 @@
 #include <nix/base/IDimensions.hpp>
 #include <nix/DataFrame.hpp>
 #include <nix/Compression.hpp>
+#include <nix/Chunking.hpp>
 #include <nix/DataType.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/ObjectType.hpp>
@@ -125,8 +126,10 @@ public:
      * @param dtype        The data type that should be stored in this data array.
      * @param size         The size of the data to store.
      * @param compression  En-/disables compression for this DataArray
+     * @param chunking     The chunk shape or access pattern used to determine it
      */
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression) = 0;
+    virtual void createData(DataType dtype, const NDSize &size, const CompressionOptions &compression,
+                            const ChunkingOptions &chunking) = 0;
 
     /**
      * @brief Check if the data array has some data.
@@ -155,12 +158,72 @@ public:
      */
     virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const = 0;
 
+    /**
+     * @brief Read whole rows, i.e. slices along the first dimension, of the data array.
+     *
+     * The rows are read in a single operation and stored consecutively in the buffer.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Buffer where the data is written.
+     * @param rows      The row indices, sorted in strictly ascending order.
+     */
+    virtual void readRows(DataType dtype, void *buffer, const std::vector<ndsize_t> &rows) const = 0;
+
 
     virtual NDSize dataExtent(void) const = 0;
 
 
     virtual void dataExtent(const NDSize &extent) = 0;
 
+    /**
+     * @brief Re-read the extent and other metadata of the data from the file.
+     */
+    virtual void refresh() = 0;
+
+    /**
+     * @brief The chunk shape of the stored data.
+     *
+     * @return The chunk shape, empty if the data is not chunked.
+     */
+    virtual NDSize chunkShape() const = 0;
+
+    /**
+     * @brief Write a chunk as stored in the file, bypassing type conversion and filters.
+     *
+     * @param offset       The offset of the chunk in elements, aligned to the chunk shape.
+     * @param data         The chunk data, already filtered (e.g. compressed).
+     * @param size         The size of the data in bytes.
+     * @param filter_mask  Bit i set means filter i of the pipeline was not applied.
+     */
+    virtual void writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask) = 0;
+
+    /**
+     * @brief The number of bytes the chunk at offset occupies in the file.
+     */
+    virtual size_t chunkStorageSize(const NDSize &offset) const = 0;
+
+    /**
+     * @brief Read a chunk as stored in the file, without applying the filters.
+     *
+     * @param offset  The offset of the chunk in elements, aligned to the chunk shape.
+     * @param buffer  Buffer of at least chunkStorageSize(offset) bytes.
+     *
+     * @return The filter mask of the chunk.
+     */
+    virtual uint32_t readChunk(const NDSize &offset, void *buffer) const = 0;
+
+    /**
+     * @brief Set the number of threads used to compress chunks when writing data.
+     *
+     * @param threads  The number of threads, 0 disables parallel compression.
+     */
+    virtual void compressionThreads(size_t threads) = 0;
+
+    /**
+     * @brief The number of threads used to compress chunks when writing data.
+     */
+    virtual size_t compressionThreads() const = 0;
+
 
     virtual DataType dataType(void) const = 0;
 
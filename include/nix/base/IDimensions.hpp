@@ -147,6 +147,13 @@ public:
 
     virtual void labels(const none_t t) = 0;
 
+    /**
+     * @brief Looks up the indices of the first occurrences of the given labels.
+     *
+     * Missing labels get the index 0 and 0 in valid. Returns the number of labels found.
+     */
+    virtual size_t labelIndices(const std::vector<std::string> &labels, ndsize_t *indices, uint8_t *valid) const = 0;
+
 
     virtual ~ISetDimension() {}
 
@@ -14,6 +14,9 @@
 #include <nix/Platform.hpp>
 #include <nix/ObjectType.hpp>
 #include <nix/Compression.hpp>
+#include <nix/Repack.hpp>
+#include <nix/FileOptions.hpp>
+#include <nix/Statistics.hpp>
 
 #include <string>
 #include <vector>
@@ -23,11 +26,20 @@ namespace nix {
 
 /**
  * @brief File open modes
+ *
+ * SwmrWrite and SwmrRead open the file for single-writer/multiple-reader
+ * access: one process appends to existing DataArrays while others read the
+ * file concurrently. SwmrWrite creates the file if necessary, but only files
+ * created in this mode use the required (latest) file format. Entities created
+ * while in SwmrWrite mode are not guaranteed to be visible to readers, so the
+ * file structure should be set up before readers attach.
  */
 enum class FileMode {
     ReadOnly = 0,
     ReadWrite,
-    Overwrite
+    Overwrite,
+    SwmrWrite,
+    SwmrRead
 };
 
 /**
@@ -36,6 +48,8 @@ enum class FileMode {
 enum class OpenFlags {
     None  = 0,
     Force = 1 << 0,
+    InMemory = 1 << 1,     // keep the file in memory (HDF5 core driver)
+    BackingStore = 1 << 2, // with InMemory, write the file to disk on close
 };
 
 
@@ -67,6 +81,18 @@ public:
     virtual bool flush() = 0;
 
 
+    virtual std::vector<char> image() = 0;
+
+
+    virtual void repack(const std::string &target, const RepackOptions &options) = 0;
+
+
+    virtual IOStatistics statistics() const = 0;
+
+
+    virtual void resetStatistics() = 0;
+
+
     virtual ndsize_t blockCount() const = 0;
 
 
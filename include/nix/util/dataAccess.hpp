@@ -574,6 +574,33 @@ NIXAPI DEPRECATED std::vector<DataView> retrieveFeatureData(const MultiTag &tag,
 NIXAPI std::vector<DataView> featureData(const MultiTag &tag, std::vector<ndsize_t> position_indices,
                                          const Feature &feature, RangeMatch match = RangeMatch::Exclusive);
 
+/**
+ * @brief Reads the data of an indexed feature for the given MultiTag positions at once.
+ *
+ * For each requested position the respective row, i.e. the slice along the first
+ * dimension, of the feature's data is gathered into one NDArray. Unlike featureData,
+ * all rows are fetched with a single read: runs of consecutive indices are merged
+ * into contiguous selections and sparse indices are read as a point selection.
+ *
+ * @param tag              The MultiTag whos feature data is requested.
+ * @param position_indices A vector of position indices. If empty, all positions are used.
+ * @param feature          The feature, must have LinkType::Indexed.
+ *
+ * @return An NDArray whose first dimension runs along the requested positions.
+ */
+NIXAPI NDArray indexedFeatureData(const MultiTag &tag, std::vector<ndsize_t> position_indices, const Feature &feature);
+
+/**
+ * @brief Reads the data of an indexed feature for the given MultiTag positions at once.
+ *
+ * @param tag              The MultiTag whos feature data is requested.
+ * @param position_indices A vector of position indices. If empty, all positions are used.
+ * @param feature_index    The index of the desired feature. Default is 0.
+ *
+ * @return An NDArray whose first dimension runs along the requested positions.
+ */
+NIXAPI NDArray indexedFeatureData(const MultiTag &tag, std::vector<ndsize_t> position_indices, ndsize_t feature_index = 0);
+
 } //namespace util
 } //namespace nix
 #endif // NIX_DATAACCESS_H
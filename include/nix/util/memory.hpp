@@ -0,0 +1,134 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_MEMORY_H
+#define NIX_MEMORY_H
+
+#include <nix/Platform.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief The temporary memory used by calls of a data access function.
+ */
+struct TemporaryMemory {
+
+    uint64_t calls = 0;
+
+    /**
+     * @brief The largest number of bytes held at once by a single call.
+     */
+    size_t peak = 0;
+
+    /**
+     * @brief The calls that processed their data in parts to stay below the
+     * temporary memory limit.
+     */
+    uint64_t chunked = 0;
+};
+
+/**
+ * @brief Set a soft limit for the temporary memory of data access functions.
+ *
+ * Reading calibrated data (i.e. with a polynomial or expansion origin) into
+ * a type smaller than double, reading strings, reading rows out of order and
+ * resolving the positions of MultiTags need temporary buffers proportional to
+ * the amount of data. Above the limit these are processed in parts that fit
+ * into it; data that must be returned as a whole, e.g. the NDArray of
+ * indexedFeatureData, is not affected. The limit applies to the whole process.
+ *
+ * @param bytes  The limit in bytes, 0 for no limit.
+ */
+NIXAPI void setTemporaryMemoryLimit(size_t bytes);
+
+
+NIXAPI size_t temporaryMemoryLimit();
+
+/**
+ * @brief The temporary memory used per data access function, e.g.
+ * "DataArray::getData", since the last reset. Every thread accounts its own
+ * calls; they are merged here.
+ */
+NIXAPI std::map<std::string, TemporaryMemory> temporaryMemoryUsage();
+
+
+NIXAPI void resetTemporaryMemoryUsage();
+
+/**
+ * @brief Marks a call whose temporary memory is accounted. Scopes of nested
+ * calls are inactive, i.e. memory is accounted for the outermost call.
+ */
+class NIXAPI MemoryScope {
+
+public:
+
+    explicit MemoryScope(const char *name);
+
+
+    MemoryScope(const MemoryScope &other) = delete;
+
+
+    MemoryScope &operator=(const MemoryScope &other) = delete;
+
+
+    ~MemoryScope();
+
+private:
+
+    bool active;
+};
+
+/**
+ * @brief Accounts bytes of temporary memory for as long as it exists.
+ */
+class NIXAPI TemporaryAllocation {
+
+public:
+
+    explicit TemporaryAllocation(size_t bytes = 0);
+
+
+    TemporaryAllocation(const TemporaryAllocation &other) = delete;
+
+
+    TemporaryAllocation &operator=(const TemporaryAllocation &other) = delete;
+
+
+    void resize(size_t bytes);
+
+
+    ~TemporaryAllocation();
+
+private:
+
+    size_t size;
+};
+
+/**
+ * @brief Account memory that outlives the call, e.g. its result, in the peak
+ * of the current call.
+ */
+NIXAPI void noteAllocation(size_t bytes);
+
+/**
+ * @brief The number of parts of part_bytes each that fit into the temporary
+ * memory limit, at least 1, or count if there is no limit or all of them fit.
+ * Notes the current call as chunked if count does not fit.
+ */
+NIXAPI size_t partsWithinLimit(size_t count, size_t part_bytes);
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_MEMORY_H
@@ -46,12 +46,13 @@ bool Block::deleteSource(const Source &source) {
 }
 
 DataArray Block::createDataArray(const std::string &name, const std::string &type, nix::DataType data_type,
-                                 const NDSize &shape, const Compression &compression) {
+                                 const NDSize &shape, const CompressionOptions &compression,
+                                 const ChunkingOptions &chunking) {
     util::checkEntityNameAndType(name, type);
     if (hasDataArray(name)){
         throw DuplicateName("create DataArray");
     }
-    return backend()->createDataArray(name, type, data_type, shape, compression);
+    return backend()->createDataArray(name, type, data_type, shape, compression, chunking);
 }
 
 std::vector<DataArray> Block::dataArrays(const util::AcceptAll<DataArray>::type &filter) const {
@@ -7,10 +7,14 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/DataArray.hpp>
+#include <nix/util/memory.hpp>
 
 #include "hdf5/h5x/H5DataType.hpp"
 
 #include <cstring>
+#include <algorithm>
+#include <functional>
+#include <numeric>
 
 using namespace nix;
 
@@ -24,44 +28,194 @@ static void convertData(DataType source, DataType destination, void *data, size_
 }
 
 
-void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    const std::vector<double> poly = polynomCoefficients();
-    boost::optional<double> opt_origin = expansionOrigin();
+// Reads nrows rows of row_elms values each via read_rows(type, buffer, first_row, n_rows) and applies
+// the polynomial and the expansion origin of the DataArray, if any, before converting them to dtype.
+// Temporary buffers are filled in parts that fit into the temporary memory limit.
+template<typename F>
+static void readCalibrated(const DataArray &array, DataType dtype, void *data, size_t nrows, ndsize_t row_elms,
+                           F read_rows) {
+    const std::vector<double> poly = array.polynomCoefficients();
+    boost::optional<double> opt_origin = array.expansionOrigin();
+    size_t row_len = check::fits_in_size_t(row_elms, "Cannot read data. Buffer needed exceeds memory.");
 
     if (poly.size() || opt_origin) {
         size_t data_esize = data_type_to_size(dtype);
-        size_t nelms = check::fits_in_size_t(count.nelms(),
+        size_t nelms = check::fits_in_size_t(nrows * row_elms,
 			"Cannot apply polynom or origin transform. Buffer needed exceeds memory.");
-        std::vector<double> tmp;
-        double *read_buffer;
+        const double origin = opt_origin ? *opt_origin : 0.0;
 
-        if (data_esize < sizeof(double)) {
-            //need temporary buffer
-            tmp.resize(nelms);
-            read_buffer = tmp.data();
-        } else {
-            read_buffer = reinterpret_cast<double *>(data);
+        if (data_esize >= sizeof(double)) {
+            double *read_buffer = reinterpret_cast<double *>(data);
+            read_rows(DataType::Double, read_buffer, 0, nrows);
+            util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
+            convertData(DataType::Double, dtype, read_buffer, nelms);
+            return;
         }
 
-        getDataDirect(DataType::Double, read_buffer, count, offset);
-        const double origin = opt_origin ? *opt_origin : 0.0;
+        //need temporary buffer
+        size_t step = util::partsWithinLimit(nrows, row_len * sizeof(double));
+        std::vector<double> tmp(step * row_len);
+        util::TemporaryAllocation account(tmp.size() * sizeof(double));
 
-        util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
-        convertData(DataType::Double, dtype, read_buffer, nelms);
+        for (size_t first = 0; first < nrows; first += step) {
+            size_t n = std::min(step, nrows - first);
+            size_t part_elms = n * row_len;
+            read_rows(DataType::Double, tmp.data(), first, n);
+            util::applyPolynomial(poly, origin, tmp.data(), tmp.data(), part_elms);
+            convertData(DataType::Double, dtype, tmp.data(), part_elms);
+            memcpy(static_cast<char *>(data) + first * row_len * data_esize, tmp.data(), part_elms * data_esize);
+        }
 
-        if (tmp.size()) {
-            memcpy(data, read_buffer, nelms * data_esize);
+    } else if (dtype == DataType::String) {
+        // the backend buffers a pointer per string
+        size_t step = util::partsWithinLimit(nrows, row_len * sizeof(char *));
+        for (size_t first = 0; first < nrows; first += step) {
+            read_rows(dtype, static_cast<std::string *>(data) + first * row_len, first, std::min(step, nrows - first));
         }
 
     } else {
-        getDataDirect(dtype, data, count, offset);
+        read_rows(dtype, data, 0, nrows);
     }
 }
 
+
+void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    util::MemoryScope scope("DataArray::getData");
+
+    // rows along the first dimension
+    size_t nrows = count.size() > 0 ? check::fits_in_size_t(count[0], "Cannot read data. Buffer needed exceeds memory.") : 1;
+    ndsize_t row_elms = 1;
+    for (size_t i = 1; i < count.size(); i++) {
+        row_elms *= count[i];
+    }
+
+    readCalibrated(*this, dtype, data, nrows, row_elms, [&](DataType read_type, void *buffer, size_t first, size_t n) {
+        if (n == nrows) {
+            getDataDirect(read_type, buffer, count, offset);
+            return;
+        }
+
+        NDSize part_count(count), part_offset(offset);
+        part_count[0] = n;
+        part_offset[0] += first;
+        getDataDirect(read_type, buffer, part_count, part_offset);
+    });
+}
+
 void DataArray::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
     setDataDirect(dtype, data, count, offset);
 }
 
+NDSize DataArray::chunkGrid() const {
+    NDSize chunks = chunkShape();
+    if (!chunks) {
+        return chunks;
+    }
+
+    NDSize extent = dataExtent();
+    NDSize grid(chunks.size());
+    for (size_t i = 0; i < chunks.size(); i++) {
+        grid[i] = (extent[i] + chunks[i] - 1) / chunks[i];
+    }
+    return grid;
+}
+
+
+uint32_t DataArray::readChunk(const NDSize &offset, std::vector<char> &buffer) const {
+    buffer.resize(chunkStorageSize(offset));
+    if (buffer.empty()) {
+        return 0;
+    }
+    return backend()->readChunk(offset, buffer.data());
+}
+
+
+// Copies the rows unique_rows[begin, end), which are stored in part, to the positions of the
+// requested rows; order sorts the requested rows and next is the first one that was not copied yet.
+template<typename T>
+static void scatterRows(const T *part, T *out, size_t row_len, const std::vector<ndsize_t> &unique_rows,
+                        size_t begin, size_t end, const std::vector<ndsize_t> &rows,
+                        const std::vector<size_t> &order, size_t &next) {
+    for (size_t u = begin; next < order.size(); next++) {
+        while (unique_rows[u] < rows[order[next]]) {
+            u++;
+        }
+        if (u >= end) {
+            break;
+        }
+        std::copy_n(part + (u - begin) * row_len, row_len, out + order[next] * row_len);
+    }
+}
+
+
+void DataArray::getDataRows(DataType dtype, void *data, const std::vector<ndsize_t> &rows) const {
+    if (rows.empty()) {
+        return;
+    }
+
+    util::MemoryScope scope("DataArray::getDataRows");
+
+    NDSize extent = dataExtent();
+    if (!extent) {
+        throw InvalidRank("Cannot read rows of 0-dimensional data");
+    }
+
+    ndsize_t row_elms = 1;
+    for (size_t i = 1; i < extent.size(); i++) {
+        row_elms *= extent[i];
+    }
+
+    // reads sorted_rows[begin, end)
+    auto read_rows = [&](void *buffer, const std::vector<ndsize_t> &sorted_rows, size_t begin, size_t end) {
+        readCalibrated(*this, dtype, buffer, end - begin, row_elms, [&](DataType read_type, void *b, size_t first, size_t n) {
+            if (begin == 0 && n == sorted_rows.size()) {
+                backend()->readRows(read_type, b, sorted_rows);
+                return;
+            }
+            std::vector<ndsize_t> part(sorted_rows.begin() + begin + first, sorted_rows.begin() + begin + first + n);
+            backend()->readRows(read_type, b, part);
+        });
+    };
+
+    if (std::adjacent_find(rows.begin(), rows.end(), std::greater_equal<ndsize_t>()) == rows.end()) {
+        read_rows(data, rows, 0, rows.size());
+        return;
+    }
+
+    // unsorted or repeated rows: read every row once, in parts that fit into
+    // the temporary memory limit, and scatter each part
+    std::vector<ndsize_t> unique_rows(rows);
+    std::sort(unique_rows.begin(), unique_rows.end());
+    unique_rows.erase(std::unique(unique_rows.begin(), unique_rows.end()), unique_rows.end());
+
+    // the requested rows in the order they are read
+    std::vector<size_t> order(rows.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&rows](size_t a, size_t b) { return rows[a] < rows[b]; });
+    util::TemporaryAllocation account_index((unique_rows.size() + rows.size()) * sizeof(size_t));
+
+    size_t row_len = check::fits_in_size_t(row_elms, "Cannot read rows. Buffer needed exceeds memory.");
+    size_t row_bytes = row_len * (dtype == DataType::String ? sizeof(std::string) : data_type_to_size(dtype));
+    size_t step = util::partsWithinLimit(unique_rows.size(), row_bytes);
+
+    size_t next = 0;
+    for (size_t begin = 0; begin < unique_rows.size(); begin += step) {
+        size_t end = std::min(begin + step, unique_rows.size());
+
+        if (dtype == DataType::String) {
+            std::vector<std::string> tmp((end - begin) * row_len);
+            util::TemporaryAllocation account(tmp.size() * sizeof(std::string));
+            read_rows(tmp.data(), unique_rows, begin, end);
+            scatterRows(tmp.data(), static_cast<std::string *>(data), row_len, unique_rows, begin, end, rows, order, next);
+        } else {
+            std::vector<unsigned char> tmp((end - begin) * row_bytes);
+            util::TemporaryAllocation account(tmp.size());
+            read_rows(tmp.data(), unique_rows, begin, end);
+            scatterRows(tmp.data(), static_cast<unsigned char *>(data), row_bytes, unique_rows, begin, end, rows, order, next);
+        }
+    }
+}
+
 void DataArray::appendData(DataType dtype, const void *data, const NDSize &count, size_t axis) {
 
     //first some sanity checks
@@ -9,6 +9,8 @@
 #include <nix/Dimensions.hpp>
 
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 #include <nix/DataArray.hpp>
 #include <nix/util/util.hpp>
 #include <nix/Exception.hpp>
@@ -285,15 +287,159 @@ std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> SampledDimension::in
         throw runtime_error("Dimension::IndexOf - Number of start and end positions must match!");
     }
 
-    std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> indices;
+    size_t count = start_positions.size();
+    std::vector<ndsize_t> starts(count), ends(count);
+    std::vector<uint8_t> valid(count);
+    indexOf(start_positions.data(), end_positions.data(), count, range_matching,
+            starts.data(), ends.data(), valid.data());
+
+    std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> indices(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (valid[i]) {
+            indices[i] = std::pair<ndsize_t, ndsize_t>(starts[i], ends[i]);
+        }
+    }
+    return indices;
+}
+
+
+size_t SampledDimension::indexOf(const double *start_positions, const double *end_positions, size_t count, RangeMatch match,
+                                 ndsize_t *start_indices, ndsize_t *end_indices, uint8_t *valid) const {
     double offset = backend()->offset() ? *(backend()->offset()) : 0.0;
     double sampling_interval = backend()->samplingInterval();
-    for (size_t i = 0; i < start_positions.size(); ++i) {
-        indices.push_back(indexOf(start_positions[i], end_positions[i], sampling_interval, offset, range_matching));
+    return indexOf(start_positions, end_positions, count, sampling_interval, offset, match,
+                   start_indices, end_indices, valid);
+}
+
+
+// Same rules as getSampledIndex: the start is matched with GreaterOrEqual, the end with
+// LessOrEqual (inclusive) or Less (exclusive).
+static bool sampledRange(double start, double end, double sampling_interval, double offset, double exclusive,
+                         ndsize_t &start_index, ndsize_t &end_index) {
+    double si = ceil((start - offset) / sampling_interval);
+    si = si < 0.0 ? 0.0 : si;
+    double ei = floor((end - offset) / sampling_interval);
+    const bool on_sample = fabs(ei * sampling_interval + offset - end) <= numeric_limits<double>::epsilon();
+    ei -= on_sample ? exclusive : 0.0;
+
+    const bool ok = (start <= end) & (end >= offset) & (ei >= 0.0) & (si <= ei);
+    start_index = ok ? static_cast<ndsize_t>(si) : 0;
+    end_index = ok ? static_cast<ndsize_t>(ei) : 0;
+    return ok;
+}
+
+
+// 2^52: adding it to a double in [0, 2^52) rounds the double to an integer, which
+// is then held by the low bits of the sum
+static const double ROUND_SHIFT = 4503599627370496.0;
+// quotients from 2^51 on are left to sampledRange, so that rounding up stays below 2^52
+static const double ROUND_LIMIT = 2251799813685248.0;
+
+
+static inline uint64_t doubleBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+
+static inline double bitsDouble(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+// The helpers below compare without comparisons: they return 0 or 1 and compile to plain
+// integer arithmetic, which the compiler neither turns into branches nor needs 64 bit
+// vector compares for.
+
+// 1 if a < b, both must be below 2^63
+static inline uint64_t lessBits(uint64_t a, uint64_t b) {
+    return (a - b) >> 63;
+}
+
+
+static inline uint64_t signBit(double value) {
+    return doubleBits(value) >> 63;
+}
+
+
+static inline uint64_t magnitudeBits(double value) {
+    return doubleBits(value) & 0x7fffffffffffffffULL;
+}
+
+
+// 1 if value < 0 or NaN, -0.0 is not negative
+static inline uint64_t negativeOrNaN(double value) {
+    const uint64_t magnitude = magnitudeBits(value);
+    return (signBit(value) & lessBits(0, magnitude)) | lessBits(doubleBits(INFINITY), magnitude);
+}
+
+
+size_t SampledDimension::indexOf(const double *start_positions, const double *end_positions, size_t count,
+                                 double sampling_interval, double offset, RangeMatch match,
+                                 ndsize_t *start_indices, ndsize_t *end_indices, uint8_t *valid) {
+    const uint64_t exclusive = match == RangeMatch::Exclusive ? 1 : 0;
+    const uint64_t eps_bits = doubleBits(numeric_limits<double>::epsilon());
+    const uint64_t shift_bits = doubleBits(ROUND_SHIFT);
+    const uint64_t limit_bits = doubleBits(ROUND_LIMIT);
+    const uint64_t one_bits = doubleBits(1.0);
+    size_t valid_count = 0;
+    size_t large_count = 0;
+
+    // sampledRange with additions, divisions and integer arithmetic only, so that the loop
+    // can be vectorized: ceil and floor round by adding ROUND_SHIFT and correct the result
+    // by the sign of the remainder. The divisions stay, a reciprocal of the sampling interval
+    // would not always give the quotients of the per range overload.
+    for (size_t i = 0; i < count; ++i) {
+        const double start = start_positions[i];
+        const double end = end_positions[i];
+        const double qs = (start - offset) / sampling_interval;
+        const double qe = (end - offset) / sampling_interval;
+        const uint64_t large = ((signBit(qs) | lessBits(doubleBits(qs), limit_bits)) ^ 1) |
+                               ((signBit(qe) | lessBits(doubleBits(qe), limit_bits)) ^ 1);
+        const uint64_t keep = large - 1;
+
+        // negative starts are clamped to 0, negative ends are invalid anyway
+        const double xs = bitsDouble(doubleBits(qs) & (signBit(qs) - 1) & keep);
+        const double xe = bitsDouble(doubleBits(qe) & (signBit(qe) - 1) & keep);
+        const double rs = (xs + ROUND_SHIFT) - ROUND_SHIFT;
+        const double re = (xe + ROUND_SHIFT) - ROUND_SHIFT;
+        const uint64_t si = doubleBits(rs + ROUND_SHIFT) - shift_bits + signBit(rs - xs);
+        const uint64_t below = signBit(xe - re);
+        const double floor_e = re - bitsDouble((0 - below) & one_bits);
+
+        const double distance = fabs(floor_e * sampling_interval + offset - end);
+        const uint64_t on_sample = lessBits(eps_bits, magnitudeBits(distance)) ^ 1;
+        const uint64_t ei = doubleBits(re + ROUND_SHIFT) - shift_bits - below - (on_sample & exclusive);
+
+        const uint64_t ok = (negativeOrNaN(end - start) | negativeOrNaN(end - offset) | negativeOrNaN(qe) |
+                             lessBits(doubleBits(INFINITY), magnitudeBits(qs)) | (ei >> 63) | lessBits(ei, si) |
+                             large) ^ 1;
+        const uint64_t ok_mask = 0 - ok;
+        start_indices[i] = si & ok_mask;
+        end_indices[i] = ei & ok_mask;
+        valid[i] = static_cast<uint8_t>(ok);
+        valid_count += ok;
+        large_count += large;
     }
-    return indices;
+
+    for (size_t i = 0; large_count > 0 && i < count; ++i) {
+        const double qs = (start_positions[i] - offset) / sampling_interval;
+        const double qe = (end_positions[i] - offset) / sampling_interval;
+        if (qs >= ROUND_LIMIT || qe >= ROUND_LIMIT) {
+            bool ok = sampledRange(start_positions[i], end_positions[i], sampling_interval, offset,
+                                   static_cast<double>(exclusive), start_indices[i], end_indices[i]);
+            valid[i] = static_cast<uint8_t>(ok);
+            valid_count += ok;
+            large_count--;
+        }
+    }
+    return valid_count;
 }
 
+
 std::vector<std::pair<ndsize_t, ndsize_t>> SampledDimension::indexOf(const std::vector<double> &start_positions,
                                                                      const std::vector<double> &end_positions) const {
     if (start_positions.size() != end_positions.size()) {
@@ -336,6 +482,20 @@ vector<double> SampledDimension::axis(const ndsize_t count, const ndsize_t start
 }
 
 
+SampledAxis SampledDimension::axisView(const ndsize_t count, const ndsize_t startIndex) const {
+    double offset =  backend()->offset() ? *(backend()->offset()) : 0.0;
+    return SampledAxis(backend()->samplingInterval(), offset, count, startIndex);
+}
+
+
+double SampledAxis::at(ndsize_t index) const {
+    if (index >= count) {
+        throw nix::OutOfBounds("SampledAxis::at: index is out of bounds!", index);
+    }
+    return (*this)[index];
+}
+
+
 SampledDimension& SampledDimension::operator=(const SampledDimension &other) {
     shared_ptr<ISampledDimension> tmp(other.impl());
     if (impl() != tmp) {
@@ -386,7 +546,7 @@ SetDimension::SetDimension(const SetDimension &other)
 }
 
 
-boost::optional<ndsize_t> getSetIndex(const double position, std::vector<std::string> labels, const PositionMatch match) {
+boost::optional<ndsize_t> getSetIndex(const double position, const std::vector<std::string> &labels, const PositionMatch match) {
     boost::optional<ndsize_t> index;
     if (position < 0 && (match != PositionMatch::Greater && match != PositionMatch::GreaterOrEqual)) {
         return index;
@@ -433,8 +593,34 @@ boost::optional<ndsize_t> getSetIndex(const double position, std::vector<std::st
 
 
 boost::optional<ndsize_t> SetDimension::indexOf(const double position, const PositionMatch match) const {
-    std::vector<std::string> lbls = labels();
-    return getSetIndex(position, lbls, match);
+    return getSetIndex(position, labels(), match);
+}
+
+
+boost::optional<ndsize_t> SetDimension::indexOf(const std::string &label) const {
+    ndsize_t index;
+    uint8_t valid;
+    backend()->labelIndices(std::vector<std::string>(1, label), &index, &valid);
+    return valid ? boost::optional<ndsize_t>(index) : boost::none;
+}
+
+
+std::vector<boost::optional<ndsize_t>> SetDimension::indexOf(const std::vector<std::string> &labels) const {
+    std::vector<ndsize_t> found(labels.size());
+    std::vector<uint8_t> valid(labels.size());
+    backend()->labelIndices(labels, found.data(), valid.data());
+    std::vector<boost::optional<ndsize_t>> indices(labels.size());
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (valid[i]) {
+            indices[i] = found[i];
+        }
+    }
+    return indices;
+}
+
+
+size_t SetDimension::indexOf(const std::vector<std::string> &labels, ndsize_t *indices, uint8_t *valid) const {
+    return backend()->labelIndices(labels, indices, valid);
 }
 
 
@@ -486,7 +672,6 @@ SetDimension& SetDimension::operator=(const SetDimension &other) {
     if (impl() != tmp) {
         std::swap(impl(), tmp);
     }
-
     return *this;
 }
 
@@ -729,6 +914,39 @@ vector<double> RangeDimension::axis(const ndsize_t count, const ndsize_t startIn
 }
 
 
+RangeAxis RangeDimension::axisView(const ndsize_t count, const ndsize_t startIndex, size_t chunk_size) const {
+    return RangeAxis(*this, count, startIndex, chunk_size);
+}
+
+
+RangeAxis::RangeAxis(const RangeDimension &dimension, ndsize_t count, ndsize_t start_index, size_t chunk_size)
+    : dimension(dimension), count(count), start(start_index), chunk_size(chunk_size), buffer_start(0)
+{
+    if (chunk_size == 0) {
+        throw std::invalid_argument("RangeAxis: chunk size must be larger than zero!");
+    }
+}
+
+
+void RangeAxis::load(ndsize_t index) const {
+    if (index >= count) {
+        throw nix::OutOfBounds("RangeAxis: index is out of bounds!", index);
+    }
+    ndsize_t first = index - index % chunk_size;
+    size_t n = static_cast<size_t>(std::min<ndsize_t>(chunk_size, count - first));
+    buffer = dimension.ticks(start + first, n);
+    buffer_start = first;
+}
+
+
+double RangeAxis::at(ndsize_t index) const {
+    if (index >= count) {
+        throw nix::OutOfBounds("RangeAxis::at: index is out of bounds!", index);
+    }
+    return (*this)[index];
+}
+
+
 RangeDimension& RangeDimension::operator=(const RangeDimension &other) {
     shared_ptr<IRangeDimension> tmp(other.impl());
 
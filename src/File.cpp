@@ -26,14 +26,27 @@ File File::open(const std::string &name,
                 const std::string &impl,
                 Compression compression,
                 OpenFlags flags) {
+    return open(name, mode, FileOptions(), impl, compression, flags);
+}
+
+
+File File::open(const std::string &name,
+                FileMode mode,
+                const FileOptions &options,
+                const std::string &impl,
+                Compression compression,
+                OpenFlags flags) {
     if (mode == nix::FileMode::ReadOnly && !bfs::exists(bfs::path{name})) {
         throw std::runtime_error("Cannot open non-existent file in ReadOnly mode!");
     }
+    if (mode == nix::FileMode::SwmrRead && !bfs::exists(bfs::path{name})) {
+        throw std::runtime_error("Cannot open non-existent file in SwmrRead mode!");
+    }
     if (compression == Compression::Auto) {
          compression = Compression::None;
     }
     if (impl == "hdf5") {
-        return File(std::make_shared<hdf5::FileHDF5>(name, mode, compression, flags));
+        return File(std::make_shared<hdf5::FileHDF5>(name, mode, compression, flags, options));
     }
 #ifdef  ENABLE_FS_BACKEND
     else if (impl == "file") {
@@ -46,6 +59,32 @@ File File::open(const std::string &name,
 }
 
 
+File File::openImage(const void *image,
+                     size_t size,
+                     FileMode mode,
+                     const std::string &impl,
+                     Compression compression,
+                     OpenFlags flags) {
+    if (compression == Compression::Auto) {
+         compression = Compression::None;
+    }
+    if (impl == "hdf5") {
+        return File(std::make_shared<hdf5::FileHDF5>(image, size, mode, compression, flags));
+    } else {
+        throw std::runtime_error("Unknown implementation!");
+    }
+}
+
+
+void File::repack(const std::string &target, const RepackOptions &options) {
+    bfs::path target_path{target}, location_path{location()};
+    if (bfs::exists(target_path) && bfs::exists(location_path) && bfs::equivalent(target_path, location_path)) {
+        throw std::invalid_argument("File::repack: the target must not be the file itself!");
+    }
+    backend()->repack(target, options);
+}
+
+
 bool File::flush() {
     return backend()->flush();
 }
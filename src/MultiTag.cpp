@@ -14,6 +14,14 @@
 
 namespace nix {
 
+static ndsize_t rowWidth(const NDSize &shape) {
+    ndsize_t width = 1;
+    for (size_t i = 1; i < shape.size(); i++) {
+        width *= shape[i];
+    }
+    return width;
+}
+
 
 void MultiTag::positions(const DataArray &positions) {
     if (!util::checkEntityInput(positions)) {
@@ -46,6 +54,57 @@ void MultiTag::extents(const std::string &name_or_id) {
 }
 
 
+void MultiTag::positionsAndExtents(const std::vector<ndsize_t> &indices,
+                                   std::vector<std::vector<double>> &positions_out,
+                                   std::vector<std::vector<double>> &extents_out) const {
+    DataArray pos = positions();
+    DataArray ext = extents();
+    if (!pos) {
+        throw UninitializedEntity();
+    }
+    NDSize pos_shape = pos.dataExtent();
+    NDSize ext_shape = ext ? ext.dataExtent() : NDSize{};
+    if (!pos_shape) {
+        throw InvalidRank("MultiTag positions must have at least one dimension");
+    }
+
+    std::vector<ndsize_t> rows;
+    rows.reserve(indices.size());
+    for (ndsize_t index : indices) {
+        if (index >= pos_shape[0] || (ext && (!ext_shape || index >= ext_shape[0]))) {
+            throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+        }
+        rows.push_back(index);
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // one bulk read per DataArray for all distinct rows
+    const size_t pw = static_cast<size_t>(rowWidth(pos_shape));
+    const size_t ew = ext ? static_cast<size_t>(rowWidth(ext_shape)) : 0;
+    std::vector<double> pos_rows(rows.size() * pw);
+    std::vector<double> ext_rows(rows.size() * ew);
+    if (rows.size()) {
+        pos.getDataRows(DataType::Double, pos_rows.data(), rows);
+        if (ext) {
+            ext.getDataRows(DataType::Double, ext_rows.data(), rows);
+        }
+    }
+
+    positions_out.assign(pw, std::vector<double>(indices.size()));
+    extents_out.assign(pw, std::vector<double>(indices.size(), 0.0));
+    for (size_t i = 0; i < indices.size(); i++) {
+        size_t row = std::lower_bound(rows.begin(), rows.end(), indices[i]) - rows.begin();
+        for (size_t d = 0; d < pw; d++) {
+            positions_out[d][i] = pos_rows[row * pw + d];
+            if (d < ew) {
+                extents_out[d][i] = ext_rows[row * ew + d];
+            }
+        }
+    }
+}
+
+
 void MultiTag::units(const std::vector<std::string> &units) {
     std::vector<std::string> sanitized;
     sanitized.reserve(units.size());
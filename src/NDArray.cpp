@@ -8,20 +8,316 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/NDArray.hpp>
+#include <nix/util/memory.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 namespace nix {
 
+namespace {
+
+void *aligned_allocate(size_t bytes, size_t alignment) {
+    alignment = std::max(alignment, sizeof(void *));
+#ifdef _WIN32
+    void *ptr = _aligned_malloc(bytes, alignment);
+#else
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, bytes) != 0) {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+
+void aligned_free(void *ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+
+class HeapAllocator : public NDArrayAllocator {
+
+public:
+
+    void *allocate(size_t bytes, size_t alignment) {
+        return aligned_allocate(bytes, alignment);
+    }
+
+
+    void deallocate(void *ptr, size_t bytes, size_t alignment) {
+        aligned_free(ptr);
+    }
+};
+
+
+size_t size_class(size_t bytes) {
+    size_t size = 64;
+    while (size < bytes) {
+        size *= 2;
+    }
+    return size;
+}
+
+
+// the largest power of two (up to a page) that ptr is a multiple of
+size_t pointer_alignment(const void *ptr) {
+    uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    if (addr == 0) {
+        return NDArray::default_alignment;
+    }
+    return std::min<size_t>(addr & (~addr + 1), 4096);
+}
+
+} // anonymous namespace
+
+
+std::shared_ptr<NDArrayAllocator> defaultNDArrayAllocator() {
+    static std::shared_ptr<NDArrayAllocator> heap = std::make_shared<HeapAllocator>();
+    return heap;
+}
+
+
+NDArrayPool::NDArrayPool(size_t max_cached, const std::shared_ptr<NDArrayAllocator> &upstream)
+    : upstream(upstream ? upstream : defaultNDArrayAllocator()), max_cached(max_cached), cached(0),
+      n_hits(0), n_misses(0)
+{
+}
+
+
+void *NDArrayPool::allocate(size_t bytes, size_t alignment) {
+    const std::pair<size_t, size_t> key(size_class(bytes), alignment);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = free_buffers.find(key);
+        if (it != free_buffers.end() && !it->second.empty()) {
+            void *ptr = it->second.back();
+            it->second.pop_back();
+            cached -= key.first;
+            n_hits++;
+            return ptr;
+        }
+        n_misses++;
+    }
+    return upstream->allocate(key.first, alignment);
+}
+
+
+void NDArrayPool::deallocate(void *ptr, size_t bytes, size_t alignment) {
+    const std::pair<size_t, size_t> key(size_class(bytes), alignment);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cached + key.first <= max_cached) {
+            free_buffers[key].push_back(ptr);
+            cached += key.first;
+            return;
+        }
+    }
+    upstream->deallocate(ptr, key.first, alignment);
+}
+
+
+size_t NDArrayPool::cachedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cached;
+}
+
+
+uint64_t NDArrayPool::hits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return n_hits;
+}
+
+
+uint64_t NDArrayPool::misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return n_misses;
+}
+
+
+void NDArrayPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &entry : free_buffers) {
+        for (void *ptr : entry.second) {
+            upstream->deallocate(ptr, entry.first.first, entry.first.second);
+        }
+    }
+    free_buffers.clear();
+    cached = 0;
+}
+
+
+NDArrayPool::~NDArrayPool() {
+    clear();
+}
+
+/* ******************************************* */
+
+const size_t NDArray::default_alignment;
+
 
-NDArray::NDArray(DataType dtype, NDSize dims) : dataType(dtype), extends(dims) {
+NDArray::NDArray(DataType dtype, NDSize dims)
+    : NDArray(dtype, dims, defaultNDArrayAllocator())
+{
+}
+
+
+NDArray::NDArray(DataType dtype, NDSize dims, const std::shared_ptr<NDArrayAllocator> &allocator, size_t alignment)
+    : dataType(dtype), extends(dims), allocator(allocator ? allocator : defaultNDArrayAllocator()),
+      dstore(nullptr), store_size(0), store_capacity(0), align(alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        throw std::invalid_argument("NDArray: alignment must be a power of two");
+    }
     allocate_space();
 }
 
 
+NDArray::NDArray(DataType dtype, NDSize dims, void *data, std::function<void(void *)> deleter)
+    : dataType(dtype), extends(dims), deleter(deleter), dstore(static_cast<byte_type *>(data)),
+      store_size(0), store_capacity(0), align(pointer_alignment(data))
+{
+    ndsize_t bytes = extends.nelms() * data_type_to_size(dataType);
+    store_size = store_capacity = check::fits_in_size_t(bytes, "Cannot use storage (exceeds memory)");
+    calc_strides();
+}
+
+
+NDArray NDArray::adopt(DataType dtype, NDSize dims, void *data, std::function<void(void *)> deleter) {
+    if (!deleter) {
+        throw std::invalid_argument("NDArray::adopt: a deleter is required");
+    }
+    return NDArray(dtype, dims, data, deleter);
+}
+
+
+NDArray NDArray::borrow(DataType dtype, NDSize dims, void *data) {
+    return NDArray(dtype, dims, data, std::function<void(void *)>());
+}
+
+
+NDArray::NDArray(const NDArray &other)
+    : dataType(other.dataType), extends(other.extends), strides(other.strides),
+      allocator(other.allocator ? other.allocator : defaultNDArrayAllocator()),
+      dstore(nullptr), store_size(0), store_capacity(0),
+      align(other.allocator ? other.align : static_cast<size_t>(default_alignment))
+{
+    if (other.store_size > 0) {
+        dstore = static_cast<byte_type *>(allocator->allocate(other.store_size, align));
+        store_size = store_capacity = other.store_size;
+        memcpy(dstore, other.dstore, store_size);
+        util::noteAllocation(store_size);
+    }
+}
+
+
+NDArray::NDArray(NDArray &&other)
+    : dataType(other.dataType), dstore(nullptr), store_size(0), store_capacity(0), align(default_alignment)
+{
+    take(other);
+}
+
+
+NDArray &NDArray::operator=(const NDArray &other) {
+    if (this != &other) {
+        NDArray copy(other);
+        release();
+        take(copy);
+    }
+    return *this;
+}
+
+
+NDArray &NDArray::operator=(NDArray &&other) {
+    if (this != &other) {
+        release();
+        take(other);
+    }
+    return *this;
+}
+
+
+NDArray::~NDArray() {
+    release();
+}
+
+
+void NDArray::release() {
+    if (dstore != nullptr) {
+        if (allocator) {
+            allocator->deallocate(dstore, store_capacity, align);
+        } else if (deleter) {
+            deleter(dstore);
+        }
+    }
+    deleter = nullptr;
+    dstore = nullptr;
+    store_size = store_capacity = 0;
+}
+
+
+void NDArray::take(NDArray &other) {
+    dataType = other.dataType;
+    extends = std::move(other.extends);
+    strides = std::move(other.strides);
+    allocator = std::move(other.allocator);
+    deleter = std::move(other.deleter);
+    dstore = other.dstore;
+    store_size = other.store_size;
+    store_capacity = other.store_capacity;
+    align = other.align;
+
+    other.allocator = defaultNDArrayAllocator();
+    other.deleter = nullptr;
+    other.dstore = nullptr;
+    other.store_size = other.store_capacity = 0;
+}
+
+
 void NDArray::allocate_space() {
     size_t type_size = data_type_to_size(dataType);
 	ndsize_t bytes = extends.nelms() * type_size;
 	size_t alloc_size = check::fits_in_size_t(bytes, "Cannot allocate storage (exceeds memory)");
-    dstore.resize(alloc_size);
+
+    if (alloc_size > store_capacity) {
+        if (borrowed()) {
+            throw std::length_error("NDArray: cannot grow borrowed storage");
+        }
+
+        // adopted storage is replaced by storage of the default allocator
+        std::shared_ptr<NDArrayAllocator> alloc = allocator ? allocator : defaultNDArrayAllocator();
+        size_t alloc_align = allocator ? align : static_cast<size_t>(default_alignment);
+        byte_type *grown = static_cast<byte_type *>(alloc->allocate(alloc_size, alloc_align));
+        if (store_size > 0) {
+            memcpy(grown, dstore, store_size);
+        }
+        memset(grown + store_size, 0, alloc_size - store_size);
+
+        size_t kept = store_size;
+        release();
+        allocator = alloc;
+        align = alloc_align;
+        dstore = grown;
+        store_size = kept;
+        store_capacity = alloc_size;
+        util::noteAllocation(alloc_size);
+    } else if (alloc_size > store_size) {
+        memset(dstore + store_size, 0, alloc_size - store_size);
+    }
+    store_size = alloc_size;
 
     calc_strides();
 }
@@ -0,0 +1,113 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Trace.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+
+namespace nix {
+
+namespace {
+
+std::atomic<bool> tracing(false);
+std::mutex sink_mutex;
+std::shared_ptr<TraceSink> the_sink;
+
+
+std::string json_escape(const std::string &str) {
+    std::string res;
+    res.reserve(str.size());
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            res += buf;
+        } else {
+            res += c;
+        }
+    }
+    return res;
+}
+
+} // anonymous namespace
+
+
+void setTraceSink(const std::shared_ptr<TraceSink> &sink) {
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    the_sink = sink;
+    tracing = static_cast<bool>(sink);
+}
+
+
+std::shared_ptr<TraceSink> traceSink() {
+    if (!tracing.load(std::memory_order_relaxed)) {
+        return std::shared_ptr<TraceSink>();
+    }
+
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    return the_sink;
+}
+
+
+ChromeTraceSink::ChromeTraceSink(const std::string &path)
+    : out(path), origin(std::chrono::steady_clock::now())
+{
+    if (!out) {
+        throw std::runtime_error("ChromeTraceSink: Could not open " + path);
+    }
+    out << "{\"traceEvents\":[";
+}
+
+
+void ChromeTraceSink::begin(const TraceEvent &event) {
+    // events are written as complete ("X") events once they end
+}
+
+
+void ChromeTraceSink::end(const TraceEvent &event) {
+    std::chrono::duration<double, std::micro> ts = event.start - origin;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!out.is_open()) {
+        return;
+    }
+
+    auto tid = threads.emplace(std::this_thread::get_id(), threads.size() + 1).first->second;
+
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << "{\"name\":\"" << json_escape(event.name) << "\",\"cat\":\"" << event.category
+        << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+        << ",\"ts\":" << ts.count() << ",\"dur\":" << event.duration * 1e6
+        << ",\"args\":{\"entity\":\"" << json_escape(event.entity) << "\"";
+    if (event.bytes > 0) {
+        out << ",\"bytes\":" << event.bytes;
+    }
+    out << "}}";
+}
+
+
+void ChromeTraceSink::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (out.is_open()) {
+        out << "\n]}\n";
+        out.close();
+    }
+}
+
+
+ChromeTraceSink::~ChromeTraceSink() {
+    close();
+}
+
+} // namespace nix
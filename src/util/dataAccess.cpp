@@ -9,6 +9,7 @@
 #include <nix/util/dataAccess.hpp>
 
 #include <nix/util/util.hpp>
+#include <nix/util/memory.hpp>
 
 #include <string>
 #include <cstdlib>
@@ -409,80 +410,45 @@ void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, N
 }
 
 
-void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector<ndsize_t> &indices,
-                       vector<NDSize> &offsets, vector<NDSize> &counts, RangeMatch match) {
-    DataArray positions = tag.positions();
-    DataArray extents = tag.extents();
-    NDSize position_size, extent_size;
-    ndsize_t dimension_count = array.dimensionCount();
-    vector<Dimension> dimensions = array.dimensions();
-    vector<string> units = tag.units();
+// the temporaries of getOffsetAndCount per position index and dimension
+static const size_t OFFSET_AND_COUNT_BYTES = 2 * sizeof(double) + sizeof(optional<pair<ndsize_t, ndsize_t>>) + sizeof(string);
 
-    while (units.size() < dimension_count) {
-        units.push_back("none");
-    }
-    vector<pair<double, double>> max_extents;
-    if (position_size.size() < dimension_count) {
-        max_extents = maximumExtents(array);
-    }
-    if (positions) {
-        position_size = positions.dataExtent();
-    }
-    if (extents) {
-        extent_size = extents.dataExtent();
-    }
-    ndsize_t max_index = *max_element(indices.begin(), indices.end());
-    if (max_index >= positions.dataExtent()[0] || (extents && max_index >= extents.dataExtent()[0])) {
-        throw OutOfBounds("Index out of bounds of positions or extents!", 0);
-    }
 
-    size_t dimcount_sizet = check::fits_in_size_t(dimension_count, "getOffsetAndCount() failed; dimension count > size_t.");
+static void offsetAndCountBatch(const MultiTag &tag, const vector<Dimension> &dimensions, const vector<string> &units,
+                                const vector<ndsize_t> &indices, const DataArray &array,
+                                vector<pair<double, double>> &max_extents,
+                                vector<NDSize> &offsets, vector<NDSize> &counts, RangeMatch match) {
+    size_t dimcount_sizet = dimensions.size();
+    TemporaryAllocation account(indices.size() * dimcount_sizet * OFFSET_AND_COUNT_BYTES);
 
-    NDSize temp_offset(positions.dataExtent().size(), static_cast<NDSize::value_type>(0));
-    NDSize temp_count(positions.dataExtent().size(), static_cast<NDSize::value_type>(1));
-
-    int dim_index = dimension_count > 1 ? 1 : 0;
-    ndsize_t count = dimension_count > 1 ? position_size[dim_index] : 1;
-    temp_count[dim_index] = static_cast<NDSize::value_type>(count);
-
-    vector<vector<double>> start_positions(dimension_count);
-    vector<vector<double>> end_positions(dimension_count);
-    vector<double> offset, extent;
-    for (size_t idx = 0; idx < indices.size(); ++idx) {
-        temp_offset[0] = indices[idx];
-        positions.getData(offset, temp_count, temp_offset);
-        if (extents) {
-            extents.getData(extent, temp_count, temp_offset);
-        } else {
-            extent.resize(offset.size(), 0.0);
-        }
-        // add pos/extents if missing
-        while (offset.size() < dimensions.size()) {
-            offset.push_back(get<0>(max_extents[offset.size()]));
-            extent.push_back(get<1>(max_extents[extent.size()]));
-        }
-        // throw away info, if not needed
-        while (offset.size() > dimensions.size()) {
-            offset.pop_back();
-            extent.pop_back();
-        }
+    // positions and extents of all requested indices, one vector per column
+    vector<vector<double>> start_positions, end_positions;
+    tag.positionsAndExtents(indices, start_positions, end_positions);
 
-        for (size_t dim_index = 0; dim_index < dimensions.size(); ++dim_index) {
-            if (idx == 0) {
-                start_positions[dim_index] = vector<double>(indices.size());
-                end_positions[dim_index] = vector<double>(indices.size());
-            }
-            start_positions[dim_index][idx] = offset[dim_index];
-            end_positions[dim_index][idx] = offset[dim_index] + extent[dim_index];
+    if (start_positions.size() < dimcount_sizet && max_extents.empty()) {
+        max_extents = maximumExtents(array);
+    }
+    // throw away info, if not needed
+    start_positions.resize(std::min(start_positions.size(), dimcount_sizet));
+    end_positions.resize(start_positions.size());
+    for (size_t dim_index = 0; dim_index < start_positions.size(); ++dim_index) {
+        for (size_t idx = 0; idx < indices.size(); ++idx) {
+            end_positions[dim_index][idx] += start_positions[dim_index][idx];
         }
     }
+    // add pos/extents if missing
+    while (start_positions.size() < dimcount_sizet) {
+        size_t dim_index = start_positions.size();
+        start_positions.emplace_back(indices.size(), get<0>(max_extents[dim_index]));
+        end_positions.emplace_back(indices.size(), get<0>(max_extents[dim_index]) + get<1>(max_extents[dim_index]));
+    }
 
     vector<vector<optional<pair<ndsize_t, ndsize_t>>>> data_indices;
     for (size_t dim_index = 0; dim_index < dimensions.size(); ++dim_index) {
         vector<string> temp_units(start_positions[dim_index].size(), units[dim_index]);
         vector<optional<pair<ndsize_t, ndsize_t>>> ranges = positionToIndex(start_positions[dim_index], end_positions[dim_index],
                                                                             temp_units, match, dimensions[dim_index]);
-                                                                          
+
         data_indices.push_back(ranges);
     }
     // at this point we do have all the start and end indices of the tagged positions that the caller wants the data of.
@@ -491,26 +457,59 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector
         NDSize data_offset(dimcount_sizet, 0);
         NDSize data_count(dimcount_sizet, 1);
         for (size_t dim_index =0; dim_index < dimensions.size(); ++dim_index) { // for each dimension
-            optional<pair<ndsize_t, ndsize_t>> opt_range = data_indices[dim_index][i];
+            const optional<pair<ndsize_t, ndsize_t>> &opt_range = data_indices[dim_index][i];
             if (opt_range) {
                 data_offset[dim_index] = (*opt_range).first;
                 ndsize_t count =  (*opt_range).second - (*opt_range).first;
                 data_count[dim_index] += count;
             } else {
                 if (end_positions[dim_index][i] == start_positions[dim_index][i]) {
-                    optional<ndsize_t> ofst = positionToIndex(end_positions[dim_index][i], units[dim_index], PositionMatch::GreaterOrEqual, dimensions[dim_index]);  
+                    optional<ndsize_t> ofst = positionToIndex(end_positions[dim_index][i], units[dim_index], PositionMatch::GreaterOrEqual, dimensions[dim_index]);
                     if (!ofst) {
                         throw nix::OutOfBounds("util::offsetAndCount:An invalid range was encountered!");
                     }
-                    temp_offset[i] = *ofst;
+                    data_offset[dim_index] = *ofst;
                 }
-            }   
+            }
         }
         offsets.push_back(data_offset);
         counts.push_back(data_count);
     }
 }
 
+
+void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector<ndsize_t> &indices,
+                       vector<NDSize> &offsets, vector<NDSize> &counts, RangeMatch match) {
+    MemoryScope scope("util::getOffsetAndCount");
+    ndsize_t dimension_count = array.dimensionCount();
+    vector<Dimension> dimensions = array.dimensions();
+    vector<string> units = tag.units();
+
+    while (units.size() < dimension_count) {
+        units.push_back("none");
+    }
+    if (indices.empty()) {
+        return;
+    }
+
+    size_t dimcount_sizet = check::fits_in_size_t(dimension_count, "getOffsetAndCount() failed; dimension count > size_t.");
+    offsets.reserve(offsets.size() + indices.size());
+    counts.reserve(counts.size() + indices.size());
+
+    // resolve the positions in batches that fit into the temporary memory limit
+    vector<pair<double, double>> max_extents;
+    size_t step = partsWithinLimit(indices.size(), std::max<size_t>(1, dimcount_sizet) * OFFSET_AND_COUNT_BYTES);
+    if (step == indices.size()) {
+        offsetAndCountBatch(tag, dimensions, units, indices, array, max_extents, offsets, counts, match);
+        return;
+    }
+
+    for (size_t first = 0; first < indices.size(); first += step) {
+        vector<ndsize_t> batch(indices.begin() + first, indices.begin() + std::min(first + step, indices.size()));
+        offsetAndCountBatch(tag, dimensions, units, batch, array, max_extents, offsets, counts, match);
+    }
+}
+
 void getOffsetAndCount(const MultiTag &tag, const DataArray &array, ndsize_t index, NDSize &offsets, NDSize &counts, RangeMatch match) {
     vector<NDSize> temp_offsets, temp_counts;
     getOffsetAndCount(tag, array, {index}, temp_offsets, temp_counts, match);
@@ -672,6 +671,7 @@ DataView taggedData(const MultiTag &tag, ndsize_t position_index,
 
 vector<DataView> taggedData(const MultiTag &tag, vector<ndsize_t> &position_indices,
                             const DataArray &array, RangeMatch match) {
+    MemoryScope scope("util::taggedData");
     vector<NDSize> counts, offsets;
     vector<DataView> views;
 
@@ -684,8 +684,9 @@ vector<DataView> taggedData(const MultiTag &tag, vector<ndsize_t> &position_indi
 
     getOffsetAndCount(tag, array, position_indices, offsets, counts, match);
 
+    NDSize extent = array.dataExtent();
     for (size_t i = 0; i < offsets.size(); ++i) {
-        if (!positionAndExtentInData(array, offsets[i], counts[i])) {
+        if (offsets[i].size() != extent.size() || !(offsets[i] + counts[i] <= extent)) {
             throw OutOfBounds("References data slice out of the extent of the DataArray!", 0);
         }
         DataView io = DataView(array, counts[i], offsets[i]);
@@ -840,25 +841,26 @@ std::vector<DataView> featureData(const MultiTag &tag, std::vector<ndsize_t> pos
         throw OutOfBounds("Index out of bounds of positions!", 0);
     }
 
+    NDSize data_extent = data.dataExtent();
     if (feature.linkType() == LinkType::Indexed) {
         // For now we return slices across the first dim.
+        NDSize count(data_extent);
+        count[0] = 1;
         for (size_t idx = 0; idx < position_indices.size(); ++idx) {
-            NDSize offset(data.dataExtent().size(), 0);
-            offset[0] = position_indices[idx];
-            NDSize count(data.dataExtent());
-            count[0] = 1;
-            if (!positionAndExtentInData(data, offset, count)) {
+            if (position_indices[idx] >= data_extent[0]) {
                 throw OutOfBounds("Requested data slice out of the extent of the Feature!",
                                   position_indices[idx]);
             }
+            NDSize offset(data_extent.size(), 0);
+            offset[0] = position_indices[idx];
             DataView io = DataView(data, count, offset);
             views.push_back(io);
         }
     } else {
         for (size_t idx = 0; idx < position_indices.size(); ++idx){
             // In the untagged case all data is returned for each position
-            NDSize offset(data.dataExtent().size(), 0);
-            DataView io = DataView(data, data.dataExtent(), offset);
+            NDSize offset(data_extent.size(), 0);
+            DataView io = DataView(data, data_extent, offset);
             views.push_back(io);
         }
     }
@@ -866,6 +868,55 @@ std::vector<DataView> featureData(const MultiTag &tag, std::vector<ndsize_t> pos
 }
 
 
+NDArray indexedFeatureData(const MultiTag &tag, std::vector<ndsize_t> position_indices, const Feature &feature) {
+    MemoryScope scope("util::indexedFeatureData");
+    DataArray data = feature.data();
+    if (data == nix::none) {
+        throw UninitializedEntity();
+    }
+    if (feature.linkType() != LinkType::Indexed) {
+        throw std::invalid_argument("indexedFeatureData() requires a feature with LinkType::Indexed!");
+    }
+
+    ndsize_t position_count = tag.positions().dataExtent()[0];
+    if (position_indices.size() < 1) {
+        size_t pos_count = check::fits_in_size_t(position_count, "Number of positions > size_t.");
+        position_indices.resize(pos_count);
+        std::iota(position_indices.begin(), position_indices.end(), 0);
+    }
+
+    NDSize shape = data.dataExtent();
+    if (!shape) {
+        throw InvalidRank("Indexed feature data must have at least one dimension");
+    }
+    for (size_t idx = 0; idx < position_indices.size(); ++idx) {
+        if (position_indices[idx] >= position_count) {
+            throw OutOfBounds("Index out of bounds of positions!", 0);
+        }
+        if (position_indices[idx] >= shape[0]) {
+            throw OutOfBounds("Requested data slice out of the extent of the Feature!",
+                              position_indices[idx]);
+        }
+    }
+
+    shape[0] = position_indices.size();
+    NDArray rows(data.dataType(), shape);
+    data.getDataRows(rows.dtype(), rows.data(), position_indices);
+    return rows;
+}
+
+
+NDArray indexedFeatureData(const MultiTag &tag, std::vector<ndsize_t> position_indices, ndsize_t feature_index) {
+    size_t feat_idx = check::fits_in_size_t(feature_index,
+                                            "indexedFeatureData() failed; feaure_index > size_t.");
+    if (feat_idx >= tag.featureCount()) {
+        throw OutOfBounds("Feature index out of bounds.", 0);
+    }
+    Feature feat = tag.getFeature(feat_idx);
+    return indexedFeatureData(tag, position_indices, feat);
+}
+
+
 std::vector<DataView> retrieveFeatureData(const MultiTag &tag, std::vector<ndsize_t> position_indices,
                                           const Feature &feature, RangeMatch match) {
     return featureData(tag, position_indices, feature, match);
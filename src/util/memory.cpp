@@ -0,0 +1,192 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/memory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+namespace {
+
+std::atomic<size_t> memory_limit(0);
+
+// the usage of every thread is kept by the thread and only merged when it is
+// queried, so calls of different threads do not contend
+struct ThreadUsage;
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadUsage *> threads;
+    std::map<std::string, TemporaryMemory> retired;
+};
+
+Registry &registry() {
+    static Registry reg;
+    return reg;
+}
+
+
+void merge(std::map<std::string, TemporaryMemory> &into, const char *name, const TemporaryMemory &mem) {
+    TemporaryMemory &total = into[name];
+    total.calls += mem.calls;
+    total.peak = std::max(total.peak, mem.peak);
+    total.chunked += mem.chunked;
+}
+
+
+struct ThreadUsage {
+    std::mutex mutex;
+    std::map<const char *, TemporaryMemory> usage;
+
+    ThreadUsage() {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.threads.push_back(this);
+    }
+
+    ~ThreadUsage() {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto &entry : usage) {
+            merge(reg.retired, entry.first, entry.second);
+        }
+        reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(), this));
+    }
+};
+
+ThreadUsage &thread_usage() {
+    static thread_local ThreadUsage usage;
+    return usage;
+}
+
+// the accounting of the outermost MemoryScope of a thread
+struct CallMemory {
+    const char *name = nullptr;
+    size_t current = 0;
+    size_t peak = 0;
+    bool chunked = false;
+};
+
+CallMemory &call_memory() {
+    static thread_local CallMemory call;
+    return call;
+}
+
+} // anonymous namespace
+
+
+void setTemporaryMemoryLimit(size_t bytes) {
+    memory_limit = bytes;
+}
+
+
+size_t temporaryMemoryLimit() {
+    return memory_limit.load(std::memory_order_relaxed);
+}
+
+
+std::map<std::string, TemporaryMemory> temporaryMemoryUsage() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::map<std::string, TemporaryMemory> usage = reg.retired;
+    for (ThreadUsage *thread : reg.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        for (const auto &entry : thread->usage) {
+            merge(usage, entry.first, entry.second);
+        }
+    }
+    return usage;
+}
+
+
+void resetTemporaryMemoryUsage() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.retired.clear();
+    for (ThreadUsage *thread : reg.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        thread->usage.clear();
+    }
+}
+
+
+MemoryScope::MemoryScope(const char *name)
+    : active(false)
+{
+    CallMemory &call = call_memory();
+    if (!call.name) {
+        call = CallMemory();
+        call.name = name;
+        active = true;
+    }
+}
+
+
+MemoryScope::~MemoryScope() {
+    if (!active) {
+        return;
+    }
+
+    CallMemory &call = call_memory();
+    ThreadUsage &thread = thread_usage();
+    {
+        // only contended while the usage is queried
+        std::lock_guard<std::mutex> lock(thread.mutex);
+        TemporaryMemory &mem = thread.usage[call.name];
+        mem.calls++;
+        mem.peak = std::max(mem.peak, call.peak);
+        mem.chunked += call.chunked ? 1 : 0;
+    }
+    call = CallMemory();
+}
+
+
+TemporaryAllocation::TemporaryAllocation(size_t bytes)
+    : size(0)
+{
+    resize(bytes);
+}
+
+
+void TemporaryAllocation::resize(size_t bytes) {
+    CallMemory &call = call_memory();
+    call.current = call.current - std::min(call.current, size) + bytes;
+    call.peak = std::max(call.peak, call.current);
+    size = bytes;
+}
+
+
+TemporaryAllocation::~TemporaryAllocation() {
+    CallMemory &call = call_memory();
+    call.current -= std::min(call.current, size);
+}
+
+
+void noteAllocation(size_t bytes) {
+    CallMemory &call = call_memory();
+    call.peak = std::max(call.peak, call.current + bytes);
+}
+
+
+size_t partsWithinLimit(size_t count, size_t part_bytes) {
+    size_t limit = temporaryMemoryLimit();
+    if (limit == 0 || part_bytes == 0 || count <= limit / part_bytes) {
+        return count;
+    }
+
+    call_memory().chunked = true;
+    return std::max<size_t>(1, limit / part_bytes);
+}
+
+} // namespace util
+} // namespace nix
@@ -14,6 +14,7 @@
 #include <sstream>
 #include <iterator>
 #include <stdexcept>
+#include <numeric>
 
 #include <nix/hydra/multiArray.hpp>
 #include <nix/util/dataAccess.hpp>
@@ -580,6 +581,67 @@ void BaseTestDataAccess::testMultiTagFeatureData() {
 }
 
 
+void BaseTestDataAccess::testIndexedFeatureData() {
+    DataArray positions = block.createDataArray("many positions", "test", nix::DataType::Double, {20});
+    positions.setData(std::vector<double>(20, 1.0));
+    positions.appendSetDimension();
+    MultiTag mtag = block.createMultiTag("many events", "test", positions);
+
+    DataArray rows_data = block.createDataArray("indexed rows", "test", nix::DataType::Int32, {20, 3});
+    std::vector<int> values(60);
+    std::iota(values.begin(), values.end(), 0);
+    rows_data.setData(nix::DataType::Int32, values.data(), {20, 3}, {0, 0});
+    DataArray point_data = block.createDataArray("indexed points", "test", nix::DataType::Double, {20});
+    std::vector<double> points(20);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = 0.5 * i;
+    }
+    point_data.setData(points);
+
+    Feature row_feature = mtag.createFeature(rows_data, nix::LinkType::Indexed);
+    Feature point_feature = mtag.createFeature(point_data, nix::LinkType::Indexed);
+    Feature tagged_feature = mtag.createFeature(point_data, nix::LinkType::Tagged);
+
+    // contiguous runs, sparse, unsorted and repeated indices
+    std::vector<std::vector<ndsize_t>> index_sets = {{2, 3, 4, 5, 10, 11, 12},
+                                                     {1, 7, 13, 19},
+                                                     {5, 1, 5, 19, 0}};
+    for (const auto &indices : index_sets) {
+        NDArray rows = util::indexedFeatureData(mtag, indices, row_feature);
+        CPPUNIT_ASSERT(rows.shape().size() == 2);
+        CPPUNIT_ASSERT(rows.shape()[0] == indices.size() && rows.shape()[1] == 3);
+        std::vector<DataView> views = util::featureData(mtag, indices, row_feature);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            std::vector<int> expected(3);
+            views[i].getData(nix::DataType::Int32, expected.data(), {1, 3}, {0, 0});
+            for (size_t j = 0; j < 3; ++j) {
+                CPPUNIT_ASSERT_EQUAL(expected[j], rows.get<int>(NDSize({i, j})));
+            }
+        }
+
+        NDArray pts = util::indexedFeatureData(mtag, indices, 1);
+        CPPUNIT_ASSERT(pts.shape() == NDSize({indices.size()}));
+        for (size_t i = 0; i < indices.size(); ++i) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(points[indices[i]], pts.get<double>(i), 1e-12);
+        }
+    }
+
+    std::vector<ndsize_t> all;
+    NDArray all_rows = util::indexedFeatureData(mtag, all, row_feature);
+    CPPUNIT_ASSERT(all_rows.shape() == NDSize({20, 3}));
+    CPPUNIT_ASSERT_EQUAL(59, all_rows.get<int>(NDSize({19, 2})));
+
+    CPPUNIT_ASSERT_THROW(util::indexedFeatureData(mtag, {20}, row_feature), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(util::indexedFeatureData(mtag, {0}, tagged_feature), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(util::indexedFeatureData(mtag, {0}, 3), nix::OutOfBounds);
+
+    block.deleteMultiTag(mtag.id());
+    block.deleteDataArray(rows_data.id());
+    block.deleteDataArray(point_data.id());
+    block.deleteDataArray(positions.id());
+}
+
+
 void BaseTestDataAccess::testMultiTagUnitSupport() {
     std::vector<std::string> valid_units{"none","ms","ms"};
     std::vector<std::string> invalid_units{"mV", "Ohm", "muV"};
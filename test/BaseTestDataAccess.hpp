@@ -40,6 +40,7 @@ public:
     void testRetrieveData();
     void testTagFeatureData();
     void testMultiTagFeatureData();
+    void testIndexedFeatureData();
     void testMultiTagUnitSupport();
     void testDataView();
     void testDataSlice();
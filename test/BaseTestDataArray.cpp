@@ -13,12 +13,19 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <numeric>
+#include <cstring>
+#include <cmath>
+#include <thread>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/tools/rational.hpp>
 #include <boost/iterator/zip_iterator.hpp>
 
+#include <H5public.h>
+
 #include <nix/util/util.hpp>
+#include <nix/util/memory.hpp>
 #include <nix/valid/validate.hpp>
 #include <nix/hydra/multiArray.hpp>
 
@@ -615,6 +622,200 @@ void BaseTestDataArray::testDataFrameDimension() {
 }
 
 
+void BaseTestDataArray::testChunking() {
+    nix::DataArray da = block.createDataArray("chunk_explicit", "nix.test", nix::DataType::Int16, {0, 16},
+                                              nix::Compression::None, nix::ChunkingOptions(nix::NDSize({256, 4})));
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({256, 4}), da.chunkShape());
+
+    // appended along time and read channel-wise: narrow across channels
+    da = block.createDataArray("chunk_pattern", "nix.test", nix::DataType::Int16, {0, 384},
+                               nix::Compression::None, nix::ChunkingOptions::accessPattern(0, 0));
+    nix::NDSize chunks = da.chunkShape();
+    CPPUNIT_ASSERT(chunks.size() == 2);
+    CPPUNIT_ASSERT(chunks[0] > 1 && chunks[1] == 1);
+
+    da = block.createDataArray("chunk_auto", "nix.test", nix::DataType::Double, {10, 10});
+    CPPUNIT_ASSERT(da.chunkShape().size() == 2);
+
+    CPPUNIT_ASSERT_THROW(block.createDataArray("chunk_bad_rank", "nix.test", nix::DataType::Int16, {0, 16},
+                                               nix::Compression::None, nix::ChunkingOptions(nix::NDSize({256}))),
+                         nix::InvalidRank);
+    CPPUNIT_ASSERT_THROW(block.createDataArray("chunk_bad_axis", "nix.test", nix::DataType::Int16, {0, 16},
+                                               nix::Compression::None, nix::ChunkingOptions::accessPattern(2)),
+                         nix::InvalidRank);
+}
+
+
+void BaseTestDataArray::testChunkIO() {
+    std::vector<int32_t> values(16);
+    std::iota(values.begin(), values.end(), 0);
+
+    nix::DataArray da = block.createDataArray("chunk_raw", "nix.test", nix::DataType::Int32, {16},
+                                              nix::Compression::None, nix::ChunkingOptions(nix::NDSize({4})));
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({4}), da.chunkGrid());
+
+#if H5_VERSION_GE(1, 10, 3)
+    CPPUNIT_ASSERT_EQUAL(size_t(0), da.chunkStorageSize({4}));
+
+    // uncompressed chunks are the plain element bytes
+    da.writeChunk({4}, values.data() + 4, 4 * sizeof(int32_t));
+    std::vector<int32_t> read(4);
+    da.getData(nix::DataType::Int32, read.data(), {4}, {4});
+    CPPUNIT_ASSERT(std::equal(read.begin(), read.end(), values.begin() + 4));
+
+    std::vector<char> raw;
+    CPPUNIT_ASSERT_EQUAL(uint32_t(0), da.readChunk({4}, raw));
+    CPPUNIT_ASSERT_EQUAL(4 * sizeof(int32_t), raw.size());
+    CPPUNIT_ASSERT(memcmp(raw.data(), values.data() + 4, raw.size()) == 0);
+    da.readChunk({0}, raw);
+    CPPUNIT_ASSERT(raw.empty());
+
+    // compressed chunks can be copied without transcoding
+    std::vector<int32_t> signal(64);
+    std::iota(signal.begin(), signal.end(), 0);
+    nix::DataArray src = block.createDataArray("chunk_src", "nix.test", nix::DataType::Int32, {64},
+                                               nix::Compression::DeflateNormal, nix::ChunkingOptions(nix::NDSize({32})));
+    src.setData(nix::DataType::Int32, signal.data(), {64}, {0});
+    nix::DataArray dst = block.createDataArray("chunk_dst", "nix.test", nix::DataType::Int32, {64},
+                                               nix::Compression::DeflateNormal, nix::ChunkingOptions(nix::NDSize({32})));
+    for (nix::ndsize_t offset = 0; offset < 64; offset += 32) {
+        uint32_t mask = src.readChunk({offset}, raw);
+        CPPUNIT_ASSERT(raw.size() < 32 * sizeof(int32_t));
+        dst.writeChunk({offset}, raw.data(), raw.size(), mask);
+    }
+    std::vector<int32_t> copied(64);
+    dst.getData(nix::DataType::Int32, copied.data(), {64}, {0});
+    CPPUNIT_ASSERT(copied == signal);
+#else
+    // raw chunk access needs H5Dread_chunk and H5Dwrite_chunk
+    CPPUNIT_ASSERT_THROW(da.writeChunk({4}, values.data() + 4, 4 * sizeof(int32_t)), std::runtime_error);
+#endif
+
+    CPPUNIT_ASSERT_THROW(da.writeChunk({2}, values.data(), 4 * sizeof(int32_t)), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(da.writeChunk({16}, values.data(), 4 * sizeof(int32_t)), nix::OutOfBounds);
+}
+
+
+void BaseTestDataArray::testCompressionThreads() {
+    std::vector<double> values(64 * 10);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = std::sin(i * 0.01);
+    }
+
+    nix::DataArray da = block.createDataArray("parallel", "nix.test", nix::DataType::Double, {64, 10},
+                                              nix::Compression::DeflateNormal, nix::ChunkingOptions(nix::NDSize({16, 4})));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), da.compressionThreads());
+    da.compressionThreads(3);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), da.compressionThreads());
+    CPPUNIT_ASSERT_EQUAL(size_t(3), block.getDataArray(da.id()).compressionThreads());
+
+    da.setData(nix::DataType::Double, values.data(), {64, 10}, {0, 0});
+    std::vector<double> read(values.size());
+    da.getData(nix::DataType::Double, read.data(), {64, 10}, {0, 0});
+    CPPUNIT_ASSERT(read == values);
+
+    // unaligned writes take the regular path
+    std::vector<double> row(10, -1.0);
+    da.setData(nix::DataType::Double, row.data(), {1, 10}, {5, 0});
+    da.getData(nix::DataType::Double, read.data(), {64, 10}, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(-1.0, read[5 * 10 + 9]);
+    CPPUNIT_ASSERT_EQUAL(values[6 * 10], read[6 * 10]);
+
+    // or split off the whole chunks they cover
+    std::vector<double> rows(40 * 9);
+    for (size_t i = 0; i < rows.size(); i++) {
+        rows[i] = -static_cast<double>(i);
+    }
+    da.setData(nix::DataType::Double, rows.data(), {40, 9}, {10, 1});
+    da.getData(nix::DataType::Double, read.data(), {64, 10}, {0, 0});
+    for (size_t r = 0; r < 64; r++) {
+        for (size_t c = 0; c < 10; c++) {
+            bool inside = r >= 10 && r < 50 && c >= 1;
+            double expected = inside ? rows[(r - 10) * 9 + c - 1] : (r == 5 ? -1.0 : values[r * 10 + c]);
+            CPPUNIT_ASSERT_EQUAL(expected, read[r * 10 + c]);
+        }
+    }
+
+    // appending whole chunks
+    nix::DataArray shuffled = block.createDataArray("parallel_shuffle", "nix.test", nix::DataType::Double, {64, 10},
+                                                    nix::CompressionOptions(nix::CompressionCodec::Deflate, 4,
+                                                                            nix::ShuffleFilter::Byte),
+                                                    nix::ChunkingOptions(nix::NDSize({16, 4})));
+    shuffled.compressionThreads(2);
+    shuffled.setData(nix::DataType::Double, values.data(), {64, 10}, {0, 0});
+    shuffled.appendData(nix::DataType::Double, values.data(), {64, 10}, 0);
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({128, 10}), shuffled.dataExtent());
+    read.resize(2 * values.size());
+    shuffled.getData(nix::DataType::Double, read.data(), {128, 10}, {0, 0});
+    CPPUNIT_ASSERT(std::equal(values.begin(), values.end(), read.begin()));
+    CPPUNIT_ASSERT(std::equal(values.begin(), values.end(), read.begin() + values.size()));
+}
+
+
+void BaseTestDataArray::testMemoryLimit() {
+    std::vector<int32_t> values(1000);
+    std::iota(values.begin(), values.end(), -500);
+    nix::DataArray da = block.createDataArray("limited", "nix.test", nix::DataType::Int32, {1000});
+    da.setData(nix::DataType::Int32, values.data(), {1000}, {0});
+    da.polynomCoefficients({1.0, 2.0});
+
+    std::vector<std::string> strings(300);
+    for (size_t i = 0; i < strings.size(); i++) {
+        strings[i] = "string #" + nix::util::numToStr(i);
+    }
+    nix::DataArray sa = block.createDataArray("limited_strings", "nix.test", nix::DataType::String, {300});
+    sa.setData(nix::DataType::String, strings.data(), {300}, {0});
+
+    std::vector<ndsize_t> rows = {900, 3, 3, 512, 0, 999, 42};
+
+    std::vector<int32_t> expected(values.size());
+    da.getData(nix::DataType::Int32, expected.data(), {1000}, {0});
+    std::vector<int32_t> expected_rows(rows.size());
+    da.getDataRows(nix::DataType::Int32, expected_rows.data(), rows);
+    CPPUNIT_ASSERT_EQUAL(int32_t(1 + 2 * values[900]), expected_rows[0]);
+
+    nix::util::resetTemporaryMemoryUsage();
+    nix::util::setTemporaryMemoryLimit(1024);
+
+    std::vector<int32_t> read(values.size());
+    da.getData(nix::DataType::Int32, read.data(), {1000}, {0});
+    CPPUNIT_ASSERT(read == expected);
+
+    std::vector<int32_t> read_rows(rows.size());
+    da.getDataRows(nix::DataType::Int32, read_rows.data(), rows);
+    CPPUNIT_ASSERT(read_rows == expected_rows);
+
+    std::vector<std::string> read_strings(strings.size());
+    sa.getData(nix::DataType::String, read_strings.data(), {300}, {0});
+    CPPUNIT_ASSERT(read_strings == strings);
+
+    nix::util::setTemporaryMemoryLimit(0);
+
+    std::map<std::string, nix::util::TemporaryMemory> usage = nix::util::temporaryMemoryUsage();
+    const nix::util::TemporaryMemory &get_data = usage["DataArray::getData"];
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), get_data.calls);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), get_data.chunked);
+    CPPUNIT_ASSERT(get_data.peak > 0 && get_data.peak <= 1024);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), usage["DataArray::getDataRows"].calls);
+    CPPUNIT_ASSERT(usage["DataArray::getDataRows"].peak > 0);
+
+    // without a limit the whole calibrated buffer is held at once
+    nix::util::resetTemporaryMemoryUsage();
+    da.getData(nix::DataType::Int32, read.data(), {1000}, {0});
+    usage = nix::util::temporaryMemoryUsage();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), usage["DataArray::getData"].chunked);
+    CPPUNIT_ASSERT_EQUAL(1000 * sizeof(double), usage["DataArray::getData"].peak);
+
+    // calls of other threads are merged, also after the thread exited
+    std::thread reader([&da, &read] { da.getData(nix::DataType::Int32, read.data(), {1000}, {0}); });
+    reader.join();
+    usage = nix::util::temporaryMemoryUsage();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), usage["DataArray::getData"].calls);
+    nix::util::resetTemporaryMemoryUsage();
+    CPPUNIT_ASSERT(nix::util::temporaryMemoryUsage().empty());
+}
+
+
 void BaseTestDataArray::testOperator() {
     std::stringstream mystream;
     mystream << array1;
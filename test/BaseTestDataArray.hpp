@@ -37,6 +37,10 @@ public:
     void testDimension();
     void testAliasRangeDimension();
     void testDataFrameDimension();
+    void testChunking();
+    void testChunkIO();
+    void testCompressionThreads();
+    void testMemoryLimit();
     void testOperator();
     void testValidate();
 };
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include <limits>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <iterator>
@@ -339,6 +340,27 @@ void BaseTestDimension::testSampledDimIndexOf() {
     CPPUNIT_ASSERT(ranges[2] && (*ranges[2]).first == 2 && (*ranges[2]).second == 40 && 
                    sd.positionAt((*ranges[2]).first) == 1.0 && sd.positionAt((*ranges[2]).second) == 39);
     CPPUNIT_ASSERT(!ranges[3]);
+
+    // the batch kernel must agree with the scalar version
+    std::vector<double> starts = {1.0, 12.0, 1.0, 5.0, -5.0, 3.0, 20.0, -10.0, 2.5};
+    std::vector<double> ends = {10.9, 20.0, 40.0, 5.0, 0.5, 2.0, 20.5, -3.0, 2.7};
+    std::vector<ndsize_t> start_idx(starts.size()), end_idx(starts.size());
+    std::vector<uint8_t> valid(starts.size());
+    for (RangeMatch match : {RangeMatch::Inclusive, RangeMatch::Exclusive}) {
+        size_t valid_count = sd.indexOf(starts.data(), ends.data(), starts.size(), match,
+                                        start_idx.data(), end_idx.data(), valid.data());
+        size_t expected_count = 0;
+        for (size_t i = 0; i < starts.size(); ++i) {
+            boost::optional<std::pair<ndsize_t, ndsize_t>> range = sd.indexOf(starts[i], ends[i], match);
+            CPPUNIT_ASSERT_EQUAL(static_cast<bool>(range), static_cast<bool>(valid[i]));
+            if (range) {
+                expected_count++;
+                CPPUNIT_ASSERT_EQUAL((*range).first, start_idx[i]);
+                CPPUNIT_ASSERT_EQUAL((*range).second, end_idx[i]);
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL(expected_count, valid_count);
+    }
     data_array.deleteDimensions();
 }
 
@@ -398,6 +420,14 @@ void BaseTestDimension::testSampledDimAxis() {
         axis.back(),
         std::numeric_limits<double>::round_error());
 
+    SampledAxis view = sd.axisView(100, 10);
+    CPPUNIT_ASSERT(view.size() == 100);
+    CPPUNIT_ASSERT(std::equal(axis.begin(), axis.end(), view.begin()));
+    CPPUNIT_ASSERT(view.end() - view.begin() == 100);
+    CPPUNIT_ASSERT(view.begin()[99] == axis[99]);
+    CPPUNIT_ASSERT(view.at(5) == axis[5]);
+    CPPUNIT_ASSERT_THROW(view.at(100), OutOfBounds);
+
     data_array.deleteDimensions();
 }
 
@@ -484,6 +514,67 @@ void BaseTestDimension::testSetDimLabels() {
     data_array.deleteDimensions();
 }
 
+void BaseTestDimension::testSetDimLabelIndexOf() {
+    std::vector<std::string> labels = {"ch_a", "ch_b", "ch_c", "ch_b"};
+
+    Dimension d = data_array.appendSetDimension();
+    SetDimension sd;
+    sd = d;
+    CPPUNIT_ASSERT(!sd.indexOf(std::string("ch_a")));
+
+    sd.labels(labels);
+    boost::optional<ndsize_t> index = sd.indexOf(std::string("ch_c"));
+    CPPUNIT_ASSERT(index && *index == 2);
+    index = sd.indexOf(std::string("ch_b"));
+    CPPUNIT_ASSERT(index && *index == 1);
+    CPPUNIT_ASSERT(!sd.indexOf(std::string("ch_x")));
+
+    std::vector<std::string> query = {"ch_c", "ch_x", "ch_a"};
+    std::vector<boost::optional<ndsize_t>> indices = sd.indexOf(query);
+    CPPUNIT_ASSERT(indices.size() == 3);
+    CPPUNIT_ASSERT(indices[0] && *indices[0] == 2);
+    CPPUNIT_ASSERT(!indices[1]);
+    CPPUNIT_ASSERT(indices[2] && *indices[2] == 0);
+
+    std::vector<ndsize_t> idx(query.size());
+    std::vector<uint8_t> valid(query.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), sd.indexOf(query, idx.data(), valid.data()));
+    CPPUNIT_ASSERT(valid[0] && idx[0] == 2);
+    CPPUNIT_ASSERT(!valid[1] && idx[1] == 0);
+    CPPUNIT_ASSERT(valid[2] && idx[2] == 0);
+
+    // lookups see the current labels
+    sd.labels(std::vector<std::string>({"ch_x", "ch_a"}));
+    index = sd.indexOf(std::string("ch_x"));
+    CPPUNIT_ASSERT(index && *index == 0);
+    CPPUNIT_ASSERT(!sd.indexOf(std::string("ch_c")));
+
+    // also when they were written through another handle
+    SetDimension other;
+    other = data_array.getDimension(d.index());
+    CPPUNIT_ASSERT(other.indexOf(std::string("ch_a")));
+    CPPUNIT_ASSERT(other.indexOf(-1.0, 1.5, RangeMatch::Inclusive));
+    sd.labels(labels);
+    CPPUNIT_ASSERT(other.indexOf(std::string("ch_a")) && *other.indexOf(std::string("ch_a")) == 0);
+    CPPUNIT_ASSERT(other.indexOf(query, idx.data(), valid.data()) == 2 && idx[0] == 2);
+    boost::optional<std::pair<ndsize_t, ndsize_t>> range = other.indexOf(0.0, 10.0, RangeMatch::Inclusive);
+    CPPUNIT_ASSERT(range && range->second == labels.size() - 1);
+
+    // and through a handle opened from another DataArray handle
+    SetDimension third;
+    third = block.getDataArray(data_array.id()).getDimension(d.index());
+    CPPUNIT_ASSERT(third.indexOf(std::string("ch_c")) && *third.indexOf(std::string("ch_c")) == 2);
+    other.labels(std::vector<std::string>({"ch_c"}));
+    CPPUNIT_ASSERT(third.indexOf(std::string("ch_c")) && *third.indexOf(std::string("ch_c")) == 0);
+    CPPUNIT_ASSERT(!third.indexOf(std::string("ch_a")));
+    CPPUNIT_ASSERT(sd.indexOf(query, idx.data(), valid.data()) == 1 && valid[0] && idx[0] == 0);
+    other.labels(boost::none);
+    CPPUNIT_ASSERT(!third.indexOf(std::string("ch_c")));
+
+    data_array.deleteDimensions();
+}
+
+
 void BaseTestDimension::testSetDimIndexOf() {
     std::vector<std::string> labels = {"label_a", "label_b","label_c","label_d","label_e"};
 
@@ -877,6 +968,18 @@ void BaseTestDimension::testRangeDimAxis() {
     CPPUNIT_ASSERT_THROW(rd.axis(10), OutOfBounds);
     CPPUNIT_ASSERT_THROW(rd.axis(2, 10), OutOfBounds);
     CPPUNIT_ASSERT_THROW(rd.axis(std::numeric_limits<ndsize_t>::max(), static_cast<size_t>(1)), OutOfBounds);
+
+    RangeAxis view = rd.axisView(4, 1, 3);
+    CPPUNIT_ASSERT(view.size() == 4);
+    CPPUNIT_ASSERT(std::equal(view.begin(), view.end(), ticks.begin() + 1));
+    CPPUNIT_ASSERT(view[3] == 100.0);
+    CPPUNIT_ASSERT(view[0] == -10.0);
+    CPPUNIT_ASSERT_THROW(view.at(4), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(view[4], OutOfBounds);
+
+    view = rd.axisView(10);
+    CPPUNIT_ASSERT_THROW(view[0], OutOfBounds);
+    CPPUNIT_ASSERT_THROW(rd.axisView(2, 0, 0), std::invalid_argument);
 }
 
 
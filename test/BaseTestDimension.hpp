@@ -40,6 +40,7 @@ public:
 
     void testSetDimLabels();
     void testSetDimIndexOf();
+    void testSetDimLabelIndexOf();
 
     void testRangeDimLabel();
     void testRangeTicks();
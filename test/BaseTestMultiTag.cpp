@@ -295,6 +295,41 @@ void BaseTestMultiTag::testPositionExtents() {
 }
 
 
+void BaseTestMultiTag::testPositionsAndExtents() {
+    std::vector<std::vector<double>> pos, ext;
+    std::vector<ndsize_t> indices = {4, 0, 2, 2};
+
+    tag.positionsAndExtents(indices, pos, ext);
+    CPPUNIT_ASSERT(pos.size() == 5 && ext.size() == 5);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0 * indices[i], pos[indices[i]][i], 1e-12);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, ext[indices[i]][i], 1e-12);
+    }
+
+    tag.extents(extents);
+    tag.positionsAndExtents({3}, pos, ext);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(300.0, pos[3][0], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(300.0, ext[3][0], 1e-12);
+    CPPUNIT_ASSERT_THROW(tag.positionsAndExtents({5}, pos, ext), nix::OutOfBounds);
+
+    // in place changes and shape changes are seen by every handle
+    MultiTag copy = tag;
+    tag.positionsAndExtents({3}, pos, ext);
+    std::vector<double> row(5, 1.0);
+    positions.setData(DataType::Double, row.data(), {1, 5}, {3, 0});
+    copy.positionsAndExtents({3}, pos, ext);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pos[3][0], 1e-12);
+    tag.positionsAndExtents({3}, pos, ext);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pos[3][0], 1e-12);
+
+    positions.dataExtent({6, 5});
+    extents.dataExtent({6, 5});
+    tag.positionsAndExtents({5, 3}, pos, ext);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pos[3][0], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pos[3][1], 1e-12);
+}
+
+
 void BaseTestMultiTag::testDataAccess() {
     DataArray data_array = block.createDataArray("dimensionTest",
                                        "test",
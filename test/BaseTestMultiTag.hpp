@@ -39,6 +39,7 @@ public:
     void testFeatures();
     void testDataAccess();
     void testPositionExtents();
+    void testPositionsAndExtents();
     void testMetadataAccess();
     void testSourceAccess();
     void testOperators();
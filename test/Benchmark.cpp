@@ -10,6 +10,7 @@
 
 #include <nix.hpp>
 #include <nix/NDArray.hpp>
+#include <nix/util/dataAccess.hpp>
 
 #include <cstdio>
 #include <queue>
@@ -24,6 +25,19 @@
 #include <string>
 #include <cstdint>
 #include <utility>
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <map>
+#include <numeric>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
 
 /* ************************************ */
 namespace nix {
@@ -38,6 +52,10 @@ auto data_type_dispatch(nix::DataType dtype, Func &&F, Args&&... args)
             return std::forward<Func>(F)(double(), std::forward<Args>(args)...);
             break;
 
+        case DataType::Float:
+            return std::forward<Func>(F)(float(), std::forward<Args>(args)...);
+            break;
+
         case DataType::Int8:
             return std::forward<Func>(F)(int8_t(), std::forward<Args>(args)...);
             break;
@@ -46,6 +64,26 @@ auto data_type_dispatch(nix::DataType dtype, Func &&F, Args&&... args)
             return std::forward<Func>(F)(int16_t(), std::forward<Args>(args)...);
             break;
 
+        case DataType::Int32:
+            return std::forward<Func>(F)(int32_t(), std::forward<Args>(args)...);
+            break;
+
+        case DataType::Int64:
+            return std::forward<Func>(F)(int64_t(), std::forward<Args>(args)...);
+            break;
+
+        case DataType::UInt16:
+            return std::forward<Func>(F)(uint16_t(), std::forward<Args>(args)...);
+            break;
+
+        case DataType::UInt32:
+            return std::forward<Func>(F)(uint32_t(), std::forward<Args>(args)...);
+            break;
+
+        case DataType::UInt64:
+            return std::forward<Func>(F)(uint64_t(), std::forward<Args>(args)...);
+            break;
+
         default:
             throw std::invalid_argument("Unkown DataType");
     }
@@ -57,6 +95,39 @@ auto data_type_dispatch(nix::DataType dtype, Func &&F, Args&&... args)
 
 /* ************************************ */
 
+// every heap allocation of the process, including those of the library,
+// is counted by replacing the global operator new
+static std::atomic<uint64_t> allocation_count(0);
+
+void *operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size > 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+
+// counts the buffers of NDArrays, which are not allocated with operator new
+class CountingAllocator : public nix::NDArrayAllocator {
+public:
+    void *allocate(size_t bytes, size_t alignment) override {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        return nix::defaultNDArrayAllocator()->allocate(bytes, alignment);
+    }
+
+    void deallocate(void *ptr, size_t bytes, size_t alignment) override {
+        nix::defaultNDArrayAllocator()->deallocate(ptr, bytes, alignment);
+    }
+};
+
+/* ************************************ */
+
 class Stopwatch {
 
 public:
@@ -71,12 +142,149 @@ public:
         return count;
     }
 
+    double seconds() {
+        return std::chrono::duration<double>(clock_t::now() - t_start).count();
+    }
+
 private:
     time_point_t t_start;
 };
 
 /* ************************************ */
 
+// one measured quantity, e.g. the write speed of a config, over all repetitions
+class Result {
+public:
+    Result(const std::string &name, const std::string &unit, bool higher_is_better)
+            : my_name(name), my_unit(unit), higher(higher_is_better) { }
+
+    void add(double value) { values.push_back(value); }
+
+    const std::string & name() const { return my_name; }
+    const std::string & unit() const { return my_unit; }
+    bool higher_is_better() const { return higher; }
+    size_t count() const { return values.size(); }
+
+    // linear interpolation between the closest ranks
+    double percentile(double p) const {
+        std::vector<double> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        double rank = p / 100.0 * static_cast<double>(sorted.size() - 1);
+        size_t lo = static_cast<size_t>(std::floor(rank));
+        size_t hi = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (rank - static_cast<double>(lo)) * (sorted[hi] - sorted[lo]);
+    }
+
+    double median() const { return percentile(50.0); }
+
+private:
+    std::string my_name;
+    std::string my_unit;
+    bool higher;
+    std::vector<double> values;
+};
+
+
+class Report {
+public:
+    void add(const std::string &name, const std::string &unit, bool higher_is_better, double value) {
+        const std::string key = name + " | " + unit;
+        auto it = index.find(key);
+        if (it == index.end()) {
+            it = index.insert({key, results.size()}).first;
+            results.emplace_back(name, unit, higher_is_better);
+        }
+        results[it->second].add(value);
+    }
+
+    void write_text(std::ostream &out) const {
+        out.precision(5);
+        for (const Result &r : results) {
+            out << r.name() << ": " << r.median() << " " << r.unit();
+            if (r.count() > 1) {
+                out << " [p10 " << r.percentile(10) << ", p90 " << r.percentile(90) << ", n=" << r.count() << "]";
+            }
+            out << std::endl;
+        }
+    }
+
+    void write_csv(std::ostream &out) const {
+        out.precision(10);
+        out << "name,unit,higher_is_better,n,median,p10,p90,min,max" << std::endl;
+        for (const Result &r : results) {
+            out << '"' << r.name() << "\",\"" << r.unit() << "\"," << r.higher_is_better() << ","
+                << r.count() << "," << r.median() << "," << r.percentile(10) << ","
+                << r.percentile(90) << "," << r.percentile(0) << "," << r.percentile(100) << std::endl;
+        }
+    }
+
+    void write_json(std::ostream &out) const {
+        out.precision(10);
+        out << "{\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result &r = results[i];
+            out << (i > 0 ? "," : "") << "\n    {"
+                << "\"name\": \"" << escape(r.name()) << "\", "
+                << "\"unit\": \"" << escape(r.unit()) << "\", "
+                << "\"higher_is_better\": " << (r.higher_is_better() ? "true" : "false") << ", "
+                << "\"n\": " << r.count() << ", "
+                << "\"median\": " << r.median() << ", "
+                << "\"p10\": " << r.percentile(10) << ", "
+                << "\"p90\": " << r.percentile(90) << ", "
+                << "\"min\": " << r.percentile(0) << ", "
+                << "\"max\": " << r.percentile(100) << "}";
+        }
+        out << "\n  ]\n}" << std::endl;
+    }
+
+    // compares the medians with a baseline written by write_json and returns
+    // the number of results that got worse by more than threshold (a fraction)
+    size_t compare(const std::string &baseline, double threshold, std::ostream &out) const {
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(baseline, tree);
+
+        std::map<std::string, double> base;
+        for (const auto &entry : tree.get_child("results")) {
+            const boost::property_tree::ptree &r = entry.second;
+            base[r.get<std::string>("name") + " | " + r.get<std::string>("unit")] = r.get<double>("median");
+        }
+
+        size_t regressions = 0;
+        out.precision(5);
+        for (const Result &r : results) {
+            auto it = base.find(r.name() + " | " + r.unit());
+            if (it == base.end() || it->second == 0.0) {
+                continue;
+            }
+            double change = (r.median() - it->second) / std::fabs(it->second);
+            bool worse = r.higher_is_better() ? change < -threshold : change > threshold;
+            if (worse) {
+                regressions++;
+                out << "REGRESSION " << r.name() << ": " << it->second << " -> " << r.median()
+                    << " " << r.unit() << " (" << (change > 0 ? "+" : "") << change * 100.0 << "%)" << std::endl;
+            }
+        }
+        return regressions;
+    }
+
+private:
+    static std::string escape(const std::string &str) {
+        std::string res;
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                res += '\\';
+            }
+            res += c;
+        }
+        return res;
+    }
+
+    std::vector<Result> results;
+    std::map<std::string, size_t> index;
+};
+
+/* ************************************ */
+
 class RndGenBase {
 public:
     RndGenBase() : rd(), rd_gen(rd()) { };
@@ -120,8 +328,12 @@ private:
 class Config {
 
 public:
-    Config(nix::DataType data_type, const nix::NDSize &blocksize)
-            : data_type(data_type), block_size(blocksize) {
+    Config(nix::DataType data_type, const nix::NDSize &blocksize,
+           const std::string &compression_name = "none",
+           const nix::CompressionOptions &compression = nix::Compression::None,
+           const nix::ChunkingOptions &chunking = {})
+            : data_type(data_type), block_size(blocksize), compression_name(compression_name),
+              compression_opts(compression), chunking_opts(chunking) {
 
         sdim = find_single_dim();
         shape = blocksize;
@@ -151,6 +363,8 @@ public:
     const nix::NDSize& extend() const { return shape; }
     size_t singleton_dimension() const { return sdim; }
     const std::string & name() const { return my_name; };
+    const nix::CompressionOptions & compression() const { return compression_opts; }
+    const nix::ChunkingOptions & chunking() const { return chunking_opts; }
 
 
 private:
@@ -163,12 +377,26 @@ private:
         }
         s << "}";
 
+        if (compression_name != "none" || !chunking_opts.shape.empty()) {
+            s << "[" << compression_name;
+            if (!chunking_opts.shape.empty()) {
+                s << ", chunks";
+                for (auto x : chunking_opts.shape) {
+                    s << " " << x;
+                }
+            }
+            s << "]";
+        }
+
         my_name = s.str();
     }
 
 private:
     const nix::DataType data_type;
     const nix::NDSize block_size;
+    const std::string compression_name;
+    const nix::CompressionOptions compression_opts;
+    const nix::ChunkingOptions chunking_opts;
 
     size_t        sdim;
     nix::NDSize   shape;
@@ -182,7 +410,8 @@ class BlockGenerator : public RndGenBase {
 public:
 
     BlockGenerator(const Config &cfg, size_t bufsize)
-            : blocksize(cfg.size()), dtype(cfg.dtype()), uni_dis(0, bufsize-1) {
+            : blocksize(cfg.size()), dtype(cfg.dtype()), uni_dis(0, bufsize-1),
+              pool(std::make_shared<nix::NDArrayPool>()) {
         for(size_t i = 0; i < bufsize; i++) {
             blocks.push_back(make_block());
         }
@@ -192,10 +421,11 @@ public:
 
     public:
         template<typename U>
-        nix::NDArray operator()(U tag, const nix::NDSize &size) {
+        nix::NDArray operator()(U tag, const nix::NDSize &size, const std::shared_ptr<nix::NDArrayPool> &pool) {
             RndGen<U> rnd_gen;
 
-            nix::NDArray data(nix::to_data_type<U>::value, size);
+            // copies handed out by next_block come from the same pool
+            nix::NDArray data(nix::to_data_type<U>::value, size, pool);
             for(size_t i = 0; i < data.num_elements(); i++) {
                 data.set(i, rnd_gen());
             }
@@ -206,7 +436,7 @@ public:
 
     nix::NDArray make_block() {
         BlockMaker maker;
-        return nix::data_type_dispatch(dtype, maker, std::ref(blocksize));
+        return nix::data_type_dispatch(dtype, maker, std::ref(blocksize), std::ref(pool));
     }
 
     nix::NDArray next_block() {
@@ -245,6 +475,7 @@ private:
     nix::NDSize blocksize;
     nix::DataType dtype;
     std::uniform_int_distribution<size_t> uni_dis;
+    std::shared_ptr<nix::NDArrayPool> pool;
     std::vector<nix::NDArray> blocks;
 };
 
@@ -258,7 +489,8 @@ public:
         const std::string &cfg_name = config.name();
         std::vector<nix::DataArray> v = block.dataArrays(nix::util::NameFilter<nix::DataArray>(cfg_name));
         if (v.empty()) {
-            return block.createDataArray(cfg_name, "nix.test.da", config.dtype(), config.extend());
+            return block.createDataArray(cfg_name, "nix.test.da", config.dtype(), config.extend(),
+                                         config.compression(), config.chunking());
         } else {
             return v[0];
         }
@@ -325,7 +557,7 @@ public:
         size_t N = 100;
         size_t iterations = 0;
 
-        nix::NDSize pos = {0, 0};
+        nix::NDSize pos(config.size().size(), 0);
         Stopwatch sw;
         ssize_t ms = 0;
         do {
@@ -368,7 +600,7 @@ public:
         nix::NDSize extend = da.dataExtent();
         size_t N = extend[config.singleton_dimension()];
 
-        nix::NDSize pos = {0, 0};
+        nix::NDSize pos(config.size().size(), 0);
 
         ssize_t ms = time_it([this, &da, &N, &pos, &array] {
             for(size_t i = 0; i < N; i++) {
@@ -410,6 +642,88 @@ public:
     }
 };
 
+class CompressionBenchmark : public Benchmark {
+
+public:
+    CompressionBenchmark(const Config &cfg, const std::string &name, const nix::CompressionOptions &opts,
+                         const nix::ChunkingOptions &chunking = {}, size_t threads = 0)
+            : Benchmark(cfg), codec_name(name), options(opts), chunking(chunking), threads(threads), ratio(0.0) {
+    };
+
+    void run(nix::Block block) override {
+        const std::string path = "compression-" + codec_name + ".h5";
+        const size_t nblocks = 256;
+        std::mt19937 gen(42);
+        std::vector<nix::NDArray> data;
+        for (size_t i = 0; i < nblocks; i++) {
+            data.push_back(make_signal(gen, i));
+        }
+        {
+            nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+            nix::Block b = fd.createBlock("compression", "nix.test");
+            nix::DataArray da = b.createDataArray(config.name(), "nix.test.da", config.dtype(),
+                                                  config.extend(), options, chunking);
+            da.compressionThreads(threads);
+
+            ssize_t ms = time_it([this, &da, &data, nblocks] {
+                const size_t sdim = config.singleton_dimension();
+                nix::NDSize offset(config.size().size(), 0);
+                nix::NDSize extent = config.size();
+                for (size_t i = 0; i < nblocks; i++) {
+                    offset[sdim] = i;
+                    extent[sdim] = i + 1;
+                    da.dataExtent(extent);
+                    da.setData(config.dtype(), data[i].data(), config.size(), offset);
+                }
+            });
+            fd.close();
+
+            this->count = nblocks;
+            this->millis = ms;
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        double raw = static_cast<double>(nblocks * config.size().nelms() * nix::data_type_to_size(config.dtype()));
+        ratio = raw / static_cast<double>(file.tellg());
+        std::remove(path.c_str());
+    }
+
+    std::string id() override {
+        std::stringstream s;
+        s << "C[" << codec_name;
+        if (threads > 0) {
+            s << ", " << threads << " threads";
+        }
+        s << "]";
+        return s.str();
+    }
+
+    double compression_ratio() const {
+        return ratio;
+    }
+
+private:
+    // a smooth signal with some noise; random data would not compress at all
+    nix::NDArray make_signal(std::mt19937 &gen, size_t block_index) const {
+        nix::NDArray data(config.dtype(), config.size());
+        std::normal_distribution<double> noise(0.0, 8.0);
+        const size_t n = data.num_elements();
+        for (size_t i = 0; i < n; i++) {
+            double t = static_cast<double>(block_index * n + i);
+            double v = 1000.0 * std::sin(t * 0.01) + noise(gen);
+            data.set(i, static_cast<int16_t>(v));
+        }
+        return data;
+    }
+
+    std::string codec_name;
+    nix::CompressionOptions options;
+    nix::ChunkingOptions chunking;
+    size_t threads;
+    double ratio;
+};
+
+
 class DiskBenchmark : public Benchmark {
 public:
     DiskBenchmark(const Config &cfg)
@@ -448,7 +762,7 @@ public:
         size_t N = 100;
         size_t iterations = 0;
 
-        nix::NDSize pos = {0, 0};
+        nix::NDSize pos(config.size().size(), 0);
         Stopwatch sw;
         ssize_t ms = 0;
         const size_t elm_size = nix::data_type_to_size(config.dtype());
@@ -533,76 +847,1073 @@ public:
 
 /* ************************************ */
 
-static std::vector<Config> make_configs() {
+// creates a file with many small entities and times a (warm cache) open that
+// enumerates all of them; the number of read calls approximates the scattered
+// reads of a cold open on a network file system
+class OpenBenchmark {
+public:
+    OpenBenchmark(Report &report, size_t blocks, size_t entities_per_block)
+            : report(report), blocks(blocks), entities(entities_per_block) { }
+
+    void run(const std::string &name, const nix::FileOptions &create, const nix::FileOptions &open) {
+        const std::string path = "open-" + name + ".h5";
+        {
+            nix::File fd = nix::File::open(path, nix::FileMode::Overwrite, create);
+            for (size_t b = 0; b < blocks; b++) {
+                nix::Block block = fd.createBlock("block_" + std::to_string(b), "nix.test");
+                nix::Section section = fd.createSection("section_" + std::to_string(b), "nix.test");
+                for (size_t i = 0; i < entities; i++) {
+                    const std::string suffix = std::to_string(i);
+                    nix::DataArray da = block.createDataArray("da_" + suffix, "nix.test", nix::DataType::Double, {16});
+                    da.appendSampledDimension(0.1);
+                    nix::Tag tag = block.createTag("tag_" + suffix, "nix.test", {1.0});
+                    tag.addReference(da);
+                    section.createProperty("prop_" + suffix, nix::Variant(static_cast<double>(i)));
+                }
+            }
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        double size = static_cast<double>(file.tellg());
+
+        long reads_before = read_calls();
+        size_t count = 0;
+        Stopwatch sw;
+        {
+            nix::File fd = nix::File::open(path, nix::FileMode::ReadOnly, open);
+            for (const nix::Block &block : fd.blocks()) {
+                for (const nix::DataArray &da : block.dataArrays()) {
+                    count += da.dimensionCount() + (da.name().empty() ? 0 : 1);
+                }
+                for (const nix::Tag &tag : block.tags()) {
+                    count += tag.referenceCount() + (tag.name().empty() ? 0 : 1);
+                }
+            }
+            for (const nix::Section &section : fd.sections()) {
+                for (const nix::Property &prop : section.properties()) {
+                    count += prop.name().empty() ? 0 : 1;
+                }
+            }
+        }
+        ssize_t ms = sw.ms();
+        long reads = read_calls() - reads_before;
+
+        std::stringstream s;
+        s << "Open[" << name << "]@{ " << count << " entities }";
+        report.add(s.str(), "ms", false, static_cast<double>(ms));
+        if (reads >= 0) {
+            report.add(s.str(), "read calls", false, static_cast<double>(reads));
+        }
+        report.add(s.str(), "MB", false, size / (1024.0 * 1024.0));
+        std::remove(path.c_str());
+    }
+
+private:
+    // number of read system calls of this process, -1 if unknown (Linux only)
+    static long read_calls() {
+        std::ifstream io("/proc/self/io");
+        std::string key;
+        long value;
+        while (io >> key >> value) {
+            if (key == "syscr:") {
+                return value;
+            }
+        }
+        return -1;
+    }
+
+    Report &report;
+    size_t blocks;
+    size_t entities;
+};
+
+/* ************************************ */
+
+class EntityLayoutBenchmark {
+public:
+    EntityLayoutBenchmark(Report &report, size_t count) : report(report), count(count) { }
+
+    void run(const std::string &name, nix::EntityLayout layout) {
+        const std::string path = "layout-" + name + ".h5";
+        nix::FileOptions opts;
+        opts.entity_layout = layout;
+
+        Stopwatch sw_create;
+        {
+            nix::File fd = nix::File::open(path, nix::FileMode::Overwrite, opts);
+            nix::Block block = fd.createBlock("block", "nix.test");
+            for (size_t i = 0; i < count; i++) {
+                const std::string suffix = std::to_string(i);
+                block.createSource("source_" + suffix, "nix.test");
+                block.createTag("tag_" + suffix, "nix.test", {1.0});
+            }
+        }
+        double create_s = sw_create.ms() / 1000.0;
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        double size = static_cast<double>(file.tellg());
+
+        size_t n = 0;
+        Stopwatch sw_open;
+        {
+            nix::File fd = nix::File::open(path, nix::FileMode::ReadOnly);
+            nix::Block block = fd.getBlock("block");
+            for (const nix::Source &src : block.sources()) {
+                n += src.id().empty() ? 0 : 1;
+            }
+            for (const nix::Tag &tag : block.tags()) {
+                n += tag.id().empty() ? 0 : 1;
+            }
+        }
+        double open_s = sw_open.ms() / 1000.0;
+
+        const double entities = 2.0 * count;
+        std::stringstream s;
+        s << "EntityLayout[" << name << "]@{ " << n << " entities }";
+        report.add(s.str(), "bytes/entity", false, size / entities);
+        report.add(s.str(), "created/s", true, entities / create_s);
+        report.add(s.str(), "opened/s", true, entities / open_s);
+        std::remove(path.c_str());
+    }
+
+private:
+    Report &report;
+    size_t count;
+};
+
+/* ************************************ */
+
+// metadata and entity graph workloads at sizes growing by decades; lookup
+// costs that grow with the number of entities show up as falling ops/s
+class MetadataBenchmark {
+public:
+    MetadataBenchmark(Report &report, size_t min_entities, size_t max_entities)
+            : report(report), min_n(min_entities), max_n(max_entities) { }
+
+    void run() {
+        for (size_t n = min_n; n <= max_n; n *= 10) {
+            run_size(n);
+        }
+    }
+
+private:
+    void run_size(size_t n) {
+        const std::string path = "metadata-" + std::to_string(n) + ".h5";
+        std::vector<std::string> da_ids, tag_ids;
+        {
+            nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+            nix::Block block = fd.createBlock("block", "nix.test");
+
+            add(n, "create Block", "ops/s", all_per_second(n, [&fd](size_t i) {
+                fd.createBlock("block_" + std::to_string(i), "nix.test");
+            }));
+
+            std::vector<nix::DataArray> arrays;
+            add(n, "create DataArray", "ops/s", all_per_second(n, [&block, &arrays](size_t i) {
+                const char *type = i % 2 ? "nix.test.odd" : "nix.test.even";
+                arrays.push_back(block.createDataArray("da_" + std::to_string(i), type, nix::DataType::Double, {4}));
+            }));
+
+            std::vector<nix::Tag> tags;
+            add(n, "create Tag", "ops/s", all_per_second(n, [&block, &tags](size_t i) {
+                tags.push_back(block.createTag("tag_" + std::to_string(i), "nix.test", {1.0}));
+            }));
+
+            std::vector<nix::Source> sources;
+            for (size_t i = 0; i < n; i++) {
+                sources.push_back(block.createSource("source_" + std::to_string(i), "nix.test"));
+            }
+
+            // linking checks that the target exists, only a sample is linked
+            add(n, "link", "ops/s", per_second(n, [&arrays, &tags, &sources](size_t i) {
+                tags[i].addReference(arrays[i]);
+                tags[i].addSource(sources[i]);
+                arrays[i].addSource(sources[i]);
+            }));
+
+            nix::Section props = fd.createSection("properties", "nix.test");
+            for (size_t i = 0; i < n; i++) {
+                props.createProperty("prop_" + std::to_string(i), nix::Variant(static_cast<double>(i)));
+            }
+
+            // a tree with four children per section
+            nix::Section root = fd.createSection("tree", "nix.test.tree");
+            std::queue<nix::Section> parents;
+            parents.push(root);
+            for (size_t i = 1; i < n; ) {
+                nix::Section parent = parents.front();
+                parents.pop();
+                for (size_t k = 0; k < 4 && i < n; k++, i++) {
+                    parents.push(parent.createSection("section_" + std::to_string(i), "nix.test.tree"));
+                }
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                da_ids.push_back(arrays[i].id());
+                tag_ids.push_back(tags[i].id());
+            }
+        }
+
+        nix::File fd = nix::File::open(path, nix::FileMode::ReadOnly);
+        nix::Block block = fd.getBlock("block");
+
+        add(n, "open Block", "ops/s", per_second(n, [&fd](size_t i) {
+            volatile bool ok = !fd.getBlock(i + 1).name().empty();
+            (void) ok;
+        }));
+        add(n, "open DataArray", "ops/s", per_second(n, [&block](size_t i) {
+            volatile bool ok = !block.getDataArray(i).name().empty();
+            (void) ok;
+        }));
+        add(n, "open Tag", "ops/s", per_second(n, [&block](size_t i) {
+            volatile bool ok = !block.getTag(i).name().empty();
+            (void) ok;
+        }));
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+
+        add(n, "DataArray by name", "ops/s", per_second(n, [&block, &gen, &pick](size_t) {
+            block.getDataArray("da_" + std::to_string(pick(gen)));
+        }));
+        add(n, "DataArray by id", "ops/s", per_second(n, [&block, &gen, &pick, &da_ids](size_t) {
+            block.getDataArray(da_ids[pick(gen)]);
+        }));
+        add(n, "Tag by id", "ops/s", per_second(n, [&block, &gen, &pick, &tag_ids](size_t) {
+            block.getTag(tag_ids[pick(gen)]);
+        }));
+
+        add(n, "find DataArrays by type", "ops/s", per_second(n, [&block](size_t) {
+            block.dataArrays(nix::util::TypeFilter<nix::DataArray>("nix.test.odd"));
+        }));
+        add(n, "find Sources by name", "ops/s", per_second(n, [&block](size_t i) {
+            block.findSources(nix::util::NameFilter<nix::Source>("source_" + std::to_string(i)));
+        }));
+
+        nix::Section tree = fd.getSection("tree");
+        size_t found = 0;
+        double tree_s = per_second(1, [&tree, &found](size_t) {
+            found = tree.findSections(nix::util::TypeFilter<nix::Section>("nix.test.tree")).size();
+        });
+        add(n, "findSections", "sections/s", tree_s * static_cast<double>(found));
+
+        add(n, "Source::referringTags", "ops/s", per_second(n, [&block, &gen, &pick](size_t) {
+            block.getSource("source_" + std::to_string(pick(gen))).referringTags();
+        }));
+        add(n, "Source::referringDataArrays", "ops/s", per_second(n, [&block, &gen, &pick](size_t) {
+            block.getSource("source_" + std::to_string(pick(gen))).referringDataArrays();
+        }));
+
+        nix::Section props = fd.getSection("properties");
+        add(n, "Property::values", "ops/s", per_second(n, [&props, &gen, &pick](size_t) {
+            props.getProperty("prop_" + std::to_string(pick(gen))).values();
+        }));
+
+        fd.close();
+        std::remove(path.c_str());
+    }
+
+    // calls op(i) for all i < n
+    template<typename F>
+    static double all_per_second(size_t n, F op) {
+        Stopwatch sw;
+        for (size_t i = 0; i < n; i++) {
+            op(i);
+        }
+        return static_cast<double>(n) / sw.seconds();
+    }
+
+    // calls op(i) for i < max_ops, stopping after a second
+    template<typename F>
+    static double per_second(size_t max_ops, F op) {
+        Stopwatch sw;
+        size_t i = 0;
+        do {
+            op(i++);
+        } while (i < max_ops && sw.ms() < 1000);
+        return static_cast<double>(i) / sw.seconds();
+    }
+
+    void add(size_t n, const std::string &family, const std::string &unit, double value) {
+        std::stringstream s;
+        s << "Metadata[" << family << "]@{ " << n << " }";
+        report.add(s.str(), unit, true, value);
+    }
+
+    Report &report;
+    size_t min_n;
+    size_t max_n;
+};
+
+/* ************************************ */
+
+// retrieval of the data and features tagged by the positions of a MultiTag,
+// for every dimension type and range matching mode
+class TaggedDataBenchmark {
+public:
+    TaggedDataBenchmark(Report &report, size_t min_positions, size_t max_positions)
+            : report(report), min_p(min_positions), max_p(max_positions) { }
+
+    void run() {
+        for (size_t p = min_p; p <= max_p; p *= 10) {
+            for (nix::DimensionType dim : {nix::DimensionType::Sample, nix::DimensionType::Range, nix::DimensionType::Set}) {
+                run_size(p, dim);
+            }
+        }
+    }
+
+private:
+    static const size_t slot = 8;    // samples per position
+    static const size_t segment = 5; // samples covered by each extent
+
+    void run_size(size_t p, nix::DimensionType dim) {
+        const std::string path = "tagged-" + std::to_string(p) + ".h5";
+        nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+        nix::Block block = fd.createBlock("tagged", "nix.test");
+
+        const size_t length = p * slot;
+        std::vector<double> signal(length);
+        for (size_t i = 0; i < length; i++) {
+            signal[i] = std::sin(static_cast<double>(i) * 0.01);
+        }
+
+        nix::DataArray data = make_array(block, "data", signal, dim);
+        nix::DataArray tagged = make_array(block, "tagged_feature", signal, dim);
+
+        std::vector<double> pos(p), ext(p, static_cast<double>(segment));
+        for (size_t i = 0; i < p; i++) {
+            pos[i] = static_cast<double>(i * slot);
+        }
+        nix::NDSize tag_shape(2, 1);
+        tag_shape[0] = p;
+        nix::DataArray positions = block.createDataArray("positions", "nix.test", nix::DataType::Double, tag_shape);
+        positions.setData(nix::DataType::Double, pos.data(), tag_shape, {0, 0});
+        nix::DataArray extents = block.createDataArray("extents", "nix.test", nix::DataType::Double, tag_shape);
+        extents.setData(nix::DataType::Double, ext.data(), tag_shape, {0, 0});
+
+        std::vector<double> per_position(p * 4, 1.0);
+        nix::NDSize indexed_shape(2, 4);
+        indexed_shape[0] = p;
+        nix::DataArray indexed = block.createDataArray("indexed_feature", "nix.test", nix::DataType::Double, indexed_shape);
+        indexed.setData(nix::DataType::Double, per_position.data(), indexed_shape, {0, 0});
+        nix::DataArray untagged = block.createDataArray("untagged_feature", "nix.test", nix::DataType::Double, {64});
+        untagged.setData(std::vector<double>(64, 2.0));
+
+        nix::MultiTag mtag = block.createMultiTag("mtag", "nix.test", positions);
+        mtag.extents(extents);
+        mtag.addReference(data);
+        mtag.createFeature(tagged, nix::LinkType::Tagged);
+        mtag.createFeature(indexed, nix::LinkType::Indexed);
+        mtag.createFeature(untagged, nix::LinkType::Untagged);
+
+        for (nix::RangeMatch match : {nix::RangeMatch::Exclusive, nix::RangeMatch::Inclusive}) {
+            const std::string suffix = std::string(dim_name(dim)) + ", " +
+                (match == nix::RangeMatch::Exclusive ? "exclusive" : "inclusive");
+
+            measure("taggedData[" + suffix + "]", p, [&mtag, &data, match](size_t i, std::vector<double> &buf) {
+                read_view(nix::util::taggedData(mtag, i, data, match), buf);
+            });
+
+            const char *features[] = {"tagged", "indexed", "untagged"};
+            for (size_t f = 0; f < 3; f++) {
+                measure("featureData[" + suffix + ", " + features[f] + "]", p,
+                        [&mtag, f, match](size_t i, std::vector<double> &buf) {
+                    read_view(nix::util::featureData(mtag, i, f, match), buf);
+                });
+            }
+        }
+
+        fd.close();
+        std::remove(path.c_str());
+    }
+
+    nix::DataArray make_array(nix::Block &block, const std::string &name, const std::vector<double> &values,
+                              nix::DimensionType dim) const {
+        nix::DataArray da = block.createDataArray(name, "nix.test", values);
+        if (dim == nix::DimensionType::Sample) {
+            da.appendSampledDimension(1.0);
+        } else if (dim == nix::DimensionType::Range) {
+            std::vector<double> ticks(values.size());
+            for (size_t i = 0; i < ticks.size(); i++) {
+                ticks[i] = static_cast<double>(i);
+            }
+            da.appendRangeDimension(ticks);
+        } else {
+            da.appendSetDimension();
+        }
+        return da;
+    }
+
+    static void read_view(const nix::DataView &view, std::vector<double> &buf) {
+        const nix::NDSize count = view.dataExtent();
+        buf.resize(count.nelms());
+        view.getData(nix::DataType::Double, buf.data(), count, nix::NDSize(count.size(), 0));
+    }
+
+    static const char * dim_name(nix::DimensionType dim) {
+        switch (dim) {
+            case nix::DimensionType::Sample: return "Sampled";
+            case nix::DimensionType::Range:  return "Range";
+            default:                         return "Set";
+        }
+    }
+
+    // retrieves the positions in order until all are done or a second passed
+    template<typename F>
+    void measure(const std::string &name, size_t p, F retrieve) {
+        std::vector<double> buf;
+        size_t bytes = 0;
+        size_t i = 0;
+        Stopwatch sw;
+        do {
+            retrieve(i++, buf);
+            bytes += buf.size() * sizeof(double);
+        } while (i < p && sw.ms() < 1000);
+        double secs = sw.seconds();
+
+        std::stringstream s;
+        s << name << "@{ " << p << " positions }";
+        report.add(s.str(), "us/position", false, secs * 1e6 / static_cast<double>(i));
+        report.add(s.str(), "MB/s", true, bytes / (1024.0 * 1024.0) / secs);
+    }
+
+    Report &report;
+    size_t min_p;
+    size_t max_p;
+};
+
+/* ************************************ */
+
+// row, cell and column access of a DataFrame with a mixed schema
+class DataFrameBenchmark {
+public:
+    DataFrameBenchmark(Report &report, size_t min_rows, size_t max_rows)
+            : report(report), min_n(min_rows), max_n(max_rows) { }
+
+    void run() {
+        for (size_t n = min_n; n <= max_n; n *= 10) {
+            run_size(n);
+        }
+    }
+
+private:
+    void run_size(size_t n) {
+        const std::string path = "dataframe-" + std::to_string(n) + ".h5";
+        nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+        nix::Block block = fd.createBlock("frames", "nix.test");
+
+        std::vector<nix::Column> cols = {
+            {"trial", "", nix::DataType::Int32},
+            {"time", "ns", nix::DataType::Int64},
+            {"value", "mV", nix::DataType::Double},
+            {"label", "", nix::DataType::String}};
+        nix::DataFrame df = block.createDataFrame("frame", "nix.test", cols);
+        df.rows(n);
+
+        std::vector<int32_t> trial(n);
+        std::vector<int64_t> time(n);
+        std::vector<double> value(n);
+        std::vector<std::string> label(n);
+        size_t bytes = 0;
+        for (size_t i = 0; i < n; i++) {
+            trial[i] = static_cast<int32_t>(i / 100);
+            time[i] = static_cast<int64_t>(i) * 1000;
+            value[i] = std::sin(static_cast<double>(i) * 0.01);
+            label[i] = "label_" + std::to_string(i % 1000);
+            bytes += sizeof(int32_t) + sizeof(int64_t) + sizeof(double) + label[i].size();
+        }
+        const double row_bytes = static_cast<double>(bytes) / static_cast<double>(n);
+
+        Stopwatch sw_write;
+        df.writeColumn("trial", trial);
+        df.writeColumn("time", time);
+        df.writeColumn("value", value);
+        df.writeColumn("label", label);
+        add(n, "writeColumn", n, row_bytes, sw_write.seconds());
+
+        Stopwatch sw_read;
+        df.readColumn("trial", trial, true);
+        df.readColumn("time", time, true);
+        df.readColumn("value", value, true);
+        df.readColumn("label", label, true);
+        add(n, "readColumn", n, row_bytes, sw_read.seconds());
+
+        rows_per_second(n, "writeRow", row_bytes, [&](size_t i) {
+            df.writeRow(i, {nix::Variant(trial[i]), nix::Variant(time[i]), nix::Variant(value[i]), nix::Variant(label[i])});
+        });
+        rows_per_second(n, "readRow", row_bytes, [&df](size_t i) {
+            df.readRow(i);
+        });
+
+        const double cell_bytes = sizeof(double) + label[0].size();
+        rows_per_second(n, "writeCells", cell_bytes, [&](size_t i) {
+            df.writeCells(i, {nix::Cell("value", value[i]), nix::Cell("label", label[i])});
+        });
+        rows_per_second(n, "readCells", cell_bytes, [&df](size_t i) {
+            df.readCells(i, {"value", "label"});
+        });
+
+        fd.close();
+        std::remove(path.c_str());
+    }
+
+    // accesses the rows in order until all are done or a second passed
+    template<typename F>
+    void rows_per_second(size_t n, const std::string &name, double row_bytes, F op) {
+        Stopwatch sw;
+        size_t i = 0;
+        do {
+            op(i++);
+        } while (i < n && sw.ms() < 1000);
+        add(n, name, i, row_bytes, sw.seconds());
+    }
+
+    void add(size_t n, const std::string &name, size_t rows, double row_bytes, double secs) {
+        std::stringstream s;
+        s << "DataFrame[" << name << "]@{ " << n << " rows }";
+        report.add(s.str(), "rows/s", true, static_cast<double>(rows) / secs);
+        report.add(s.str(), "MB/s", true, static_cast<double>(rows) * row_bytes / (1024.0 * 1024.0) / secs);
+    }
+
+    Report &report;
+    size_t min_n;
+    size_t max_n;
+};
+
+/* ************************************ */
+
+class AxisBenchmark {
+public:
+    AxisBenchmark(Report &report, nix::ndsize_t count, size_t chunk_size = 65536)
+            : report(report), count(count), chunk_size(chunk_size) { }
+
+    void run(nix::Block block) {
+        nix::DataArray da = block.createDataArray("axis", "nix.test.axis", nix::DataType::Double, {count});
+        nix::SampledDimension sd = da.appendSampledDimension(0.001);
+        sd.offset(-1.0);
+
+        time_it("sampled axis", count * sizeof(double), [this, &sd] {
+            std::vector<double> axis = sd.axis(count);
+            return sum(axis.begin(), axis.end());
+        });
+        time_it("sampled axisView", sizeof(nix::SampledAxis), [this, &sd] {
+            nix::SampledAxis axis = sd.axisView(count);
+            return sum(axis.begin(), axis.end());
+        });
+
+        nix::DataArray ticks = block.createDataArray("axis_ticks", "nix.test.axis", nix::DataType::Double, {count});
+        std::vector<double> buffer(chunk_size);
+        for (nix::ndsize_t offset = 0; offset < count; offset += chunk_size) {
+            size_t n = static_cast<size_t>(std::min<nix::ndsize_t>(chunk_size, count - offset));
+            for (size_t i = 0; i < n; i++) {
+                buffer[i] = static_cast<double>(offset + i) * 0.001;
+            }
+            ticks.setData(nix::DataType::Double, buffer.data(), {n}, {offset});
+        }
+        nix::RangeDimension rd = ticks.appendAliasRangeDimension();
+
+        time_it("range axis", count * sizeof(double), [this, &rd] {
+            std::vector<double> axis = rd.axis(count);
+            return sum(axis.begin(), axis.end());
+        });
+        time_it("range axisView", chunk_size * sizeof(double), [this, &rd] {
+            nix::RangeAxis axis = rd.axisView(count, 0, chunk_size);
+            return sum(axis.begin(), axis.end());
+        });
+    }
+
+private:
+    template<typename Iter>
+    static double sum(Iter begin, Iter end) {
+        double total = 0.0;
+        for (Iter it = begin; it != end; ++it) {
+            total += *it;
+        }
+        return total;
+    }
+
+    template<typename F>
+    void time_it(const std::string &name, size_t bytes, F func) {
+        Stopwatch sw;
+        volatile double result = func();
+        (void) result;
+        ssize_t ms = sw.ms();
+
+        std::stringstream s;
+        s << name << "@{ " << count << " }";
+        report.add(s.str(), "ms", false, static_cast<double>(ms));
+        report.add(s.str(), "MB", false, bytes / (1024.0 * 1024.0));
+    }
+
+    Report &report;
+    nix::ndsize_t count;
+    size_t chunk_size;
+};
+
+// start and end positions of many events converted to index ranges, per event
+// through the optional returning overload and in one pass through the batch overload
+class IndexOfBenchmark {
+public:
+    IndexOfBenchmark(Report &report, size_t events)
+            : report(report), events(events) { }
+
+    void run(nix::Block block) {
+        nix::DataArray da = block.createDataArray("index_of", "nix.test.axis", nix::DataType::Double, {1});
+        nix::SampledDimension sd = da.appendSampledDimension(0.001);
+        sd.offset(-1.0);
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> start_dist(-2.0, 1000.0);
+        std::uniform_real_distribution<double> extent_dist(0.0, 0.5);
+        std::vector<double> starts(events), ends(events);
+        for (size_t i = 0; i < events; i++) {
+            starts[i] = start_dist(gen);
+            ends[i] = starts[i] + extent_dist(gen);
+        }
+
+        time_it("indexOf (optional ranges)", [&] {
+            std::vector<boost::optional<std::pair<nix::ndsize_t, nix::ndsize_t>>> ranges =
+                sd.indexOf(starts, ends, nix::RangeMatch::Inclusive);
+            return std::count_if(ranges.begin(), ranges.end(),
+                                 [](const boost::optional<std::pair<nix::ndsize_t, nix::ndsize_t>> &r) { return !!r; });
+        });
+
+        std::vector<nix::ndsize_t> start_indices(events), end_indices(events);
+        std::vector<uint8_t> valid(events);
+        time_it("indexOf (batch)", [&] {
+            return sd.indexOf(starts.data(), ends.data(), events, nix::RangeMatch::Inclusive,
+                              start_indices.data(), end_indices.data(), valid.data());
+        });
+    }
+
+private:
+    template<typename F>
+    void time_it(const std::string &name, F func) {
+        Stopwatch sw;
+        volatile size_t result = static_cast<size_t>(func());
+        (void) result;
+        double secs = sw.seconds();
+
+        std::stringstream s;
+        s << name << "@{ " << events << " }";
+        report.add(s.str(), "ms", false, secs * 1000.0);
+        report.add(s.str(), "Mevents/s", true, secs > 0.0 ? events / secs / 1e6 : 0.0);
+    }
+
+    Report &report;
+    size_t events;
+};
+
+class AllocationBenchmark {
+public:
+    AllocationBenchmark(Report &report, size_t positions)
+            : report(report), positions(positions) { }
+
+    void run(nix::Block block) {
+        const size_t slot = 8;
+        std::vector<double> signal(positions * slot);
+        for (size_t i = 0; i < signal.size(); i++) {
+            signal[i] = std::sin(static_cast<double>(i) * 0.01);
+        }
+        nix::DataArray data = block.createDataArray("alloc_data", "nix.test", signal);
+        data.appendSampledDimension(1.0);
+
+        std::vector<double> pos(positions), ext(positions, 5.0);
+        for (size_t i = 0; i < positions; i++) {
+            pos[i] = static_cast<double>(i * slot);
+        }
+        nix::NDSize tag_shape(2, 1);
+        tag_shape[0] = positions;
+        nix::DataArray pos_da = block.createDataArray("alloc_positions", "nix.test", nix::DataType::Double, tag_shape);
+        pos_da.setData(nix::DataType::Double, pos.data(), tag_shape, {0, 0});
+        nix::DataArray ext_da = block.createDataArray("alloc_extents", "nix.test", nix::DataType::Double, tag_shape);
+        ext_da.setData(nix::DataType::Double, ext.data(), tag_shape, {0, 0});
+        nix::MultiTag mtag = block.createMultiTag("alloc_mtag", "nix.test", pos_da);
+        mtag.extents(ext_da);
+        mtag.addReference(data);
+
+        nix::NDSize offset = {0, 0}, count = {4, 8};
+        measure("NDSize copy", 1000000, [&](size_t i) {
+            nix::NDSize copy(offset);
+            copy[0] = i;
+            volatile nix::ndsize_t sink = copy[0];
+            (void) sink;
+        });
+        measure("NDSize arithmetic", 1000000, [&](size_t i) {
+            offset[0] = i;
+            volatile bool sink = offset + count <= count * count;
+            (void) sink;
+        });
+
+        std::vector<nix::ndsize_t> all(positions);
+        std::iota(all.begin(), all.end(), 0);
+        std::vector<nix::DataView> views;
+        measure("taggedData (all positions)", 1, [&](size_t) {
+            views = nix::util::taggedData(mtag, all, data);
+        }, positions);
+        measure("taggedData", positions, [&](size_t i) {
+            nix::util::taggedData(mtag, i, data);
+        });
+
+        std::vector<double> buf(slot);
+        measure("DataView::getData", positions, [&](size_t i) {
+            const nix::DataView &view = views[i];
+            view.getData(nix::DataType::Double, buf.data(), view.dataExtent(), {0});
+        });
+
+        // a fresh NDArray per read, from the heap or from a pool
+        const nix::NDSize slot_shape = {slot};
+        auto heap = std::make_shared<CountingAllocator>();
+        measure("NDArray per read", positions, [&](size_t i) {
+            nix::NDArray block(nix::DataType::Double, slot_shape, heap);
+            data.getData(block.dtype(), block.data(), slot_shape, {i * slot});
+        });
+        auto pool = std::make_shared<nix::NDArrayPool>(1024 * 1024, heap);
+        measure("NDArray per read (pooled)", positions, [&](size_t i) {
+            nix::NDArray block(nix::DataType::Double, slot_shape, pool);
+            data.getData(block.dtype(), block.data(), slot_shape, {i * slot});
+        });
+    }
+
+private:
+    // calls op(i) for all i < n; each call stands for calls_per_op operations
+    template<typename F>
+    void measure(const std::string &name, size_t n, F op, size_t calls_per_op = 1) {
+        const uint64_t start = allocation_count.load();
+        Stopwatch sw;
+        for (size_t i = 0; i < n; i++) {
+            op(i);
+        }
+        const double secs = sw.seconds();
+        const double calls = static_cast<double>(n * calls_per_op);
+
+        std::stringstream s;
+        s << "Allocations[" << name << "]@{ " << positions << " positions }";
+        report.add(s.str(), "allocs/call", false, static_cast<double>(allocation_count.load() - start) / calls);
+        report.add(s.str(), "ns/call", false, secs * 1e9 / calls);
+    }
+
+    Report &report;
+    size_t positions;
+};
+
+/* ************************************ */
+
+namespace po = boost::program_options;
+
+static nix::NDSize parse_shape(const std::string &str) {
+    std::vector<nix::ndsize_t> dims;
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        dims.push_back(std::stoull(item));
+    }
+    nix::NDSize shape(dims.size());
+    for (size_t i = 0; i < dims.size(); i++) {
+        shape[i] = dims[i];
+    }
+    return shape;
+}
+
+
+// codec[:level][+shuffle|+bitshuffle], e.g. none, deflate:1+shuffle, zstd:3
+static nix::CompressionOptions parse_compression(const std::string &spec) {
+    std::string codec = spec.substr(0, spec.find('+'));
+    std::string filter = spec.find('+') == std::string::npos ? "" : spec.substr(spec.find('+') + 1);
+    int level = -1;
+    if (codec.find(':') != std::string::npos) {
+        level = std::stoi(codec.substr(codec.find(':') + 1));
+        codec = codec.substr(0, codec.find(':'));
+    }
+
+    nix::ShuffleFilter shuffle = nix::ShuffleFilter::None;
+    if (filter == "shuffle") {
+        shuffle = nix::ShuffleFilter::Byte;
+    } else if (filter == "bitshuffle") {
+        shuffle = nix::ShuffleFilter::Bit;
+    } else if (!filter.empty()) {
+        throw std::invalid_argument("Unknown filter: " + filter);
+    }
+
+    if (codec == "none") {
+        return nix::Compression::None;
+    } else if (codec == "deflate") {
+        return nix::CompressionOptions(nix::CompressionCodec::Deflate, level, shuffle);
+    } else if (codec == "lz4") {
+        return nix::CompressionOptions(nix::CompressionCodec::LZ4, level, shuffle);
+    } else if (codec == "zstd") {
+        return nix::CompressionOptions(nix::CompressionCodec::Zstd, level, shuffle);
+    }
+    throw std::invalid_argument("Unknown compression codec: " + codec);
+}
+
+
+static std::vector<Config> make_configs(const std::vector<std::string> &dtypes,
+                                        const std::vector<std::string> &blocks,
+                                        const std::vector<std::string> &compressions,
+                                        const std::string &chunks) {
 
     std::vector<Config> configs;
+    nix::ChunkingOptions chunking;
+    if (!chunks.empty()) {
+        chunking = nix::ChunkingOptions(parse_shape(chunks));
+    }
 
-    configs.emplace_back(nix::DataType::Double, nix::NDSize{2048, 1});
-    configs.emplace_back(nix::DataType::Double, nix::NDSize{1, 2048});
+    for (const std::string &dtype : dtypes) {
+        for (const std::string &block : blocks) {
+            for (const std::string &compression : compressions) {
+                configs.emplace_back(nix::string_to_data_type(dtype), parse_shape(block),
+                                     compression, parse_compression(compression), chunking);
+            }
+        }
+    }
 
     return configs;
 }
 
-int main(int argc, char **argv)
-{
-    nix::File fd = nix::File::open("iospeed.h5", nix::FileMode::Overwrite);
-    nix::Block block = fd.createBlock("speed", "nix.test");
-
-    std::vector<Config> configs = make_configs();
-    std::vector<Benchmark *> marks;
 
-    std::cout << "Performing generators tests..." << std::endl;
+template<typename T>
+static void run_marks(Report &report, nix::Block block, const std::vector<Config> &configs) {
     for (const Config &cfg : configs) {
-        GeneratorBenchmark *benchmark = new GeneratorBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+        T benchmark(cfg);
+        benchmark.run(block);
+        const std::string name = cfg.name() + ", " + benchmark.id();
+        report.add(name, "MB/s", true, benchmark.speed_in_mbs());
+        report.add(name, "N/s", true, benchmark.speed_in_nps());
     }
+}
 
-    std::cout << "Performing disk IO tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        DiskWriteBenchmark *b = new DiskWriteBenchmark(cfg);
-        b->run(block);
-        marks.push_back(b);
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> dtypes, blocks, compressions, suites;
+    std::string chunks, config_file, format, output, baseline, path;
+    size_t repetitions, max_entities, max_positions, max_rows, axis_size, events;
+    double threshold;
+
+    po::options_description desc("Usage: nix-bench [options]\n\nOptions");
+    desc.add_options()
+        ("help,h", "print this help")
+        ("config", po::value<std::string>(&config_file), "read options from a file, one \"option = value\" per line")
+        ("dtype", po::value<std::vector<std::string>>(&dtypes)->composing(), "data type of the IO tests (default: double)")
+        ("block", po::value<std::vector<std::string>>(&blocks)->composing(),
+         "block shape of the IO tests, one dimension must be 1 (default: 2048,1 and 1,2048)")
+        ("compression", po::value<std::vector<std::string>>(&compressions)->composing(),
+         "compression of the IO tests: codec[:level][+shuffle|+bitshuffle] (default: none)")
+        ("chunks", po::value<std::string>(&chunks), "chunk shape of the IO tests, e.g. 4096,16")
+        ("suite", po::value<std::vector<std::string>>(&suites)->composing(),
+         "tests to run: generator, disk, write, read, poly, compression, open, layout, metadata, tagged, dataframe, "
+         "axis, indexof, alloc (default: all)")
+        ("entities", po::value<size_t>(&max_entities)->default_value(10000),
+         "largest number of entities of the metadata tests, which start at 100 and grow by decades")
+        ("positions", po::value<size_t>(&max_positions)->default_value(10000),
+         "largest number of MultiTag positions of the tagged tests, which start at 1000 and grow by decades")
+        ("rows", po::value<size_t>(&max_rows)->default_value(100000),
+         "largest number of rows of the DataFrame tests, which start at 1000 and grow by decades")
+        ("axis-size", po::value<size_t>(&axis_size)->default_value(1000000),
+         "number of positions of the axis tests")
+        ("events", po::value<size_t>(&events)->default_value(10000000),
+         "number of event ranges converted to indices by the indexof tests")
+        ("repetitions,n", po::value<size_t>(&repetitions)->default_value(1), "number of times each test is run")
+        ("format,f", po::value<std::string>(&format)->default_value("text"), "output format: text, json or csv")
+        ("output,o", po::value<std::string>(&output), "write the results to this file instead of stdout")
+        ("baseline", po::value<std::string>(&baseline), "compare the medians with the json results of an earlier run")
+        ("threshold", po::value<double>(&threshold)->default_value(10.0),
+         "relative change in percent that counts as a regression")
+        ("file", po::value<std::string>(&path)->default_value("iospeed.h5"), "the file used by the IO tests");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+        if (vm.count("config")) {
+            std::ifstream cfg_stream(config_file);
+            if (!cfg_stream) {
+                throw std::runtime_error("Could not open config file " + config_file);
+            }
+            po::store(po::parse_config_file(cfg_stream, desc), vm);
+            po::notify(vm);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "nix-bench: " << e.what() << std::endl << desc << std::endl;
+        return 2;
     }
 
-    std::cout << "Performing read tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        DiskReadBenchmark *b = new DiskReadBenchmark(cfg);
-        b->run(block);
-        marks.push_back(b);
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
     }
 
-    std::cout << "Performing write tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        WriteBenchmark *benchmark = new WriteBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    if (format != "text" && format != "json" && format != "csv") {
+        std::cerr << "nix-bench: unknown format " << format << std::endl;
+        return 2;
     }
 
-    std::cout << "Performing read tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        ReadBenchmark *benchmark = new ReadBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    if (dtypes.empty()) {
+        dtypes = {"double"};
+    }
+    if (blocks.empty()) {
+        blocks = {"2048,1", "1,2048"};
+    }
+    if (compressions.empty()) {
+        compressions = {"none"};
     }
 
-    std::cout << "Performing read (poly) tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        ReadPolyBenchmark *benchmark = new ReadPolyBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    std::vector<Config> configs;
+    try {
+        configs = make_configs(dtypes, blocks, compressions, chunks);
+    } catch (const std::exception &e) {
+        std::cerr << "nix-bench: " << e.what() << std::endl;
+        return 2;
+    }
+
+    auto enabled = [&suites](const std::string &suite) {
+        return suites.empty() || std::find(suites.begin(), suites.end(), suite) != suites.end();
+    };
+
+    Report report;
+
+    for (size_t rep = 0; rep < repetitions; rep++) {
+        std::cerr << "Repetition " << rep + 1 << " of " << repetitions << std::endl;
+        nix::File fd = nix::File::open(path, nix::FileMode::Overwrite);
+        nix::Block block = fd.createBlock("speed", "nix.test");
+
+        if (enabled("generator")) {
+            std::cerr << "Performing generators tests..." << std::endl;
+            run_marks<GeneratorBenchmark>(report, block, configs);
+        }
+
+        if (enabled("disk")) {
+            std::cerr << "Performing disk IO tests..." << std::endl;
+            run_marks<DiskWriteBenchmark>(report, block, configs);
+            run_marks<DiskReadBenchmark>(report, block, configs);
+        }
+
+        if (enabled("write")) {
+            std::cerr << "Performing write tests..." << std::endl;
+            run_marks<WriteBenchmark>(report, block, configs);
+        }
+
+        if (enabled("read")) {
+            std::cerr << "Performing read tests..." << std::endl;
+            run_marks<ReadBenchmark>(report, block, configs);
+        }
+
+        if (enabled("poly")) {
+            std::cerr << "Performing read (poly) tests..." << std::endl;
+            run_marks<ReadPolyBenchmark>(report, block, configs);
+        }
+
+        if (enabled("compression")) {
+            std::cerr << "Performing compression tests..." << std::endl;
+            const Config signal_cfg(nix::DataType::Int16, nix::NDSize{1, 30000});
+            std::vector<std::string> codecs = {
+                "none", "deflate", "deflate:1+shuffle", "lz4", "lz4+bitshuffle", "zstd:3", "zstd:3+shuffle"
+            };
+            // one chunk per written block, compressed by HDF5 or by a pool of threads
+            const nix::ChunkingOptions block_chunks(signal_cfg.size());
+            const unsigned hw_threads = std::max(1u, std::thread::hardware_concurrency());
+            std::vector<CompressionBenchmark> marks;
+            for (const std::string &codec : codecs) {
+                marks.emplace_back(signal_cfg, codec, parse_compression(codec));
+            }
+            marks.emplace_back(signal_cfg, "deflate:1+shuffle,block-chunks", parse_compression(codecs[2]), block_chunks);
+            marks.emplace_back(signal_cfg, "deflate:1+shuffle,block-chunks", parse_compression(codecs[2]), block_chunks,
+                               hw_threads);
+            for (CompressionBenchmark &benchmark : marks) {
+                try {
+                    benchmark.run(block);
+                } catch (const std::runtime_error &e) {
+                    std::cerr << "  skipping " << benchmark.id() << ": " << e.what() << std::endl;
+                    continue;
+                }
+                const std::string name = signal_cfg.name() + ", " + benchmark.id();
+                report.add(name, "MB/s", true, benchmark.speed_in_mbs());
+                report.add(name, "ratio", true, benchmark.compression_ratio());
+            }
+        }
+
+        if (enabled("open")) {
+            std::cerr << "Performing open tests..." << std::endl;
+            OpenBenchmark open_benchmark(report, 10, 200);
+            nix::FileOptions paged;
+            paged.paged = true;
+            paged.page_size = 64 * 1024;
+            nix::FileOptions page_buffer;
+            page_buffer.page_buffer_size = 4 * 1024 * 1024;
+            open_benchmark.run("default", nix::FileOptions(), nix::FileOptions());
+            open_benchmark.run("paged", paged, nix::FileOptions());
+            open_benchmark.run("paged+buffer", paged, page_buffer);
+        }
+
+        if (enabled("layout")) {
+            std::cerr << "Performing entity layout tests..." << std::endl;
+            EntityLayoutBenchmark layout_benchmark(report, 10000);
+            layout_benchmark.run("default", nix::EntityLayout::Default);
+            layout_benchmark.run("compact", nix::EntityLayout::Compact);
+        }
+
+        if (enabled("metadata")) {
+            std::cerr << "Performing metadata tests..." << std::endl;
+            MetadataBenchmark metadata_benchmark(report, 100, max_entities);
+            metadata_benchmark.run();
+        }
+
+        if (enabled("tagged")) {
+            std::cerr << "Performing tagged data tests..." << std::endl;
+            TaggedDataBenchmark tagged_benchmark(report, 1000, max_positions);
+            tagged_benchmark.run();
+        }
+
+        if (enabled("dataframe")) {
+            std::cerr << "Performing DataFrame tests..." << std::endl;
+            DataFrameBenchmark dataframe_benchmark(report, 1000, max_rows);
+            dataframe_benchmark.run();
+        }
+
+        if (enabled("axis")) {
+            std::cerr << "Performing axis tests..." << std::endl;
+            AxisBenchmark axis_benchmark(report, axis_size);
+            axis_benchmark.run(block);
+        }
+
+        if (enabled("indexof")) {
+            std::cerr << "Performing indexOf tests..." << std::endl;
+            IndexOfBenchmark index_of_benchmark(report, events);
+            index_of_benchmark.run(block);
+        }
+
+        if (enabled("alloc")) {
+            std::cerr << "Performing allocation tests..." << std::endl;
+            AllocationBenchmark alloc_benchmark(report, max_positions);
+            alloc_benchmark.run(block);
+        }
+
+        fd.close();
+        std::remove(path.c_str());
     }
 
-    std::cout << " === Reports ===" << std::endl;
-    std::cout.precision(5);
-    std::cout.unsetf (std::ios::floatfield);
-    for (Benchmark *mark : marks) {
-        std::cout << mark->cfg().name() << ", " << mark->id() << ", "
-                << mark->speed_in_mbs() << " MB/s, "
-                << mark->speed_in_nps() << " N/s" << std::endl;
-        delete mark;
+    std::ofstream output_file;
+    if (!output.empty()) {
+        output_file.open(output);
+    }
+    std::ostream &out = output.empty() ? std::cout : output_file;
+
+    if (format == "json") {
+        report.write_json(out);
+    } else if (format == "csv") {
+        report.write_csv(out);
+    } else {
+        report.write_text(out);
     }
 
+    if (!baseline.empty()) {
+        size_t regressions = report.compare(baseline, threshold / 100.0, std::cerr);
+        if (regressions > 0) {
+            std::cerr << regressions << " regression(s) against " << baseline << std::endl;
+            return 1;
+        }
+    }
 
     return 0;
 }
@@ -0,0 +1,295 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+// Replays fixed, representative workloads against the library, either to
+// train a profile guided build (NIX_PGO=generate) or to be recorded by perf.
+// Unlike nix-bench nothing is timed adaptively: the same calls are made in
+// the same order on every run, so profiles and flame graphs are comparable.
+
+#include <nix.hpp>
+#include <nix/util/dataAccess.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+/* ************************************ */
+
+// bulk read/write: a 2d signal written and read in blocks of rows, in the
+// stored type, converted and calibrated
+static void bulkWorkload(nix::Block &block, size_t scale) {
+    const size_t channels = 64;
+    const size_t rows = 32768 * scale;
+    const size_t block_rows = 512;
+
+    std::vector<int16_t> samples(block_rows * channels);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(-2048, 2047);
+
+    const nix::NDSize block_shape = {block_rows, channels};
+    nix::NDSize shape = block_shape;
+    shape[0] = 0;
+    nix::DataArray da = block.createDataArray("signal", "nix.profile", nix::DataType::Int16, shape,
+                                              nix::Compression::None, nix::ChunkingOptions(block_shape));
+    da.polynomCoefficients({0.0, 0.5});
+    for (size_t first = 0; first < rows; first += block_rows) {
+        std::generate(samples.begin(), samples.end(), [&] { return static_cast<int16_t>(dist(gen)); });
+        da.appendData(nix::DataType::Int16, samples.data(), block_shape, 0);
+    }
+
+    std::vector<int16_t> raw(samples.size());
+    std::vector<double> values(samples.size());
+    std::vector<float> calibrated(samples.size());
+    nix::NDSize offset(2, 0);
+    for (offset[0] = 0; offset[0] < rows; offset[0] += block_rows) {
+        da.getDataDirect(nix::DataType::Int16, raw.data(), block_shape, offset);
+        da.getData(nix::DataType::Double, values.data(), block_shape, offset);
+        da.getData(nix::DataType::Float, calibrated.data(), block_shape, offset);
+    }
+
+    // single channels across all rows
+    std::vector<double> channel(rows);
+    nix::NDSize channel_shape(2, 1);
+    channel_shape[0] = rows;
+    for (offset[0] = 0, offset[1] = 0; offset[1] < channels; offset[1] += 8) {
+        da.getData(nix::DataType::Double, channel.data(), channel_shape, offset);
+    }
+}
+
+
+// tagged retrieval: a MultiTag with positions and extents on a sampled
+// signal, with tagged and indexed features
+static void taggedWorkload(nix::Block &block, size_t scale) {
+    const size_t positions = 1000 * scale;
+    const size_t slot = 16;
+
+    std::vector<double> signal(positions * slot);
+    for (size_t i = 0; i < signal.size(); i++) {
+        signal[i] = std::sin(static_cast<double>(i) * 0.01);
+    }
+    nix::DataArray data = block.createDataArray("tagged_signal", "nix.profile", signal);
+    data.appendSampledDimension(0.001);
+
+    std::vector<double> pos(positions), ext(positions, 0.01);
+    for (size_t i = 0; i < positions; i++) {
+        pos[i] = static_cast<double>(i * slot) * 0.001;
+    }
+    nix::NDSize tag_shape(2, 1);
+    tag_shape[0] = positions;
+    nix::DataArray pos_da = block.createDataArray("tag_positions", "nix.profile", nix::DataType::Double, tag_shape);
+    pos_da.setData(nix::DataType::Double, pos.data(), tag_shape, {0, 0});
+    nix::DataArray ext_da = block.createDataArray("tag_extents", "nix.profile", nix::DataType::Double, tag_shape);
+    ext_da.setData(nix::DataType::Double, ext.data(), tag_shape, {0, 0});
+
+    std::vector<double> per_position(positions * 8, 1.0);
+    nix::NDSize indexed_shape(2, 8);
+    indexed_shape[0] = positions;
+    nix::DataArray indexed = block.createDataArray("tag_indexed", "nix.profile", nix::DataType::Double, indexed_shape);
+    indexed.setData(nix::DataType::Double, per_position.data(), indexed_shape, {0, 0});
+
+    nix::MultiTag mtag = block.createMultiTag("events", "nix.profile", pos_da);
+    mtag.extents(ext_da);
+    mtag.addReference(data);
+    nix::Feature tagged = mtag.createFeature(data, nix::LinkType::Tagged);
+    nix::Feature index_feature = mtag.createFeature(indexed, nix::LinkType::Indexed);
+
+    std::vector<double> buf;
+    auto read_view = [&buf](const nix::DataView &view) {
+        buf.resize(view.dataExtent().nelms());
+        view.getData(nix::DataType::Double, buf.data(), view.dataExtent(), nix::NDSize(view.dataExtent().size(), 0));
+    };
+
+    std::vector<nix::ndsize_t> all;
+    for (nix::DataView &view : nix::util::taggedData(mtag, all, data)) {
+        read_view(view);
+    }
+    for (size_t i = 0; i < positions; i += 7) {
+        read_view(nix::util::taggedData(mtag, i, data));
+        read_view(nix::util::featureData(mtag, i, tagged));
+    }
+
+    std::vector<nix::ndsize_t> shuffled(positions);
+    std::iota(shuffled.begin(), shuffled.end(), 0);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+    nix::util::indexedFeatureData(mtag, shuffled, index_feature);
+}
+
+
+// metadata search: a section tree with properties, entity lookups by name
+// and id and filtered searches
+static void metadataWorkload(nix::File &file, nix::Block &block, size_t scale) {
+    const size_t n = 250 * scale;
+
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < n; i++) {
+        nix::DataArray da = block.createDataArray("meta_" + std::to_string(i), i % 2 ? "nix.odd" : "nix.even",
+                                                  nix::DataType::Double, {4});
+        ids.push_back(da.id());
+    }
+
+    nix::Section root = file.createSection("tree", "nix.profile");
+    std::queue<nix::Section> parents;
+    parents.push(root);
+    for (size_t i = 1; i < n; ) {
+        nix::Section parent = parents.front();
+        parents.pop();
+        for (size_t k = 0; k < 4 && i < n; k++, i++) {
+            nix::Section child = parent.createSection("section_" + std::to_string(i), k % 2 ? "nix.odd" : "nix.even");
+            child.createProperty("value", nix::Variant(static_cast<double>(i)));
+            parents.push(child);
+        }
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    for (size_t i = 0; i < n; i++) {
+        block.getDataArray("meta_" + std::to_string(pick(gen)));
+        block.getDataArray(ids[pick(gen)]);
+    }
+
+    block.dataArrays(nix::util::TypeFilter<nix::DataArray>("nix.odd"));
+    root.findSections(nix::util::TypeFilter<nix::Section>("nix.odd"));
+    for (size_t i = 1; i < n; i += 25) {
+        std::vector<nix::Section> found = root.findSections(nix::util::NameFilter<nix::Section>("section_" + std::to_string(i)));
+        for (const nix::Section &s : found) {
+            s.getProperty("value").values();
+        }
+    }
+}
+
+
+// DataFrame scans: column writes and reads, row and cell access
+static void dataFrameWorkload(nix::Block &block, size_t scale) {
+    const size_t n = 20000 * scale;
+
+    std::vector<nix::Column> cols = {
+        {"trial", "", nix::DataType::Int32},
+        {"time", "ns", nix::DataType::Int64},
+        {"value", "mV", nix::DataType::Double},
+        {"label", "", nix::DataType::String}};
+    nix::DataFrame df = block.createDataFrame("frame", "nix.profile", cols);
+    df.rows(n);
+
+    std::vector<int32_t> trial(n);
+    std::vector<int64_t> time(n);
+    std::vector<double> value(n);
+    std::vector<std::string> label(n);
+    for (size_t i = 0; i < n; i++) {
+        trial[i] = static_cast<int32_t>(i / 100);
+        time[i] = static_cast<int64_t>(i) * 1000;
+        value[i] = std::sin(static_cast<double>(i) * 0.01);
+        label[i] = "label_" + std::to_string(i % 1000);
+    }
+
+    df.writeColumn("trial", trial);
+    df.writeColumn("time", time);
+    df.writeColumn("value", value);
+    df.writeColumn("label", label);
+
+    for (size_t pass = 0; pass < 4; pass++) {
+        df.readColumn("trial", trial, true);
+        df.readColumn("time", time, true);
+        df.readColumn("value", value, true);
+        df.readColumn("label", label, true);
+    }
+
+    for (size_t i = 0; i < n; i += 50) {
+        df.readRow(i);
+        df.readCells(i, {"value", "label"});
+        df.writeCells(i, {nix::Cell("value", -value[i])});
+    }
+}
+
+/* ************************************ */
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> workloads;
+    std::string path;
+    size_t scale, iterations;
+
+    po::options_description desc("Usage: nix-profile [options]\n\nOptions");
+    desc.add_options()
+        ("help,h", "print this help")
+        ("workload,w", po::value<std::vector<std::string>>(&workloads)->composing(),
+         "workloads to run: bulk, tagged, metadata, dataframe (default: all)")
+        ("scale,s", po::value<size_t>(&scale)->default_value(1), "multiplies the size of every workload")
+        ("iterations,n", po::value<size_t>(&iterations)->default_value(1), "number of times the workloads are run")
+        ("file", po::value<std::string>(&path)->default_value("nix-profile.h5"), "the file used by the workloads");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch (const std::exception &e) {
+        std::cerr << "nix-profile: " << e.what() << std::endl << desc << std::endl;
+        return 2;
+    }
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    const std::vector<std::string> known = {"bulk", "tagged", "metadata", "dataframe"};
+    for (const std::string &w : workloads) {
+        if (std::find(known.begin(), known.end(), w) == known.end()) {
+            std::cerr << "nix-profile: unknown workload " << w << std::endl;
+            return 2;
+        }
+    }
+    if (workloads.empty()) {
+        workloads = known;
+    }
+    scale = std::max<size_t>(1, scale);
+
+    try {
+        for (size_t it = 0; it < iterations; it++) {
+            for (const std::string &w : workloads) {
+                auto start = std::chrono::steady_clock::now();
+                {
+                    nix::File file = nix::File::open(path, nix::FileMode::Overwrite);
+                    nix::Block block = file.createBlock(w, "nix.profile");
+
+                    if (w == "bulk") {
+                        bulkWorkload(block, scale);
+                    } else if (w == "tagged") {
+                        taggedWorkload(block, scale);
+                    } else if (w == "metadata") {
+                        metadataWorkload(file, block, scale);
+                    } else {
+                        dataFrameWorkload(block, scale);
+                    }
+                    file.close();
+                }
+                std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+                std::cerr << w << ": " << secs.count() << " s" << std::endl;
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "nix-profile: " << e.what() << std::endl;
+        std::remove(path.c_str());
+        return 1;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
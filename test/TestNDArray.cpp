@@ -10,6 +10,8 @@
 
 #include <nix/NDArray.hpp>
 
+#include <cstdint>
+
 void TestNDArray::setUp() {
 }
 
@@ -45,5 +47,81 @@ void TestNDArray::basic() {
 
 }
 
+void TestNDArray::storage() {
+    nix::NDSize dims({4, 3});
+
+    // aligned storage that is zero initialized and kept when resizing
+    nix::NDArray A(nix::DataType::Double, dims, nix::defaultNDArrayAllocator(), 256);
+    CPPUNIT_ASSERT_EQUAL(size_t(256), A.alignment());
+    CPPUNIT_ASSERT_EQUAL(uintptr_t(0), reinterpret_cast<uintptr_t>(A.data()) % 256);
+    CPPUNIT_ASSERT_EQUAL(0.0, A.get<double>(11));
+    A.set<double>(5, 42.0);
+    A.resize({2, 3});
+    CPPUNIT_ASSERT_EQUAL(size_t(12 * sizeof(double)), A.capacity());
+    A.resize({8, 3});
+    CPPUNIT_ASSERT_EQUAL(42.0, A.get<double>(5));
+    CPPUNIT_ASSERT_EQUAL(0.0, A.get<double>(23));
+    CPPUNIT_ASSERT_EQUAL(uintptr_t(0), reinterpret_cast<uintptr_t>(A.data()) % 256);
+    CPPUNIT_ASSERT_THROW(nix::NDArray(nix::DataType::Double, dims, nix::defaultNDArrayAllocator(), 24),
+                         std::invalid_argument);
+
+    // copies are deep, moves take the storage
+    nix::NDArray B(A);
+    CPPUNIT_ASSERT(B.data() != A.data());
+    CPPUNIT_ASSERT_EQUAL(42.0, B.get<double>(5));
+    const nix::NDArray::byte_type *a_data = A.data();
+    nix::NDArray C(std::move(A));
+    CPPUNIT_ASSERT(C.data() == a_data);
+    CPPUNIT_ASSERT(A.data() == nullptr);
+    B = C;
+    CPPUNIT_ASSERT_EQUAL(42.0, B.get<double>(5));
+
+    // buffers released to a pool are reused
+    auto pool = std::make_shared<nix::NDArrayPool>();
+    const nix::NDArray::byte_type *pooled;
+    {
+        nix::NDArray P(nix::DataType::Int32, dims, pool);
+        pooled = P.data();
+    }
+    CPPUNIT_ASSERT(pool->cachedBytes() > 0);
+    for (size_t i = 0; i < 10; i++) {
+        nix::NDArray P(nix::DataType::Int32, dims, pool);
+        CPPUNIT_ASSERT(P.data() == pooled);
+        CPPUNIT_ASSERT_EQUAL(int32_t(0), P.get<int32_t>(0));
+        P.set<int32_t>(0, 7);
+    }
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), pool->misses());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(10), pool->hits());
+    pool->clear();
+    CPPUNIT_ASSERT_EQUAL(size_t(0), pool->cachedBytes());
+
+    // borrowed memory is used in place and cannot grow
+    std::vector<int16_t> external(12, 3);
+    {
+        nix::NDArray D = nix::NDArray::borrow(nix::DataType::Int16, dims, external.data());
+        CPPUNIT_ASSERT(D.borrowed());
+        CPPUNIT_ASSERT(D.data() == reinterpret_cast<nix::NDArray::byte_type *>(external.data()));
+        D.set<int16_t>(nix::NDSize({1, 1}), 9);
+        CPPUNIT_ASSERT_THROW(D.resize({5, 3}), std::length_error);
+        nix::NDArray E(D);
+        CPPUNIT_ASSERT(!E.borrowed());
+        CPPUNIT_ASSERT_EQUAL(int16_t(9), E.get<int16_t>(4));
+    }
+    CPPUNIT_ASSERT_EQUAL(int16_t(9), external[4]);
+
+    // adopted memory is released with the deleter
+    bool deleted = false;
+    {
+        double *raw = new double[12]();
+        nix::NDArray F = nix::NDArray::adopt(nix::DataType::Double, dims, raw, [&deleted](void *ptr) {
+            delete[] static_cast<double *>(ptr);
+            deleted = true;
+        });
+        CPPUNIT_ASSERT(!F.borrowed());
+        CPPUNIT_ASSERT(F.data() == reinterpret_cast<nix::NDArray::byte_type *>(raw));
+    }
+    CPPUNIT_ASSERT(deleted);
+}
+
 void TestNDArray::tearDown() {
 }
@@ -28,6 +28,7 @@ public:
 
     void setUp();
     void basic();
+    void storage();
     void tearDown();
 
 
@@ -35,6 +36,7 @@ private:
 
     CPPUNIT_TEST_SUITE(TestNDArray);
     CPPUNIT_TEST(basic);
+    CPPUNIT_TEST(storage);
     CPPUNIT_TEST_SUITE_END ();
 };
 
@@ -110,3 +110,57 @@ void TestNDSize::testAll() {
     CPPUNIT_ASSERT(!(t <= s));
     CPPUNIT_ASSERT(!(t < u));
 }
+
+
+void TestNDSize::testCopyMove() {
+    using namespace nix;
+
+    // ranks up to 4 are stored inline, larger ones on the heap
+    NDSize small({1, 2, 3});
+    NDSize large({1, 2, 3, 4, 5, 6});
+
+    NDSize small_copy(small);
+    NDSize large_copy(large);
+    CPPUNIT_ASSERT(small_copy == small);
+    CPPUNIT_ASSERT(large_copy == large);
+    CPPUNIT_ASSERT(small_copy.data() != small.data());
+    CPPUNIT_ASSERT(large_copy.data() != large.data());
+
+    small_copy[0] = 42;
+    CPPUNIT_ASSERT_EQUAL(static_cast<NDSize::value_type>(1), small[0]);
+
+    const NDSize::value_type *large_data = large_copy.data();
+    NDSize large_moved(std::move(large_copy));
+    CPPUNIT_ASSERT(large_moved == large);
+    CPPUNIT_ASSERT(large_moved.data() == large_data);
+    CPPUNIT_ASSERT(large_copy.empty());
+
+    NDSize small_moved(std::move(small_copy));
+    CPPUNIT_ASSERT_EQUAL(static_cast<NDSize::value_type>(42), small_moved[0]);
+    CPPUNIT_ASSERT(small_copy.empty());
+
+    // assignments across storage kinds
+    NDSize x = small;
+    x = large;
+    CPPUNIT_ASSERT(x == large);
+    x = small;
+    CPPUNIT_ASSERT(x == small);
+    x = std::move(large_moved);
+    CPPUNIT_ASSERT(x == large);
+    x = x;
+    CPPUNIT_ASSERT(x == large);
+
+    NDSize y = small;
+    x.swap(y);
+    CPPUNIT_ASSERT(x == small);
+    CPPUNIT_ASSERT(y == large);
+    x.swap(x);
+    CPPUNIT_ASSERT(x == small);
+
+    std::vector<NDSize> sizes(3, small);
+    sizes.push_back(large);
+    sizes.insert(sizes.begin(), NDSize({7}));
+    CPPUNIT_ASSERT(sizes[0] == NDSize({7}));
+    CPPUNIT_ASSERT(sizes[1] == small);
+    CPPUNIT_ASSERT(sizes[4] == large);
+}
@@ -28,6 +28,10 @@ class TestDataArrayHDF5 : public BaseTestDataArray {
     CPPUNIT_TEST(testDimension);
     CPPUNIT_TEST(testAliasRangeDimension);
     CPPUNIT_TEST(testDataFrameDimension);
+    CPPUNIT_TEST(testChunking);
+    CPPUNIT_TEST(testChunkIO);
+    CPPUNIT_TEST(testCompressionThreads);
+    CPPUNIT_TEST(testMemoryLimit);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
     CPPUNIT_TEST_SUITE_END ();
@@ -9,6 +9,7 @@
 #include "TestDataSet.hpp"
 
 #include "hdf5/h5x/H5DataSet.hpp"
+#include "hdf5/h5x/WorkerPool.hpp"
 #include <nix/NDArray.hpp>
 
 #include <type_traits>
@@ -90,6 +91,39 @@ void TestDataSet::testChunkGuessing() {
 }
 
 
+void TestDataSet::testChunkAdvice() {
+    const size_t cache = 1024 * 1024;
+
+    // append along time, read along time (channel-wise)
+    // (384 chunks of 2.7 KB would fit the cache, but a chunk is at least 8 KB)
+    NDSize chunks = hdf5::DataSet::adviseChunking({0, 384}, 2, 0, 0, cache);
+    CPPUNIT_ASSERT_EQUAL((NDSize{4096, 1}), chunks);
+
+    // append along time, read along channels (time slices)
+    chunks = hdf5::DataSet::adviseChunking({0, 384}, 2, 0, 1, cache);
+    CPPUNIT_ASSERT_EQUAL((NDSize{1365, 384}), chunks);
+
+    // a single chunk never exceeds the cache
+    chunks = hdf5::DataSet::adviseChunking({100, 1000000}, 8, boost::none, 1, cache);
+    CPPUNIT_ASSERT(chunks.nelms() * 8 <= cache);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), chunks[0]);
+
+    // nor the upper chunk bound, even if the cache is larger
+    std::tuple<ndsize_t, ndsize_t> min_max = hdf5::DataSet::getChunkBounds();
+    chunks = hdf5::DataSet::adviseChunking({100, 1000000}, 8, boost::none, 1, 64 * cache);
+    CPPUNIT_ASSERT(chunks.nelms() * 8 <= std::get<1>(min_max));
+
+    // small data sets are chunked whole
+    CPPUNIT_ASSERT_EQUAL((NDSize{10, 10}), hdf5::DataSet::adviseChunking({10, 10}, 8, boost::none, 1, cache));
+
+    // no hint falls back to the guess
+    CPPUNIT_ASSERT_EQUAL(hdf5::DataSet::guessChunking({10, 10}, 8),
+                         hdf5::DataSet::adviseChunking({10, 10}, 8, boost::none, boost::none, cache));
+
+    CPPUNIT_ASSERT_THROW(hdf5::DataSet::adviseChunking({10, 10}, 8, 2, boost::none, cache), InvalidRank);
+}
+
+
 void TestDataSet::testDataType() {
     static struct _type_info {
         std::string name;
@@ -249,6 +283,117 @@ void TestDataSet::testBasic() {
 }
 
 
+void TestDataSet::testCompression() {
+    std::vector<int16_t> data(4096);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<int16_t>(i % 128);
+    }
+    hdf5::h5x::DataType fileType = hdf5::data_type_to_h5_filetype(DataType::Int16);
+
+    CompressionOptions opts(CompressionCodec::Deflate, 1, ShuffleFilter::Byte);
+    hdf5::DataSet ds = h5group.createData("dsDeflate", fileType, {data.size()}, opts);
+    ds.write(data);
+
+    hid_t dcpl = H5Dget_create_plist(ds.h5id());
+    CPPUNIT_ASSERT_EQUAL(2, H5Pget_nfilters(dcpl));
+    unsigned int flags, values[1];
+    size_t nvalues = 1;
+    CPPUNIT_ASSERT_EQUAL(H5Z_FILTER_SHUFFLE, H5Pget_filter2(dcpl, 0, &flags, &nvalues, values, 0, nullptr, nullptr));
+    nvalues = 1;
+    CPPUNIT_ASSERT_EQUAL(H5Z_FILTER_DEFLATE, H5Pget_filter2(dcpl, 1, &flags, &nvalues, values, 0, nullptr, nullptr));
+    CPPUNIT_ASSERT_EQUAL(1u, values[0]);
+    H5Pclose(dcpl);
+
+    std::vector<int16_t> read;
+    ds.read(read, true);
+    CPPUNIT_ASSERT(read == data);
+
+    // Auto and None do not add any filter
+    ds = h5group.createData("dsAuto", fileType, {data.size()}, Compression::Auto);
+    dcpl = H5Dget_create_plist(ds.h5id());
+    CPPUNIT_ASSERT_EQUAL(0, H5Pget_nfilters(dcpl));
+    H5Pclose(dcpl);
+
+    CPPUNIT_ASSERT_THROW(h5group.createData("dsBadLevel", fileType, {data.size()},
+                                            CompressionOptions(CompressionCodec::Deflate, 10)),
+                         std::invalid_argument);
+
+    // plugin codecs either work or report that the plugin is missing
+    if (H5Zfilter_avail(32015) > 0) {
+        ds = h5group.createData("dsZstd", fileType, {data.size()}, CompressionOptions(CompressionCodec::Zstd, 5));
+        ds.write(data);
+        ds.read(read, true);
+        CPPUNIT_ASSERT(read == data);
+    } else {
+        CPPUNIT_ASSERT_THROW(h5group.createData("dsZstd", fileType, {data.size()},
+                                                CompressionOptions(CompressionCodec::Zstd, 5)),
+                             std::runtime_error);
+    }
+}
+
+
+void TestDataSet::testParallelCompression() {
+    NDSize extent({64, 10});
+    std::vector<int32_t> data(extent.nelms());
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<int32_t>((i * 7) % 100);
+    }
+    hdf5::h5x::DataType fileType = hdf5::data_type_to_h5_filetype(DataType::Int32);
+    hdf5::h5x::DataType memType = hdf5::data_type_to_h5_memtype(DataType::Int32);
+
+    CompressionOptions opts(CompressionCodec::Deflate, 4, ShuffleFilter::Byte);
+    hdf5::DataSet ds = h5group.createData("dsParallel", fileType, extent, opts, {}, {16, 4});
+
+    std::vector<int32_t> block(16 * 4, 42);
+    std::vector<int32_t> read(data.size());
+
+#if defined(NIX_HAVE_ZLIB) && H5_VERSION_GE(1, 10, 3)
+    // the last chunk column is cut by the extent
+    CPPUNIT_ASSERT(ds.writeChunksParallel(data.data(), memType, extent, {0, 0}, 3));
+    ds.read(read.data(), memType, extent, {0, 0});
+    CPPUNIT_ASSERT(read == data);
+    const size_t pool_size = hdf5::h5x::WorkerPool::shared().size();
+    CPPUNIT_ASSERT(pool_size >= 3);
+
+    // a selection of whole chunks inside the data set, on the same threads
+    CPPUNIT_ASSERT(ds.writeChunksParallel(block.data(), memType, {16, 4}, {32, 4}, 2));
+    CPPUNIT_ASSERT_EQUAL(pool_size, hdf5::h5x::WorkerPool::shared().size());
+    ds.read(read.data(), memType, extent, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(42, read[32 * 10 + 4]);
+    CPPUNIT_ASSERT_EQUAL(42, read[47 * 10 + 7]);
+    CPPUNIT_ASSERT_EQUAL(data[47 * 10 + 8], read[47 * 10 + 8]);
+
+    // the whole chunks of an unaligned selection are split off, the rest goes through H5Dwrite
+    std::vector<int32_t> unaligned(40 * 7);
+    for (size_t i = 0; i < unaligned.size(); i++) {
+        unaligned[i] = -static_cast<int32_t>(i);
+    }
+    CPPUNIT_ASSERT(ds.writeChunksParallel(unaligned.data(), memType, {40, 7}, {10, 2}, 2));
+    ds.read(read.data(), memType, extent, {0, 0});
+    for (size_t r = 10; r < 50; r++) {
+        for (size_t c = 2; c < 9; c++) {
+            CPPUNIT_ASSERT_EQUAL(unaligned[(r - 10) * 7 + c - 2], read[r * 10 + c]);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(data[10 * 10 + 9], read[10 * 10 + 9]);
+    CPPUNIT_ASSERT_EQUAL(data[50 * 10 + 2], read[50 * 10 + 2]);
+#else
+    // without zlib (or raw chunk IO) all writes go through the filter pipeline
+    CPPUNIT_ASSERT(!ds.writeChunksParallel(data.data(), memType, extent, {0, 0}, 3));
+#endif
+
+    // selections without a whole chunk, type conversions and other filters are left to H5Dwrite
+    CPPUNIT_ASSERT(!ds.writeChunksParallel(block.data(), memType, {16, 4}, {8, 0}, 2));
+    CPPUNIT_ASSERT(!ds.writeChunksParallel(block.data(), memType, {10, 4}, {0, 0}, 2));
+    CPPUNIT_ASSERT(!ds.writeChunksParallel(block.data(), hdf5::data_type_to_h5_memtype(DataType::Int64),
+                                           {16, 4}, {0, 0}, 2));
+    CPPUNIT_ASSERT(!ds.writeChunksParallel(block.data(), memType, {16, 4}, {0, 0}, 0));
+
+    hdf5::DataSet plain = h5group.createData("dsParallelNone", fileType, extent, Compression::None, {}, {16, 4});
+    CPPUNIT_ASSERT(!plain.writeChunksParallel(data.data(), memType, extent, {0, 0}, 2));
+}
+
+
 void TestDataSet::testNDArrayIO()
 {
     nix::NDSize dims({5, 5});
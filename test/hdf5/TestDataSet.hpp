@@ -33,10 +33,13 @@ public:
 
     void setUp();
     void testChunkGuessing();
+    void testChunkAdvice();
     void testDataType();
     void testDataTypeFromString();
     void testDataTypeIsNumeric();
     void testBasic();
+    void testCompression();
+    void testParallelCompression();
     void testNDArrayIO();
     void testValArrayIO();
     void testOpaqueIO();
@@ -51,10 +54,13 @@ private:
 
     CPPUNIT_TEST_SUITE(TestDataSet);
     CPPUNIT_TEST(testChunkGuessing);
+    CPPUNIT_TEST(testChunkAdvice);
     CPPUNIT_TEST(testDataType);
     CPPUNIT_TEST(testDataTypeFromString);
     CPPUNIT_TEST(testDataTypeIsNumeric);
     CPPUNIT_TEST(testBasic);
+    CPPUNIT_TEST(testCompression);
+    CPPUNIT_TEST(testParallelCompression);
     CPPUNIT_TEST(testNDArrayIO);
     CPPUNIT_TEST(testValArrayIO);
     CPPUNIT_TEST(testOpaqueIO);
@@ -13,10 +13,21 @@
 #include "hdf5/h5x/H5Object.hpp"
 #include "hdf5/h5x/H5Group.hpp"
 #include "hdf5/FileHDF5.hpp"
+#include "hdf5/CatalogHDF5.hpp"
 
 #include <sstream>
+#include <numeric>
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
 #include <nix/util/util.hpp>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace h5x = nix::hdf5;
 
 static std::string make_file_with_version(int x, int y, int z, const std::string &format="nix") {
@@ -116,3 +127,670 @@ void TestFileHDF5::testVersion() {
         f.close();
     }
 }
+
+
+#ifndef _WIN32
+// The SWMR reader of testSwmr, run in a child process so that it opens the file
+// independently of the writer. Waits for a byte on from_writer before each step
+// and acknowledges the first one; returns the exit code of the child.
+static int swmrReader(int from_writer, int to_writer, const std::vector<double> &values) {
+    char step;
+    try {
+        if (read(from_writer, &step, 1) != 1) {
+            return 2;
+        }
+        nix::File reader = nix::File::open("test_file_swmr.h5", nix::FileMode::SwmrRead);
+        nix::DataArray tail = reader.getBlock("recording").getDataArray("signal");
+        if (reader.fileMode() != nix::FileMode::SwmrRead || tail.dataExtent() != nix::NDSize({8})) {
+            return 3;
+        }
+        if (write(to_writer, &step, 1) != 1 || read(from_writer, &step, 1) != 1) {
+            return 2;
+        }
+
+        // the data appended by the writer is only visible after a refresh
+        tail.refresh();
+        if (tail.dataExtent() != nix::NDSize({16})) {
+            return 4;
+        }
+        std::vector<double> read_values(16);
+        tail.getData(nix::DataType::Double, read_values.data(), {16}, {0});
+        if (read_values != values) {
+            return 5;
+        }
+        reader.close();
+    } catch (...) {
+        return 6;
+    }
+    return 0;
+}
+#endif
+
+
+void TestFileHDF5::testSwmr() {
+    std::vector<double> values(16);
+    std::iota(values.begin(), values.end(), 0.0);
+    std::remove("test_file_swmr.h5");
+
+#ifndef _WIN32
+    int to_reader[2], to_writer[2];
+    CPPUNIT_ASSERT(pipe(to_reader) == 0 && pipe(to_writer) == 0);
+    pid_t child = fork();
+    CPPUNIT_ASSERT(child >= 0);
+    if (child == 0) {
+        close(to_reader[1]);
+        close(to_writer[0]);
+        // skip the exit handlers, they would close the files inherited from the parent
+        _exit(swmrReader(to_reader[0], to_writer[1], values));
+    }
+    close(to_reader[0]);
+    close(to_writer[1]);
+#endif
+
+    nix::File writer = nix::File::open("test_file_swmr.h5", nix::FileMode::SwmrWrite);
+    CPPUNIT_ASSERT(writer.fileMode() == nix::FileMode::SwmrWrite);
+    nix::Block block = writer.createBlock("recording", "nix.test");
+    nix::DataArray da = block.createDataArray("signal", "nix.test", nix::DataType::Double, {8},
+                                              nix::Compression::None, nix::ChunkingOptions(nix::NDSize({8})));
+    da.setData(nix::DataType::Double, values.data(), {8}, {0});
+    writer.flush();
+
+#ifndef _WIN32
+    char step = 1;
+    bool opened = write(to_reader[1], &step, 1) == 1 && read(to_writer[0], &step, 1) == 1;
+#endif
+
+    da.appendData(nix::DataType::Double, values.data() + 8, {8}, 0);
+    writer.flush();
+
+#ifndef _WIN32
+    if (opened) {
+        CPPUNIT_ASSERT(write(to_reader[1], &step, 1) == 1);
+    }
+    close(to_reader[1]);
+    close(to_writer[0]);
+    int status = 0;
+    CPPUNIT_ASSERT(waitpid(child, &status, 0) == child);
+    CPPUNIT_ASSERT(WIFEXITED(status));
+    CPPUNIT_ASSERT_EQUAL(0, WEXITSTATUS(status));
+#endif
+    writer.close();
+
+    // files in the default format cannot be written in SWMR mode
+    nix::File plain = nix::File::open("test_file_swmr_plain.h5", nix::FileMode::Overwrite);
+    plain.close();
+    CPPUNIT_ASSERT_THROW(nix::File::open("test_file_swmr_plain.h5", nix::FileMode::SwmrWrite),
+                         nix::hdf5::H5Exception);
+    CPPUNIT_ASSERT_THROW(nix::File::open("test_file_swmr_missing.h5", nix::FileMode::SwmrRead), std::runtime_error);
+}
+
+
+void TestFileHDF5::testInMemory() {
+    auto exists = [](const std::string &path) { return static_cast<bool>(std::ifstream(path)); };
+    std::remove("test_file_memory.h5");
+    std::remove("test_file_memory_store.h5");
+
+    nix::File mem = nix::File::open("test_file_memory.h5", nix::FileMode::Overwrite, "hdf5",
+                                    nix::Compression::Auto, nix::OpenFlags::InMemory);
+    nix::Block block = mem.createBlock("in_memory", "nix.test");
+    std::vector<int32_t> values = {1, 2, 3, 4};
+    block.createDataArray("data", "nix.test", values);
+
+    std::vector<char> image = mem.image();
+    CPPUNIT_ASSERT(!image.empty());
+    mem.close();
+    CPPUNIT_ASSERT(!exists("test_file_memory.h5"));
+
+    // opening an image works on a copy
+    nix::File copy = nix::File::openImage(image.data(), image.size(), nix::FileMode::ReadWrite);
+    CPPUNIT_ASSERT(copy.hasBlock("in_memory"));
+    std::vector<int32_t> read;
+    copy.getBlock("in_memory").getDataArray("data").getData(read);
+    CPPUNIT_ASSERT(read == values);
+    copy.createBlock("added", "nix.test");
+    std::vector<char> changed = copy.image();
+    copy.close();
+
+    nix::File ro = nix::File::openImage(changed.data(), changed.size());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), ro.blockCount());
+    CPPUNIT_ASSERT_THROW(ro.createBlock("forbidden", "nix.test"), nix::hdf5::H5Exception);
+    ro.close();
+    ro = nix::File::openImage(image.data(), image.size());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), ro.blockCount());
+    ro.close();
+
+    // with a backing store the file is written on close
+    nix::File stored = nix::File::open("test_file_memory_store.h5", nix::FileMode::Overwrite, "hdf5",
+                                       nix::Compression::Auto,
+                                       nix::OpenFlags::InMemory | nix::OpenFlags::BackingStore);
+    stored.createBlock("stored", "nix.test");
+    stored.close();
+    CPPUNIT_ASSERT(exists("test_file_memory_store.h5"));
+    stored = nix::File::open("test_file_memory_store.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT(stored.hasBlock("stored"));
+    stored.close();
+}
+
+
+void TestFileHDF5::testRepack() {
+    auto file_size = [](const std::string &path) {
+        std::ifstream f(path, std::ios::binary | std::ios::ate);
+        return static_cast<long>(f.tellg());
+    };
+
+    std::vector<double> values(4096);
+    std::iota(values.begin(), values.end(), 0.0);
+    std::vector<double> bulk(512 * 1024, 1.0);
+    std::string file_id, block_id, array_id, section_id;
+    {
+        nix::File f = nix::File::open("test_file_repack.h5", nix::FileMode::Overwrite);
+        nix::Block first = f.createBlock("first", "nix.test");
+        f.createBlock("second", "nix.test");
+        f.createBlock("a_third", "nix.test");
+        nix::Section section = f.createSection("settings", "nix.test");
+        section.createProperty("gain", nix::Variant(10.0));
+
+        nix::DataArray bulky = first.createDataArray("bulky", "nix.test", bulk);
+        nix::DataArray kept = first.createDataArray("kept", "nix.test", values);
+        nix::Tag tag = first.createTag("tag", "nix.test", {1.0});
+        tag.addReference(kept);
+        tag.metadata(section);
+        kept.metadata(section);
+        first.deleteDataArray(bulky);
+
+        file_id = f.id();
+        block_id = first.id();
+        array_id = kept.id();
+        section_id = section.id();
+        f.close();
+    }
+
+    nix::File f = nix::File::open("test_file_repack.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT_THROW(f.repack("test_file_repack.h5"), std::invalid_argument);
+    f.repack("test_file_repack_out.h5");
+    CPPUNIT_ASSERT(file_size("test_file_repack_out.h5") < file_size("test_file_repack.h5") / 2);
+
+    nix::RepackOptions opts;
+    opts.compression = nix::CompressionOptions(nix::CompressionCodec::Deflate, 1);
+    opts.chunking = nix::ChunkingOptions(nix::NDSize({1000}));
+    opts.buffer_size = 1500 * sizeof(double);
+    f.repack("test_file_repack_chunked.h5", opts);
+    f.close();
+
+    nix::File out = nix::File::open("test_file_repack_out.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT_EQUAL(file_id, out.id());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(3), out.blockCount());
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), out.getBlock(0).name());
+    CPPUNIT_ASSERT_EQUAL(std::string("a_third"), out.getBlock(2).name());
+
+    nix::Block block = out.getBlock("first");
+    CPPUNIT_ASSERT_EQUAL(block_id, block.id());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), block.dataArrayCount());
+    nix::DataArray kept = block.getDataArray(array_id);
+    CPPUNIT_ASSERT(kept);
+    std::vector<double> read;
+    kept.getData(read);
+    CPPUNIT_ASSERT(read == values);
+
+    nix::Tag tag = block.getTag("tag");
+    CPPUNIT_ASSERT(tag.hasReference(array_id));
+    CPPUNIT_ASSERT_EQUAL(section_id, tag.metadata().id());
+    CPPUNIT_ASSERT_EQUAL(section_id, kept.metadata().id());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), out.sectionCount());
+    CPPUNIT_ASSERT_EQUAL(10.0, out.getSection(section_id).getProperty("gain").values()[0].get<double>());
+    out.close();
+
+    nix::File chunked = nix::File::open("test_file_repack_chunked.h5", nix::FileMode::ReadOnly);
+    kept = chunked.getBlock("first").getDataArray("kept");
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({1000}), kept.chunkShape());
+    kept.getData(read);
+    CPPUNIT_ASSERT(read == values);
+    chunked.close();
+}
+
+
+void TestFileHDF5::testFileOptions() {
+    nix::FileOptions opts;
+    opts.paged = true;
+    opts.page_size = 16 * 1024;
+    opts.metadata_block_size = 8 * 1024;
+    opts.format_low = nix::FormatBound::V18;
+
+#if H5_VERSION_GE(1, 10, 1)
+    nix::File f = nix::File::open("test_file_paged.h5", nix::FileMode::Overwrite, opts);
+    for (int i = 0; i < 10; i++) {
+        f.createBlock("block_" + nix::util::numToStr(i), "nix.test");
+    }
+    f.close();
+
+    {
+        h5x::H5Object file = H5Fopen("test_file_paged.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        file.check("Could not open file");
+        h5x::H5Object fcpl = H5Fget_create_plist(file.h5id());
+        H5F_fspace_strategy_t strategy;
+        hbool_t persist;
+        hsize_t threshold, page_size;
+        H5Pget_file_space_strategy(fcpl.h5id(), &strategy, &persist, &threshold);
+        H5Pget_file_space_page_size(fcpl.h5id(), &page_size);
+        CPPUNIT_ASSERT_EQUAL(H5F_FSPACE_STRATEGY_PAGE, strategy);
+        CPPUNIT_ASSERT_EQUAL(hsize_t(16 * 1024), page_size);
+    }
+
+    nix::FileOptions access;
+    access.page_buffer_size = 1024 * 1024;
+    f = nix::File::open("test_file_paged.h5", nix::FileMode::ReadOnly, access);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(10), f.blockCount());
+    CPPUNIT_ASSERT(f.hasBlock("block_9"));
+    f.close();
+
+    // page buffers require paged files
+    nix::File plain = nix::File::open("test_file_unpaged.h5", nix::FileMode::Overwrite);
+    plain.close();
+    CPPUNIT_ASSERT_THROW(nix::File::open("test_file_unpaged.h5", nix::FileMode::ReadOnly, access),
+                         nix::hdf5::H5Exception);
+#else
+    // file space strategies and page buffers need HDF5 1.10.1
+    CPPUNIT_ASSERT_THROW(nix::File::open("test_file_paged.h5", nix::FileMode::Overwrite, opts), std::runtime_error);
+#endif
+}
+
+
+void TestFileHDF5::testEntityLayout() {
+    nix::FileOptions opts;
+    opts.entity_layout = nix::EntityLayout::Compact;
+
+    nix::File f = nix::File::open("test_file_compact.h5", nix::FileMode::Overwrite, opts);
+    nix::Block b = f.createBlock("block", "nix.test");
+    std::string block_id = b.id();
+    time_t created = b.createdAt();
+    for (int i = 0; i < 40; i++) {
+        b.createTag("tag_" + nix::util::numToStr(i), "nix.test", {1.0});
+    }
+    f.close();
+
+    {
+        h5x::H5Object file = H5Fopen("test_file_compact.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        file.check("Could not open file");
+        h5x::H5Object attr = H5Aopen_by_name(file.h5id(), "data/block", "entity_id", H5P_DEFAULT, H5P_DEFAULT);
+        attr.check("Could not open attribute");
+        h5x::H5Object type = H5Aget_type(attr.h5id());
+        CPPUNIT_ASSERT_EQUAL(H5T_STRING, H5Tget_class(type.h5id()));
+        CPPUNIT_ASSERT(H5Tis_variable_str(type.h5id()) == 0);
+
+        // 40 tags exceed the compact link limit
+        h5x::H5Object tags = H5Gopen(file.h5id(), "data/block/tags", H5P_DEFAULT);
+        tags.check("Could not open group");
+        H5G_info_t info;
+        H5Gget_info(tags.h5id(), &info);
+        CPPUNIT_ASSERT_EQUAL(H5G_STORAGE_TYPE_DENSE, info.storage_type);
+        h5x::H5Object tag = H5Gopen(tags.h5id(), "tag_0", H5P_DEFAULT);
+        H5Gget_info(tag.h5id(), &info);
+        CPPUNIT_ASSERT_EQUAL(H5G_STORAGE_TYPE_COMPACT, info.storage_type);
+    }
+
+    f = nix::File::open("test_file_compact.h5", nix::FileMode::ReadWrite);
+    b = f.getBlock("block");
+    CPPUNIT_ASSERT_EQUAL(block_id, b.id());
+    CPPUNIT_ASSERT_EQUAL(created, b.createdAt());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(40), b.tagCount());
+
+    time_t past = created - 10000;
+    b.forceUpdatedAt();
+    b.forceCreatedAt(past);
+    CPPUNIT_ASSERT_EQUAL(past, b.createdAt());
+
+    // entities added later keep the layout
+    nix::Block c = f.createBlock("other", "nix.test");
+    CPPUNIT_ASSERT_EQUAL(c.id(), f.getBlock("other").id());
+    f.close();
+
+    {
+        h5x::H5Object file = H5Fopen("test_file_compact.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        file.check("Could not open file");
+        h5x::H5Object other = H5Gopen(file.h5id(), "data/other", H5P_DEFAULT);
+        other.check("Could not open group");
+        h5x::H5Object gcpl = H5Gget_create_plist(other.h5id());
+        unsigned max_compact, min_dense;
+        H5Pget_link_phase_change(gcpl.h5id(), &max_compact, &min_dense);
+        CPPUNIT_ASSERT_EQUAL(32u, max_compact);
+        CPPUNIT_ASSERT_EQUAL(24u, min_dense);
+    }
+}
+
+
+void TestFileHDF5::testCatalog() {
+    nix::FileOptions opts;
+    opts.catalog = true;
+
+    nix::File f = nix::File::open("test_file_catalog.h5", nix::FileMode::Overwrite, opts);
+    nix::Block b = f.createBlock("block", "nix.test");
+    nix::DataArray da = b.createDataArray("array", "nix.test", nix::DataType::Double, {4});
+    nix::Source src = b.createSource("source", "nix.test");
+    nix::Source child = src.createSource("child", "nix.test");
+    nix::Tag tag = b.createTag("tag", "nix.test", {1.0});
+    tag.addReference(da);
+    tag.addSource(child);
+    nix::Section sec = f.createSection("section", "nix.test");
+    nix::Section sub = sec.createSection("subsection", "nix.test");
+    nix::Property prop = sub.createProperty("prop", nix::Variant(42));
+    tag.metadata(sub);
+    const std::string block_id = b.id(), src_id = src.id(), prop_id = prop.id();
+    const std::string tag_id = tag.id(), child_id = child.id(), sub_id = sub.id(), da_id = da.id();
+    f.close();
+
+    {
+        h5x::H5Object file = H5Fopen("test_file_catalog.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        file.check("Could not open file");
+        nix::hdf5::H5Group root = nix::hdf5::H5Group(H5Gopen(file.h5id(), "/", H5P_DEFAULT));
+        CPPUNIT_ASSERT(nix::hdf5::CatalogHDF5::isValid(root));
+        nix::hdf5::CatalogHDF5 catalog = nix::hdf5::CatalogHDF5::load(root);
+        // linked entities are listed once, at their owner
+        CPPUNIT_ASSERT_EQUAL(size_t(8), catalog.entries().size());
+
+        const nix::hdf5::CatalogEntry *entry = catalog.find(child_id);
+        CPPUNIT_ASSERT(entry != nullptr);
+        CPPUNIT_ASSERT_EQUAL(std::string("child"), entry->name);
+        CPPUNIT_ASSERT_EQUAL(std::string("Source"), entry->object_type);
+        CPPUNIT_ASSERT_EQUAL(src_id, entry->parent);
+        CPPUNIT_ASSERT_EQUAL(std::string("/data/block/sources/source/sources/child"), entry->path);
+
+        entry = catalog.find(tag_id);
+        CPPUNIT_ASSERT(entry != nullptr);
+        CPPUNIT_ASSERT_EQUAL(sub_id, entry->metadata);
+        CPPUNIT_ASSERT_EQUAL(block_id, entry->parent);
+        CPPUNIT_ASSERT(catalog.find(prop_id) != nullptr);
+    }
+
+    f = nix::File::open("test_file_catalog.h5", nix::FileMode::ReadOnly);
+    b = f.getBlock(block_id);
+    CPPUNIT_ASSERT(b);
+    CPPUNIT_ASSERT_EQUAL(da_id, b.getDataArray(da_id).id());
+    CPPUNIT_ASSERT_EQUAL(tag_id, b.getTag(tag_id).id());
+    CPPUNIT_ASSERT_EQUAL(child_id, b.getSource("source").getSource(child_id).id());
+    CPPUNIT_ASSERT_EQUAL(sub_id, f.getSection("section").getSection(sub_id).id());
+    CPPUNIT_ASSERT(!b.hasDataArray(tag_id));
+    CPPUNIT_ASSERT(!f.hasBlock(nix::util::createId()));
+    f.close();
+
+    // writers mark the catalog stale and save the rows of the entities they changed on close
+    f = nix::File::open("test_file_catalog.h5", nix::FileMode::ReadWrite);
+    b = f.getBlock("block");
+    b.deleteDataArray(da_id);
+    nix::DataArray other = b.createDataArray("other", "nix.test", nix::DataType::Double, {4});
+    const std::string other_id = other.id();
+    nix::Tag tag2 = b.createTag("tag2", "nix.test", {2.0});
+    tag2.createFeature(other, nix::LinkType::Tagged);
+    tag2.metadata(f.getSection("section"));
+    b.getSource("source").createSource("child2", "nix.test");
+    b.getSource("source").deleteSource(child_id);
+    b.getTag(tag_id).type("nix.other");
+    f.getSection("section").deleteSection(sub_id);
+    f.createSection("section2", "nix.test").createProperty("prop2", nix::Variant(1.0));
+    f.createBlock("block2", "nix.test").createDataArray("array", "nix.test", nix::DataType::Double, {4});
+    f.deleteBlock(f.createBlock("block3", "nix.test").id());
+    {
+        auto h5file = std::dynamic_pointer_cast<nix::hdf5::FileHDF5>(f.impl());
+        nix::hdf5::H5Group root = nix::hdf5::H5Group(H5Gopen(h5file->h5id(), "/", H5P_DEFAULT));
+        CPPUNIT_ASSERT(!nix::hdf5::CatalogHDF5::isValid(root));
+    }
+    f.close();
+
+    {
+        // the saved rows are those a walk of all groups gives
+        h5x::H5Object file = H5Fopen("test_file_catalog.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        file.check("Could not open file");
+        nix::hdf5::H5Group root = nix::hdf5::H5Group(H5Gopen(file.h5id(), "/", H5P_DEFAULT));
+        CPPUNIT_ASSERT(nix::hdf5::CatalogHDF5::isValid(root));
+        nix::hdf5::CatalogHDF5 saved = nix::hdf5::CatalogHDF5::load(root);
+        nix::hdf5::CatalogHDF5 walked = nix::hdf5::CatalogHDF5::build(root);
+        CPPUNIT_ASSERT_EQUAL(walked.entries().size(), saved.entries().size());
+        for (const nix::hdf5::CatalogEntry &row : walked.entries()) {
+            const nix::hdf5::CatalogEntry *entry = saved.find(row.id);
+            CPPUNIT_ASSERT(entry != nullptr);
+            CPPUNIT_ASSERT_EQUAL(row.name, entry->name);
+            CPPUNIT_ASSERT_EQUAL(row.type, entry->type);
+            CPPUNIT_ASSERT_EQUAL(row.object_type, entry->object_type);
+            CPPUNIT_ASSERT_EQUAL(row.parent, entry->parent);
+            CPPUNIT_ASSERT_EQUAL(row.path, entry->path);
+            CPPUNIT_ASSERT_EQUAL(row.metadata, entry->metadata);
+            CPPUNIT_ASSERT_EQUAL(row.created_at, entry->created_at);
+            CPPUNIT_ASSERT_EQUAL(row.updated_at, entry->updated_at);
+        }
+        CPPUNIT_ASSERT(saved.find(da_id) == nullptr);
+        CPPUNIT_ASSERT(saved.find(child_id) == nullptr);
+        CPPUNIT_ASSERT(saved.find(prop_id) == nullptr);
+        CPPUNIT_ASSERT_EQUAL(std::string(), saved.find(tag_id)->metadata);
+        CPPUNIT_ASSERT_EQUAL(std::string("nix.other"), saved.find(tag_id)->type);
+    }
+
+    f = nix::File::open("test_file_catalog.h5", nix::FileMode::ReadOnly);
+    b = f.getBlock("block");
+    CPPUNIT_ASSERT(!b.hasDataArray(da_id));
+    CPPUNIT_ASSERT_EQUAL(other_id, b.getDataArray(other_id).id());
+    f.close();
+
+    // writers that change nothing only mark the catalog valid again
+    hsize_t catalog_addr = 0;
+    auto catalogAddress = [](const nix::hdf5::H5Group &root) {
+        H5O_info_t info;
+        nix::hdf5::HErr res = H5Oget_info_by_name(root.h5id(), "catalog", &info, H5P_DEFAULT);
+        res.check("Could not get catalog info");
+        return static_cast<hsize_t>(info.addr);
+    };
+    {
+        h5x::H5Object file = H5Fopen("test_file_catalog.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        file.check("Could not open file");
+        catalog_addr = catalogAddress(nix::hdf5::H5Group(H5Gopen(file.h5id(), "/", H5P_DEFAULT)));
+    }
+    f = nix::File::open("test_file_catalog.h5", nix::FileMode::ReadWrite);
+    CPPUNIT_ASSERT_EQUAL(other_id, f.getBlock("block").getDataArray(other_id).id());
+    f.close();
+    {
+        h5x::H5Object file = H5Fopen("test_file_catalog.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        file.check("Could not open file");
+        nix::hdf5::H5Group root = nix::hdf5::H5Group(H5Gopen(file.h5id(), "/", H5P_DEFAULT));
+        CPPUNIT_ASSERT(nix::hdf5::CatalogHDF5::isValid(root));
+        CPPUNIT_ASSERT_EQUAL(catalog_addr, catalogAddress(root));
+    }
+
+    // entities a writer without catalog support added are still found
+    const std::string foreign_id = nix::util::createId();
+    {
+        h5x::H5Object file = H5Fopen("test_file_catalog.h5", H5F_ACC_RDWR, H5P_DEFAULT);
+        file.check("Could not open file");
+        nix::hdf5::H5Group root = nix::hdf5::H5Group(H5Gopen(file.h5id(), "/", H5P_DEFAULT));
+        nix::hdf5::H5Group group = root.openGroup("data", false).openGroup("block", false)
+                                       .openGroup("data_arrays", false).openGroup("other", false);
+        group.setAttr("entity_id", foreign_id);
+        CPPUNIT_ASSERT(nix::hdf5::CatalogHDF5::isValid(root));
+    }
+    f = nix::File::open("test_file_catalog.h5", nix::FileMode::ReadOnly);
+    b = f.getBlock("block");
+    CPPUNIT_ASSERT(b.hasDataArray(foreign_id));
+    CPPUNIT_ASSERT_EQUAL(foreign_id, b.getDataArray(foreign_id).id());
+    CPPUNIT_ASSERT(!b.hasDataArray(other_id));
+    f.close();
+}
+
+
+void TestFileHDF5::testCatalogListing() {
+    nix::FileOptions opts;
+    opts.catalog = true;
+
+    nix::File f = nix::File::open("test_file_catalog_listing.h5", nix::FileMode::Overwrite, opts);
+    std::vector<std::string> block_ids;
+    for (int i = 0; i < 3; i++) {
+        nix::Block b = f.createBlock("block_" + nix::util::numToStr(i), "nix.test");
+        block_ids.push_back(b.id());
+        for (int k = 0; k <= i; k++) {
+            b.createDataArray("array_" + nix::util::numToStr(k), "nix.test", nix::DataType::Double, {4});
+            b.createTag("tag_" + nix::util::numToStr(k), "nix.test", {1.0});
+        }
+    }
+    f.createSection("section_b", "nix.test");
+    f.createSection("section_a", "nix.test");
+    f.deleteBlock(block_ids[1]);
+    f.close();
+
+    opts.catalog = false;
+    opts.statistics = true;
+    f = nix::File::open("test_file_catalog_listing.h5", nix::FileMode::ReadOnly, opts);
+    f.resetStatistics();
+
+    // the catalog lists entities in the order of the groups, without opening them
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), f.blockCount());
+    std::vector<nix::Block> blocks = f.blocks();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), blocks.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("block_0"), blocks[0].name());
+    CPPUNIT_ASSERT_EQUAL(block_ids[0], blocks[0].id());
+    CPPUNIT_ASSERT_EQUAL(std::string("block_2"), blocks[1].name());
+    CPPUNIT_ASSERT_EQUAL(block_ids[2], blocks[1].id());
+    CPPUNIT_ASSERT_EQUAL(std::string("nix.test"), blocks[1].type());
+
+    std::vector<nix::DataArray> arrays = blocks[1].dataArrays();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), arrays.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("array_2"), arrays[2].name());
+    std::vector<nix::Tag> tags = blocks[0].tags();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), tags.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("tag_0"), tags[0].name());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(3), blocks[1].tagCount());
+
+    std::vector<nix::Section> sections = f.sections();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), sections.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("section_b"), sections[0].name());
+    CPPUNIT_ASSERT_EQUAL(std::string("section_a"), sections[1].name());
+
+    nix::IOStatistics stats = f.statistics();
+    CPPUNIT_ASSERT(stats.total.calls > 0);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), stats.total.object_opens);
+
+    // the groups are opened on first use
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({4}), arrays[2].dataExtent());
+    CPPUNIT_ASSERT(blocks[1].getDataArray("array_1"));
+    CPPUNIT_ASSERT_EQUAL(std::vector<double>({1.0}), tags[0].position());
+    CPPUNIT_ASSERT(arrays[2].isValidEntity());
+    stats = f.statistics();
+    CPPUNIT_ASSERT(stats.total.object_opens > 0);
+    f.close();
+}
+
+
+void TestFileHDF5::testStatistics() {
+    nix::FileOptions opts;
+    opts.statistics = true;
+    opts.catalog = true;
+
+    nix::File f = nix::File::open("test_file_statistics.h5", nix::FileMode::Overwrite, opts);
+    nix::Block b = f.createBlock("block", "nix.test");
+    nix::DataArray da = b.createDataArray("array", "nix.test", nix::DataType::Double, {100});
+    std::vector<double> values(100, 1.0);
+    f.resetStatistics();
+
+    da.setData(nix::DataType::Double, values.data(), {100}, {0});
+    std::vector<int32_t> converted(100);
+    da.getData(nix::DataType::Int32, converted.data(), {100}, {0});
+
+    nix::IOStatistics stats = f.statistics();
+    const nix::IOCounters &write = stats.calls["DataArray::write"];
+    const nix::IOCounters &read = stats.calls["DataArray::read"];
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), write.calls);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), write.dataset_writes);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(800), write.bytes_written);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), write.conversions);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), read.dataset_reads);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(400), read.bytes_read);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), read.conversions);
+    CPPUNIT_ASSERT(read.read_time > 0.0);
+    CPPUNIT_ASSERT(stats.entities[nix::ObjectType::DataArray].object_opens >= 2);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(800), stats.total.bytes_written);
+
+    // nested calls are counted for the outermost one
+    CPPUNIT_ASSERT(b.getDataArray("array"));
+    stats = f.statistics();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), stats.calls["Block::getEntity"].calls);
+    CPPUNIT_ASSERT(stats.calls["Block::getEntity"].object_opens > 0);
+    CPPUNIT_ASSERT_EQUAL(stats.calls["Block::getEntity"].object_opens,
+                         stats.entities[nix::ObjectType::Block].object_opens);
+
+    f.resetStatistics();
+    stats = f.statistics();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), stats.total.calls);
+    CPPUNIT_ASSERT(stats.calls.empty());
+    const std::string da_id = da.id();
+    f.close();
+
+    f = nix::File::open("test_file_statistics.h5", nix::FileMode::ReadOnly, opts);
+    b = f.getBlock("block");
+    CPPUNIT_ASSERT(b.getDataArray(da_id));
+    CPPUNIT_ASSERT(!b.getDataArray(nix::util::createId()));
+    stats = f.statistics();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), stats.total.cache_hits);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), stats.total.cache_misses);
+    f.close();
+
+    // files without statistics report none
+    f = nix::File::open("test_file_statistics.h5", nix::FileMode::ReadOnly);
+    f.getBlock("block").getDataArray("array").getData(nix::DataType::Double, values.data(), {100}, {0});
+    stats = f.statistics();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), stats.total.calls);
+    CPPUNIT_ASSERT(stats.calls.empty());
+    f.close();
+}
+
+
+namespace {
+
+class RecordingSink : public nix::TraceSink {
+public:
+    void begin(const nix::TraceEvent &event) {
+        events.push_back("begin " + std::string(event.name) + " " + event.entity);
+    }
+
+    void end(const nix::TraceEvent &event) {
+        events.push_back("end " + std::string(event.name) + " " + event.entity);
+        bytes += event.bytes;
+    }
+
+    std::vector<std::string> events;
+    uint64_t bytes = 0;
+};
+
+}
+
+
+void TestFileHDF5::testTracing() {
+    nix::File f = nix::File::open("test_file_tracing.h5", nix::FileMode::Overwrite);
+    nix::Block b = f.createBlock("block", "nix.test");
+    nix::DataArray da = b.createDataArray("array", "nix.test", nix::DataType::Double, {10});
+    std::vector<double> values(10, 1.0);
+
+    auto sink = std::make_shared<RecordingSink>();
+    nix::setTraceSink(sink);
+    da.setData(nix::DataType::Double, values.data(), {10}, {0});
+    nix::setTraceSink(nullptr);
+    // not traced any more
+    da.getData(nix::DataType::Double, values.data(), {10}, {0});
+
+    // the storage operations are nested in the API call
+    const std::string path = "/data/block/data_arrays/array";
+    CPPUNIT_ASSERT(sink->events.size() >= 4);
+    CPPUNIT_ASSERT_EQUAL("begin DataArray::write " + path, sink->events.front());
+    CPPUNIT_ASSERT_EQUAL("end DataArray::write " + path, sink->events.back());
+    auto it = std::find(sink->events.begin(), sink->events.end(), "begin DataSet::write " + path + "/data");
+    CPPUNIT_ASSERT(it != sink->events.end());
+    CPPUNIT_ASSERT_EQUAL("end DataSet::write " + path + "/data", *(it + 1));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(80), sink->bytes);
+
+    nix::setTraceSink(std::make_shared<nix::ChromeTraceSink>("test_file_tracing.json"));
+    b.getDataArray(da.id()).getData(nix::DataType::Double, values.data(), {10}, {0});
+    nix::setTraceSink(nullptr);
+    f.close();
+
+    std::ifstream in("test_file_tracing.json");
+    std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    CPPUNIT_ASSERT_EQUAL(std::string("{\"traceEvents\":["), json.substr(0, 16));
+    CPPUNIT_ASSERT_EQUAL(std::string("]}\n"), json.substr(json.size() - 3));
+    CPPUNIT_ASSERT(json.find("\"name\":\"Block::getEntity\",\"cat\":\"nix\"") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"name\":\"LocID::getAttr\",\"cat\":\"hdf5\"") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"entity\":\"" + path + "/data\",\"bytes\":80") != std::string::npos);
+}
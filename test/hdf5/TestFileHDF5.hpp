@@ -24,6 +24,15 @@ class TestFileHDF5: public BaseTestFile {
     CPPUNIT_TEST(testReopen);
     CPPUNIT_TEST(testFlags);
     CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testSwmr);
+    CPPUNIT_TEST(testInMemory);
+    CPPUNIT_TEST(testRepack);
+    CPPUNIT_TEST(testFileOptions);
+    CPPUNIT_TEST(testEntityLayout);
+    CPPUNIT_TEST(testCatalog);
+    CPPUNIT_TEST(testCatalogListing);
+    CPPUNIT_TEST(testStatistics);
+    CPPUNIT_TEST(testTracing);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -32,6 +41,19 @@ public:
 
     void testVersion() override;
 
+    void testSwmr();
+
+    void testInMemory();
+
+    void testRepack();
+
+    void testFileOptions();
+    void testEntityLayout();
+    void testCatalog();
+    void testCatalogListing();
+    void testStatistics();
+    void testTracing();
+
     void setUp() override {
         startup_time = time(NULL);
         file_open = nix::File::open("test_file.h5", nix::FileMode::Overwrite);
@@ -24,6 +24,7 @@ class TestMultiTagHDF5 : public BaseTestMultiTag {
     CPPUNIT_TEST(testUnits);
     CPPUNIT_TEST(testPositions);
     CPPUNIT_TEST(testPositionExtents);
+    CPPUNIT_TEST(testPositionsAndExtents);
     CPPUNIT_TEST(testReferences);
     CPPUNIT_TEST(testFeatures);
     CPPUNIT_TEST(testDataAccess);